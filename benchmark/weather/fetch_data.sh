@@ -0,0 +1,65 @@
+#!/usr/bin/env bash
+# Download the benchmark inputs into benchmark/weather/data
+#
+# Usage:
+#   ./benchmark/weather/fetch_data.sh [YYYYMMDD]
+#
+# Fetches a few surface and pressure level fields of a global 0.25 degree GFS
+# analysis from the NOAA open data bucket with HTTP range requests (using the
+# .idx inventory), then repacks them with wgrib2, when installed, into one
+# file per packing template:
+#   global_source.grib2   as published (complex packing with spatial
+#                         differencing, template 5.3)
+#   global_simple.grib2   template 5.0
+#   global_complex.grib2  template 5.2
+#   global_jpeg.grib2     template 5.40 (JPEG2000)
+#   global_png.grib2      template 5.41 (PNG)
+
+set -euo pipefail
+
+DATA_DIR="$(cd "$(dirname "$0")" && pwd)/data"
+# The bucket keeps past runs; yesterday's 00Z run is always complete
+DATE=${1:-$(date -u -d yesterday +%Y%m%d 2>/dev/null || date -u -v-1d +%Y%m%d)}
+URL="https://noaa-gfs-bdp-pds.s3.amazonaws.com/gfs.${DATE}/00/atmos/gfs.t00z.pgrb2.0p25.f000"
+# The same (variable, level) pairs the wide GFS columns use, plus two
+# pressure levels
+FIELDS=':(TMP|RH):2 m above ground:|:(UGRD|VGRD):10 m above ground:|:PRMSL:mean sea level:|:TMP:(500|850) mb:'
+
+mkdir -p "$DATA_DIR"
+SOURCE="$DATA_DIR/global_source.grib2"
+
+echo "=== Benchmark data: GFS ${DATE} 00Z f000 ==="
+INDEX=$(curl -sf "${URL}.idx")
+
+# A message ends where the next line's offset begins
+: > "$SOURCE"
+echo "$INDEX" | awk -F: '{ print $2 }' > "$DATA_DIR/.offsets"
+LINE=0
+while IFS= read -r RECORD; do
+    LINE=$((LINE + 1))
+    if ! echo "$RECORD" | grep -Eq "$FIELDS"; then
+        continue
+    fi
+    BEGIN=$(sed -n "${LINE}p" "$DATA_DIR/.offsets")
+    NEXT=$(sed -n "$((LINE + 1))p" "$DATA_DIR/.offsets")
+    RANGE="${BEGIN}-"
+    if [ -n "$NEXT" ]; then
+        RANGE="${BEGIN}-$((NEXT - 1))"
+    fi
+    echo "  $(echo "$RECORD" | cut -d: -f4-5)"
+    curl -sf -r "$RANGE" "$URL" >> "$SOURCE"
+done <<< "$INDEX"
+rm -f "$DATA_DIR/.offsets"
+echo "Wrote $SOURCE ($(du -h "$SOURCE" | cut -f1))"
+
+if ! command -v wgrib2 > /dev/null; then
+    echo "wgrib2 not found: only the published packing is available"
+    exit 0
+fi
+
+for TYPE in simple complex2:complex jpeg png; do
+    NAME=${TYPE#*:}
+    OUT="$DATA_DIR/global_${NAME}.grib2"
+    wgrib2 "$SOURCE" -set_grib_type "${TYPE%%:*}" -grib_out "$OUT" > /dev/null
+    echo "Wrote $OUT ($(du -h "$OUT" | cut -f1))"
+done
@@ -0,0 +1,159 @@
+#!/usr/bin/env python3
+"""Local stand-in for NOMADS and api.met.no with injected latency.
+
+Serves a fixed GRIB file for every filter_gfs_0p25.pl request, a one-line
+inventory for every pub/ .idx file, and a generated locationforecast document
+(--met-hours hourly steps with every compact and complete field, or the
+--met-json file) for every MET request, each after --latency-ms. Point the extension at it
+with:
+
+    SET gfs_base_url = 'http://127.0.0.1:8089';
+    SET met_base_url = 'http://127.0.0.1:8089';
+"""
+
+import argparse
+import datetime
+import email.utils
+import http.server
+import json
+import os
+import sys
+import threading
+import time
+
+ROOT = os.path.dirname(os.path.abspath(__file__))
+REPO = os.path.dirname(os.path.dirname(ROOT))
+
+
+INSTANT_FIELDS = [
+    "air_temperature", "relative_humidity", "wind_speed",
+    "wind_from_direction", "wind_speed_of_gust", "air_pressure_at_sea_level",
+    "cloud_area_fraction", "dew_point_temperature", "fog_area_fraction",
+    "cloud_area_fraction_low", "cloud_area_fraction_medium",
+    "cloud_area_fraction_high", "ultraviolet_index_clear_sky",
+]
+NEXT_1_HOURS_FIELDS = [
+    "precipitation_amount", "precipitation_amount_min",
+    "precipitation_amount_max", "probability_of_precipitation",
+    "probability_of_thunder",
+]
+
+
+def met_document(hours):
+    """A locationforecast/2.0 document with hourly steps from midnight UTC"""
+    start = datetime.datetime.now(datetime.timezone.utc).replace(
+        hour=0, minute=0, second=0, microsecond=0)
+    timeseries = []
+    for h in range(hours):
+        time_text = (start + datetime.timedelta(hours=h)).strftime("%Y-%m-%dT%H:%M:%SZ")
+        instant = {name: round(10 + (h * 7 + i) % 13 * 0.5, 1)
+                   for i, name in enumerate(INSTANT_FIELDS)}
+        next_hour = {name: round((h + i) % 5 * 0.2, 1)
+                     for i, name in enumerate(NEXT_1_HOURS_FIELDS)}
+        timeseries.append({
+            "time": time_text,
+            "data": {
+                "instant": {"details": instant},
+                "next_1_hours": {"summary": {"symbol_code": "cloudy"},
+                                 "details": next_hour},
+            },
+        })
+    return json.dumps({
+        "type": "Feature",
+        "geometry": {"type": "Point", "coordinates": [23.76, 61.5, 110]},
+        "properties": {"meta": {"updated_at": timeseries[0]["time"] if timeseries else ""},
+                       "timeseries": timeseries},
+    }).encode()
+
+
+class MockHandler(http.server.BaseHTTPRequestHandler):
+    protocol_version = "HTTP/1.1"
+
+    def log_message(self, format, *args):
+        if self.server.verbose:
+            super().log_message(format, *args)
+
+    def respond(self, send_body):
+        time.sleep(self.server.latency)
+        with self.server.lock:
+            self.server.requests += 1
+
+        path = self.path.split("?", 1)[0]
+        if path.endswith("/filter_gfs_0p25.pl"):
+            body, content_type = self.server.grib, "application/octet-stream"
+        elif path.endswith(".idx"):
+            body, content_type = self.server.index, "text/plain"
+        elif "/weatherapi/locationforecast/2.0/" in path:
+            body, content_type = self.server.met_json, "application/json"
+        else:
+            self.send_error(404)
+            return
+
+        now = time.time()
+        self.send_response(200)
+        self.send_header("Content-Type", content_type)
+        self.send_header("Content-Length", str(len(body)))
+        self.send_header("Last-Modified", email.utils.formatdate(now, usegmt=True))
+        self.send_header("Expires", email.utils.formatdate(now + 3600, usegmt=True))
+        self.end_headers()
+        if send_body:
+            self.wfile.write(body)
+
+    def do_GET(self):
+        self.respond(True)
+
+    def do_HEAD(self):
+        self.respond(False)
+
+
+class MockServer(http.server.ThreadingHTTPServer):
+    daemon_threads = True
+
+    def handle_error(self, request, client_address):
+        # Clients drop kept-alive connections when they are done
+        if not isinstance(sys.exc_info()[1], ConnectionError):
+            super().handle_error(request, client_address)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("--host", default="127.0.0.1")
+    parser.add_argument("--port", type=int, default=8089)
+    parser.add_argument("--latency-ms", type=float, default=50.0,
+                        help="delay before every response")
+    parser.add_argument("--grib", default=os.path.join(REPO, "examples", "gfs_sample.grib2"),
+                        help="body of every filter_gfs_0p25.pl response")
+    parser.add_argument("--met-json",
+                        help="body of every locationforecast response "
+                             "instead of the generated one")
+    parser.add_argument("--met-hours", type=int, default=240,
+                        help="hourly steps of the generated forecast")
+    parser.add_argument("--verbose", action="store_true")
+    args = parser.parse_args()
+
+    server = MockServer((args.host, args.port), MockHandler)
+    server.latency = args.latency_ms / 1000.0
+    server.verbose = args.verbose
+    server.lock = threading.Lock()
+    server.requests = 0
+    with open(args.grib, "rb") as f:
+        server.grib = f.read()
+    if args.met_json:
+        with open(args.met_json, "rb") as f:
+            server.met_json = f.read()
+    else:
+        server.met_json = met_document(args.met_hours)
+    server.index = b"1:0:d=2026010100:TMP:2 m above ground:anl:\n"
+
+    print(f"mock server on http://{args.host}:{args.port}, "
+          f"{args.latency_ms:g} ms latency", flush=True)
+    try:
+        server.serve_forever()
+    except KeyboardInterrupt:
+        pass
+    finally:
+        print(f"served {server.requests} requests", flush=True)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,48 @@
+#!/usr/bin/env bash
+# Run the weather benchmark suite and write machine-readable results
+#
+# Usage:
+#   ./benchmark/weather/run.sh [PATTERN]
+#
+# PATTERN selects DuckDB benchmarks by path (default: all of them). Needs a
+# build with the DuckDB benchmark runner (make bench builds one) and the
+# files of benchmark/weather/fetch_data.sh. Results go to benchmark/results:
+#   duckdb.tsv    every run of every DuckDB benchmark (runner --out format)
+#   summary.json  median seconds per benchmark, DuckDB and criterion, with
+#                 MB/s for the decode benchmarks
+#
+# Environment:
+#   RUNNER          benchmark runner binary
+#   LATENCY_MS      delay of every mock server response (default 50)
+#   SKIP_CRITERION  set to skip the Rust decode benchmarks
+
+set -euo pipefail
+
+cd "$(dirname "$0")/../.."
+
+RUNNER=${RUNNER:-build/release/benchmark/benchmark_runner}
+PATTERN=${1:-benchmark/weather/.*}
+LATENCY_MS=${LATENCY_MS:-50}
+RESULTS=benchmark/results
+
+mkdir -p "$RESULTS"
+
+if [ ! -f benchmark/weather/data/global_source.grib2 ]; then
+    echo "Missing benchmark data, run benchmark/weather/fetch_data.sh first"
+    exit 1
+fi
+
+python3 benchmark/weather/mock_server.py --port 8089 --latency-ms "$LATENCY_MS" &
+MOCK_PID=$!
+trap 'kill $MOCK_PID 2> /dev/null || true' EXIT
+sleep 1
+
+echo "=== DuckDB benchmarks ($PATTERN) ==="
+"$RUNNER" "$PATTERN" --out="$RESULTS/duckdb.tsv"
+
+if [ -z "${SKIP_CRITERION:-}" ]; then
+    echo "=== Rust decode benchmarks ==="
+    (cd rust && cargo bench --bench decode -- --noplot)
+fi
+
+python3 benchmark/weather/summarize.py
@@ -0,0 +1,86 @@
+#!/usr/bin/env python3
+"""Merge benchmark results into one JSON document.
+
+Reads the DuckDB runner output (--out, one "name run timing" line per run)
+and the criterion estimates under target/criterion, and writes one record per
+benchmark with its median time in seconds plus MB/s where the input size is
+known (criterion throughput, or the data file of a read_grib decode
+benchmark).
+"""
+
+import argparse
+import glob
+import json
+import os
+import statistics
+
+ROOT = os.path.dirname(os.path.abspath(__file__))
+REPO = os.path.dirname(os.path.dirname(ROOT))
+
+
+def duckdb_results(path):
+    timings = {}
+    with open(path) as f:
+        for line in f:
+            fields = line.rstrip("\n").split("\t")
+            if len(fields) != 3 or fields[0] == "name":
+                continue
+            try:
+                timings.setdefault(fields[0], []).append(float(fields[2]))
+            except ValueError:
+                continue  # Timeouts and errors are reported as text
+
+    results = []
+    for name, runs in sorted(timings.items()):
+        record = {"suite": "duckdb", "name": name, "runs": len(runs),
+                  "median_seconds": statistics.median(runs)}
+        # benchmark/weather/read_grib/decode_<template>.benchmark
+        stem = os.path.splitext(os.path.basename(name))[0]
+        if stem.startswith("decode_"):
+            data = os.path.join(ROOT, "data", "global_%s.grib2" % stem[len("decode_"):])
+            if os.path.exists(data):
+                record["bytes"] = os.path.getsize(data)
+                record["mb_per_second"] = record["bytes"] / 1e6 / record["median_seconds"]
+        results.append(record)
+    return results
+
+
+def criterion_results(directory):
+    results = []
+    pattern = os.path.join(directory, "**", "new", "benchmark.json")
+    for path in sorted(glob.glob(pattern, recursive=True)):
+        with open(path) as f:
+            benchmark = json.load(f)
+        with open(os.path.join(os.path.dirname(path), "estimates.json")) as f:
+            estimates = json.load(f)
+        seconds = estimates["median"]["point_estimate"] / 1e9
+        record = {"suite": "criterion", "name": benchmark["full_id"],
+                  "median_seconds": seconds}
+        throughput = benchmark.get("throughput") or {}
+        if "Bytes" in throughput:
+            record["bytes"] = throughput["Bytes"]
+            record["mb_per_second"] = throughput["Bytes"] / 1e6 / seconds
+        results.append(record)
+    return results
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("--duckdb", default=os.path.join(REPO, "benchmark", "results", "duckdb.tsv"))
+    parser.add_argument("--criterion", default=os.path.join(REPO, "target", "criterion"))
+    parser.add_argument("--output", default=os.path.join(REPO, "benchmark", "results", "summary.json"))
+    args = parser.parse_args()
+
+    results = []
+    if os.path.exists(args.duckdb):
+        results += duckdb_results(args.duckdb)
+    if os.path.isdir(args.criterion):
+        results += criterion_results(args.criterion)
+    with open(args.output, "w") as f:
+        json.dump({"results": results}, f, indent=2)
+        f.write("\n")
+    print("wrote %d results to %s" % (len(results), args.output))
+
+
+if __name__ == "__main__":
+    main()
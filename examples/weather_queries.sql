@@ -2,7 +2,7 @@
 --
 -- Prerequisites:
 --   1. Load the extension
---   2. Have weather data in Parquet format (see grib_to_parquet.py)
+--   2. Have weather data in Parquet format (see grib_to_parquet())
 --   3. Optionally install h3 extension for spatial queries
 
 -- Load the weather extension
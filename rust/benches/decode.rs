@@ -0,0 +1,128 @@
+//! Decode throughput of the FFI reader, in bytes of GRIB input per second.
+//!
+//! Inputs are examples/gfs_sample.grib2 and every .grib2 file in
+//! benchmark/weather/data (see benchmark/weather/fetch_data.sh, which writes
+//! one global file per packing template). Each file is decoded the way the
+//! read_grib scan does it: columnar batches of STANDARD_VECTOR_SIZE points,
+//! with and without coordinates, and with a bounding box.
+
+use criterion::{criterion_group, criterion_main, BenchmarkId, Criterion, Throughput};
+use grib2_ffi::*;
+use std::path::{Path, PathBuf};
+use std::ptr;
+
+/// Points per batch, as in a DuckDB vector
+const BATCH_POINTS: usize = 2048;
+const MAX_RUNS: usize = 64;
+
+fn bench_files() -> Vec<PathBuf> {
+    let repo = Path::new(env!("CARGO_MANIFEST_DIR")).join("..");
+    let mut files = vec![repo.join("examples/gfs_sample.grib2")];
+    if let Ok(entries) = std::fs::read_dir(repo.join("benchmark/weather/data")) {
+        let mut data: Vec<PathBuf> = entries
+            .filter_map(|entry| entry.ok().map(|entry| entry.path()))
+            .filter(|path| path.extension().map_or(false, |ext| ext == "grib2"))
+            .collect();
+        data.sort();
+        files.extend(data);
+    }
+    files
+}
+
+/// Output columns of one batch, reused across iterations
+struct Columns {
+    latitude: Vec<f64>,
+    longitude: Vec<f64>,
+    value: Vec<f64>,
+    grid_index: Vec<u32>,
+    runs: Vec<Grib2MessageRun>,
+}
+
+impl Columns {
+    fn new() -> Self {
+        Columns {
+            latitude: vec![0.0; BATCH_POINTS],
+            longitude: vec![0.0; BATCH_POINTS],
+            value: vec![0.0; BATCH_POINTS],
+            grid_index: vec![0; BATCH_POINTS],
+            runs: Vec::with_capacity(MAX_RUNS),
+        }
+    }
+}
+
+#[derive(Clone, Copy)]
+enum Mode {
+    Values,
+    Coordinates,
+    BoundingBox,
+}
+
+impl Mode {
+    fn name(self) -> &'static str {
+        match self {
+            Mode::Values => "values",
+            Mode::Coordinates => "values_and_coordinates",
+            Mode::BoundingBox => "finland_bbox",
+        }
+    }
+}
+
+/// Decode every point of a GRIB file held in memory; returns the point count
+fn decode(bytes: &[u8], mode: Mode, columns: &mut Columns) -> usize {
+    let mut error = ptr::null_mut();
+    let reader = grib2_open_from_bytes(bytes.as_ptr(), bytes.len(), &mut error);
+    assert!(!reader.is_null(), "GRIB input could not be opened");
+
+    let coordinates = !matches!(mode, Mode::Values);
+    grib2_set_decode_coordinates(reader, coordinates);
+    if let Mode::BoundingBox = mode {
+        grib2_set_bbox(reader, 59.0, 71.0, 19.0, 32.0);
+    }
+    let buffers = Grib2ColumnBuffers {
+        latitude: if coordinates { columns.latitude.as_mut_ptr() } else { ptr::null_mut() },
+        longitude: if coordinates { columns.longitude.as_mut_ptr() } else { ptr::null_mut() },
+        value: columns.value.as_mut_ptr(),
+        grid_index: columns.grid_index.as_mut_ptr(),
+        runs: columns.runs.as_mut_ptr(),
+        max_runs: MAX_RUNS,
+        latitude_float: ptr::null_mut(),
+        longitude_float: ptr::null_mut(),
+        value_float: ptr::null_mut(),
+    };
+
+    let mut points = 0;
+    loop {
+        let batch = grib2_read_batch_columnar(reader, BATCH_POINTS, &buffers);
+        if !batch.error.is_null() {
+            grib2_free_error(batch.error);
+            grib2_close(reader);
+            panic!("GRIB input could not be decoded");
+        }
+        points += batch.count;
+        if !batch.has_more {
+            break;
+        }
+    }
+    grib2_close(reader);
+    points
+}
+
+fn decode_benchmarks(c: &mut Criterion) {
+    let mut group = c.benchmark_group("decode");
+    group.sample_size(10);
+    let mut columns = Columns::new();
+    for path in bench_files() {
+        let bytes = std::fs::read(&path).expect("benchmark input is readable");
+        let name = path.file_stem().unwrap().to_string_lossy().into_owned();
+        group.throughput(Throughput::Bytes(bytes.len() as u64));
+        for mode in [Mode::Values, Mode::Coordinates, Mode::BoundingBox] {
+            group.bench_with_input(BenchmarkId::new(mode.name(), &name), &bytes, |b, bytes| {
+                b.iter(|| decode(bytes, mode, &mut columns))
+            });
+        }
+    }
+    group.finish();
+}
+
+criterion_group!(benches, decode_benchmarks);
+criterion_main!(benches);
@@ -4,10 +4,12 @@
 //! Supports both file paths and in-memory byte arrays.
 
 use grib::Grib2SubmessageDecoder;
-use std::ffi::{c_char, c_double, c_uint, CStr, CString};
+use std::ffi::{c_char, c_double, c_float, c_uint, CStr, CString};
 use std::fs::File;
-use std::io::{BufReader, Cursor, Read, Seek};
+use memmap2::Mmap;
+use std::io::{Cursor, Read, Seek};
 use std::ptr;
+use std::sync::{Arc, Mutex, OnceLock};
 
 /// A single data point from a GRIB2 file
 #[repr(C)]
@@ -33,14 +35,125 @@ pub struct Grib2Batch {
     pub error: *mut c_char,
 }
 
-/// Opaque reader handle for streaming
+/// Per-message metadata for a run of consecutive points in a columnar batch
+#[repr(C)]
+pub struct Grib2MessageRun {
+    pub offset: usize,
+    pub count: usize,
+    pub forecast_time: i64,
+    pub surface_value: c_double,
+    pub message_index: c_uint,
+    pub discipline: u8,
+    pub parameter_category: u8,
+    pub parameter_number: u8,
+    pub surface_type: u8,
+}
+
+/// Caller-provided output buffers for columnar reads.
+/// Coordinate/value/grid index pointers may be null to skip that column.
+/// The *_float buffers receive the same column as FLOAT instead.
+#[repr(C)]
+pub struct Grib2ColumnBuffers {
+    pub latitude: *mut c_double,
+    pub longitude: *mut c_double,
+    pub value: *mut c_double,
+    pub grid_index: *mut c_uint,
+    pub runs: *mut Grib2MessageRun,
+    pub max_runs: usize,
+    pub latitude_float: *mut c_float,
+    pub longitude_float: *mut c_float,
+    pub value_float: *mut c_float,
+}
+
+/// Result of a columnar read: points were written to the caller's buffers
+#[repr(C)]
+pub struct Grib2ColumnarBatch {
+    pub count: usize,
+    pub run_count: usize,
+    pub has_more: bool,
+    pub error: *mut c_char,
+}
+
+/// Header metadata of one selected message, available before decoding
+#[repr(C)]
+pub struct Grib2MessageInfo {
+    pub forecast_time: i64,
+    pub surface_value: c_double,
+    pub num_points: usize,
+    pub message_index: c_uint,
+    pub discipline: u8,
+    pub parameter_category: u8,
+    pub parameter_number: u8,
+    pub surface_type: u8,
+}
+
+/// Regular latitude/longitude grid definition of one message. Point n of
+/// the grid lies at latitude lat1 + (n / ni) * dj, longitude
+/// lon1 + (n % ni) * di. `regular` is false for other grid templates.
+#[repr(C)]
+pub struct Grib2GridInfo {
+    pub ni: c_uint,
+    pub nj: c_uint,
+    pub lat1: c_double,
+    pub lon1: c_double,
+    pub di: c_double,
+    pub dj: c_double,
+    pub template_number: u16,
+    pub regular: bool,
+}
+
+/// Shared point arrays of one message's grid. The arrays stay owned by the
+/// reader until it is closed; coordinates are null when coordinate decoding
+/// is disabled.
+#[repr(C)]
+pub struct Grib2GridPoints {
+    pub latitude: *const c_double,
+    pub longitude: *const c_double,
+    pub grid_index: *const c_uint,
+    pub count: usize,
+}
+
+/// Byte range of one GRIB message in a local file and the reference time
+/// from its section 1
+#[repr(C)]
+pub struct Grib2MessageLocation {
+    pub offset: u64,
+    pub length: u64,
+    pub year: u16,
+    pub month: u8,
+    pub day: u8,
+    pub hour: u8,
+    pub minute: u8,
+    pub second: u8,
+}
+
+/// Any seekable byte source the GRIB parser can read from
+trait ReadSeek: Read + Seek {}
+impl<T: Read + Seek> ReadSeek for T {}
+
+type Source = Box<dyn ReadSeek>;
+
+/// Opaque reader handle for streaming.
+///
+/// Only section headers are parsed at open time; each message's data
+/// section is unpacked lazily when the batch cursor reaches it, so at most
+/// one decoded message is held in memory at a time.
 pub struct Grib2Reader {
-    messages: Vec<ParsedMessage>,
+    grib2: grib::Grib2<grib::SeekableGrib2Reader<Source>>,
+    headers: Vec<MessageHeader>,
     current_message: usize,
     current_point: usize,
+    decoded: Option<DecodedMessage>,
+    decode_coordinates: bool,
+    bbox: Option<BoundingBox>,
+    // Points handed out through grib2_grid_points(), kept alive even if the
+    // cache evicts them
+    pinned_points: Vec<Arc<GridPoints>>,
 }
 
-struct ParsedMessage {
+/// Section 0/4 metadata of a selected submessage, available without decoding
+struct MessageHeader {
+    ordinal: usize, // Position in grib2.iter()
     discipline: u8,
     parameter_category: u8,
     parameter_number: u8,
@@ -48,16 +161,418 @@ struct ParsedMessage {
     surface_type: u8,
     surface_value: f64,
     message_index: u32,
-    points: Vec<(f64, f64, f64)>, // (lat, lon, value)
+    num_points: usize,
+    grid_template: u16,
+    grid: Option<RegularGrid>,
+}
+
+/// Unpacked grid of the message under the cursor. Struct-of-arrays so
+/// columnar reads are plain slice copies; values[k] belongs to points k.
+/// Values keep the decoder's f32, which holds every packed GRIB value
+/// exactly, and are only widened when copied into DOUBLE buffers.
+struct DecodedMessage {
+    points: Arc<GridPoints>,
+    values: Vec<f32>,
+}
+
+impl DecodedMessage {
+    fn len(&self) -> usize {
+        self.values.len()
+    }
+
+    /// Copy points [start, start + n) into the caller's buffers at `offset`
+    ///
+    /// Safety: every non-null buffer must hold offset + n elements.
+    unsafe fn write_points(&self, start: usize, n: usize, buffers: &Grib2ColumnBuffers, offset: usize) {
+        let points = &self.points;
+        if !points.latitudes.is_empty() {
+            write_column(&points.latitudes[start..start + n], buffers.latitude, offset);
+            write_column(&points.latitudes[start..start + n], buffers.latitude_float, offset);
+        }
+        if !points.longitudes.is_empty() {
+            write_column(&points.longitudes[start..start + n], buffers.longitude, offset);
+            write_column(&points.longitudes[start..start + n], buffers.longitude_float, offset);
+        }
+        write_column(&self.values[start..start + n], buffers.value, offset);
+        write_column(&self.values[start..start + n], buffers.value_float, offset);
+        write_column(&points.grid_indices[start..start + n], buffers.grid_index, offset);
+    }
+}
+
+/// Element conversion for columnar copies: f32 <-> f64 and identity
+trait ColumnValue<T>: Copy {
+    fn convert(self) -> T;
+}
+
+impl<T: Copy> ColumnValue<T> for T {
+    fn convert(self) -> T {
+        self
+    }
+}
+
+impl ColumnValue<f64> for f32 {
+    fn convert(self) -> f64 {
+        self as f64
+    }
+}
+
+impl ColumnValue<f32> for f64 {
+    fn convert(self) -> f32 {
+        self as f32
+    }
+}
+
+/// Copy `src` into `dst[offset..]`, converting each element; null skips
+unsafe fn write_column<S: ColumnValue<D>, D>(src: &[S], dst: *mut D, offset: usize) {
+    if dst.is_null() {
+        return;
+    }
+    let dst = std::slice::from_raw_parts_mut(dst.add(offset), src.len());
+    for (out, &value) in dst.iter_mut().zip(src) {
+        *out = value.convert();
+    }
+}
+
+/// Coordinates and grid positions of the points a grid produces under one
+/// bounding box. Coordinates are empty when coordinate decoding is disabled.
+struct GridPoints {
+    latitudes: Vec<f64>,
+    longitudes: Vec<f64>,
+    // Position of each point in the message's full grid
+    grid_indices: Vec<u32>,
+}
+
+/// Everything the points of a grid depend on: the raw section 3 payload,
+/// the bounding box and whether coordinates are materialized
+struct GridPointsKey {
+    grid_def: Box<[u8]>,
+    bbox: Option<[u64; 4]>,
+    coordinates: bool,
+}
+
+impl GridPointsKey {
+    fn matches(&self, grid_def: &[u8], bbox: &Option<[u64; 4]>, coordinates: bool) -> bool {
+        self.coordinates == coordinates && self.bbox == *bbox && &self.grid_def[..] == grid_def
+    }
+}
+
+/// A cache entry, filled by the first reader that needs it. `None` when the
+/// grid produces no points.
+type GridPointsSlot = Arc<OnceLock<Option<Arc<GridPoints>>>>;
+
+/// Grids kept by the process-wide cache. A global 0.25 degree grid with
+/// coordinates is about 20 MB; the oldest entry is dropped first.
+const GRID_POINTS_CACHE_ENTRIES: usize = 8;
+
+/// Every message of a GFS file shares one grid, so its points are built
+/// once and shared across messages, files and queries
+static GRID_POINTS_CACHE: Mutex<Vec<(GridPointsKey, GridPointsSlot)>> = Mutex::new(Vec::new());
+
+impl GridPoints {
+    /// Points of a grid inside an optional bounding box. Regular grids get
+    /// their coordinates from the grid header, so rows and columns outside
+    /// the box are skipped by index; other grids generate every coordinate
+    /// through `latlons` and filter.
+    fn build<F>(
+        grid: Option<RegularGrid>,
+        num_points: usize,
+        latlons: F,
+        bbox: Option<BoundingBox>,
+        coordinates: bool,
+    ) -> Option<GridPoints>
+    where
+        F: FnOnce() -> Option<Vec<(f64, f64)>>,
+    {
+        let mut points = GridPoints {
+            latitudes: Vec::new(),
+            longitudes: Vec::new(),
+            grid_indices: Vec::new(),
+        };
+
+        if let Some(grid) = grid {
+            let rows: Vec<(usize, f64)> = (0..grid.nj)
+                .map(|j| (j, grid.latitude(j)))
+                .filter(|&(_, lat)| bbox.map_or(true, |b| b.contains_latitude(lat)))
+                .collect();
+            let columns: Vec<(usize, f64)> = (0..grid.ni)
+                .map(|i| (i, grid.longitude(i)))
+                .filter(|&(_, lon)| bbox.map_or(true, |b| b.contains_longitude(lon)))
+                .collect();
+
+            let capacity = rows.len() * columns.len();
+            points.grid_indices.reserve(capacity);
+            if coordinates {
+                points.latitudes.reserve(capacity);
+                points.longitudes.reserve(capacity);
+            }
+            for &(j, lat) in &rows {
+                for &(i, lon) in &columns {
+                    points.grid_indices.push((j * grid.ni + i) as u32);
+                    if coordinates {
+                        points.latitudes.push(lat);
+                        points.longitudes.push(lon);
+                    }
+                }
+            }
+            return Some(points);
+        }
+
+        // Coordinates are still needed for the bounding box test even when
+        // they are not projected
+        if !coordinates && bbox.is_none() {
+            points.grid_indices = (0..num_points as u32).collect();
+            return Some(points);
+        }
+
+        for (index, (lat, lon)) in latlons()?.into_iter().enumerate() {
+            if let Some(b) = &bbox {
+                if !b.contains_latitude(lat) || !b.contains_longitude(lon) {
+                    continue;
+                }
+            }
+            points.grid_indices.push(index as u32);
+            if coordinates {
+                points.latitudes.push(lat);
+                points.longitudes.push(lon);
+            }
+        }
+        Some(points)
+    }
+
+    fn len(&self) -> usize {
+        self.grid_indices.len()
+    }
+}
+
+/// Inclusive latitude/longitude window in output coordinates
+/// (longitudes normalized to -180..180)
+#[derive(Clone, Copy)]
+struct BoundingBox {
+    lat_min: f64,
+    lat_max: f64,
+    lon_min: f64,
+    lon_max: f64,
+}
+
+impl BoundingBox {
+    fn contains_latitude(&self, lat: f64) -> bool {
+        lat >= self.lat_min && lat <= self.lat_max
+    }
+
+    fn contains_longitude(&self, lon: f64) -> bool {
+        lon >= self.lon_min && lon <= self.lon_max
+    }
+}
+
+fn normalize_longitude(lon: f64) -> f64 {
+    if lon > 180.0 {
+        lon - 360.0
+    } else {
+        lon
+    }
+}
+
+/// Regular latitude/longitude grid (template 3.0) read from section 3.
+/// Point (i, j) is stored at index j * ni + i.
+#[derive(Clone, Copy)]
+struct RegularGrid {
+    ni: usize,
+    nj: usize,
+    lat1: f64,
+    lon1: f64,
+    di: f64, // Signed by scanning direction
+    dj: f64,
+}
+
+impl RegularGrid {
+    /// Parse the section 3 payload (octet 6 onwards). Returns None for other
+    /// templates and for scanning modes we do not index directly.
+    fn parse(payload: &[u8]) -> Option<Self> {
+        let u32_at = |pos: usize| -> Option<u32> {
+            Some(u32::from_be_bytes(payload.get(pos..pos + 4)?.try_into().ok()?))
+        };
+        // Sign-magnitude integers, as used for coordinates in GRIB2
+        let i32_at = |pos: usize| -> Option<i64> {
+            let raw = u32_at(pos)?;
+            let magnitude = (raw & 0x7fff_ffff) as i64;
+            Some(if raw & 0x8000_0000 != 0 { -magnitude } else { magnitude })
+        };
+
+        let template = u16::from_be_bytes(payload.get(7..9)?.try_into().ok()?);
+        if template != 0 {
+            return None;
+        }
+        let basic_angle = u32_at(33)?;
+        if basic_angle != 0 && basic_angle != u32::MAX {
+            return None;
+        }
+        // Bit 3: points consecutive along j, bit 4: boustrophedon rows
+        let scanning_mode = *payload.get(66)?;
+        if scanning_mode & 0x30 != 0 {
+            return None;
+        }
+
+        const MICRO: f64 = 1e-6;
+        let di = u32_at(58)? as f64 * MICRO;
+        let dj = u32_at(62)? as f64 * MICRO;
+        Some(RegularGrid {
+            ni: u32_at(25)? as usize,
+            nj: u32_at(29)? as usize,
+            lat1: i32_at(41)? as f64 * MICRO,
+            lon1: i32_at(45)? as f64 * MICRO,
+            di: if scanning_mode & 0x80 != 0 { -di } else { di },
+            dj: if scanning_mode & 0x40 != 0 { dj } else { -dj },
+        })
+    }
+
+    fn latitude(&self, j: usize) -> f64 {
+        self.lat1 + j as f64 * self.dj
+    }
+
+    fn longitude(&self, i: usize) -> f64 {
+        normalize_longitude(self.lon1 + i as f64 * self.di)
+    }
+
+    /// Whether the columns cover the full circle, so column ni is column 0
+    fn wraps(&self) -> bool {
+        ((self.ni as f64) * self.di.abs() - 360.0).abs() < 1e-6
+    }
+
+    /// Fractional (i, j) position of a coordinate in the grid
+    fn position(&self, lat: f64, lon: f64) -> (f64, f64) {
+        let mut dlon = (lon - self.lon1).rem_euclid(360.0);
+        if self.di < 0.0 && dlon > 0.0 {
+            dlon -= 360.0;
+        }
+        (dlon / self.di, (lat - self.lat1) / self.dj)
+    }
+
+    fn point(&self, values: &[f32], i: i64, j: i64) -> f64 {
+        let i = if self.wraps() { i.rem_euclid(self.ni as i64) } else { i };
+        if i < 0 || j < 0 || i as usize >= self.ni || j as usize >= self.nj {
+            return f64::NAN;
+        }
+        values
+            .get(j as usize * self.ni + i as usize)
+            .map_or(f64::NAN, |&v| v as f64)
+    }
+
+    /// Value at a coordinate: the nearest grid point, or bilinear between
+    /// the four surrounding ones. NaN outside the grid or next to missing
+    /// values.
+    fn sample(&self, values: &[f32], lat: f64, lon: f64, bilinear: bool) -> f64 {
+        let (fi, fj) = self.position(lat, lon);
+        if !fi.is_finite() || !fj.is_finite() {
+            return f64::NAN;
+        }
+        if !bilinear {
+            return self.point(values, fi.round() as i64, fj.round() as i64);
+        }
+
+        // Snap positions on a grid line, so points on the edge of the grid
+        // do not need a neighbor outside of it
+        const EPSILON: f64 = 1e-9;
+        let split = |f: f64| -> (i64, f64) {
+            let base = f.floor();
+            let weight = f - base;
+            if weight < EPSILON {
+                (base as i64, 0.0)
+            } else if weight > 1.0 - EPSILON {
+                (base as i64 + 1, 0.0)
+            } else {
+                (base as i64, weight)
+            }
+        };
+        let (i0, wx) = split(fi);
+        let (j0, wy) = split(fj);
+
+        let mut result = 0.0;
+        for (dj, wj) in [(0, 1.0 - wy), (1, wy)] {
+            if wj == 0.0 {
+                continue;
+            }
+            for (di, wi) in [(0, 1.0 - wx), (1, wx)] {
+                if wi == 0.0 {
+                    continue;
+                }
+                result += wi * wj * self.point(values, i0 + di, j0 + dj);
+            }
+        }
+        result
+    }
+}
+
+/// Memory-map a local file for reading
+fn map_file(path: &str) -> Result<Mmap, String> {
+    let file = File::open(path).map_err(|e| format!("Failed to open file: {}", e))?;
+    // Safety: GRIB files are not modified while they are being read; a
+    // concurrent writer could at worst produce garbage values
+    unsafe { Mmap::map(&file) }.map_err(|e| format!("Failed to map file: {}", e))
+}
+
+/// Locate every GRIB2 message from its section 0 length, jumping from one
+/// message to the next without parsing anything else. Bytes between
+/// messages (padding, other headers) are skipped up to the next "GRIB".
+fn scan_message_locations(data: &[u8]) -> Result<Vec<Grib2MessageLocation>, String> {
+    let mut locations = Vec::new();
+    let mut pos = 0;
+    while pos + 16 <= data.len() {
+        if &data[pos..pos + 4] != b"GRIB" {
+            match data[pos + 1..].windows(4).position(|w| w == b"GRIB") {
+                Some(skip) => pos += skip + 1,
+                None => break,
+            }
+            continue;
+        }
+        if data[pos + 7] != 2 {
+            return Err(format!("Unsupported GRIB edition {} at byte {}", data[pos + 7], pos));
+        }
+        let length = u64::from_be_bytes(data[pos + 8..pos + 16].try_into().unwrap());
+        let end = pos as u64 + length;
+        if length < 16 || end > data.len() as u64 {
+            return Err(format!("Truncated GRIB message at byte {}", pos));
+        }
+
+        // Section 1 follows section 0: reference time at octets 13-19
+        let identification = &data[pos + 16..end as usize];
+        let mut location = Grib2MessageLocation {
+            offset: pos as u64,
+            length,
+            year: 0,
+            month: 0,
+            day: 0,
+            hour: 0,
+            minute: 0,
+            second: 0,
+        };
+        if identification.len() >= 19 && identification[4] == 1 {
+            location.year = u16::from_be_bytes([identification[12], identification[13]]);
+            location.month = identification[14];
+            location.day = identification[15];
+            location.hour = identification[16];
+            location.minute = identification[17];
+            location.second = identification[18];
+        }
+        locations.push(location);
+        pos = end as usize;
+    }
+    Ok(locations)
 }
 
 impl Grib2Reader {
-    fn from_reader<R: Read + Seek>(reader: R) -> Result<Self, String> {
-        let grib2 = grib::from_reader(reader).map_err(|e| format!("Failed to parse GRIB: {}", e))?;
+    /// Parse headers of submessages whose ordinal falls in `range` (all if None)
+    fn from_source(source: Source, range: Option<(usize, usize)>) -> Result<Self, String> {
+        let grib2 = grib::from_reader(source).map_err(|e| format!("Failed to parse GRIB: {}", e))?;
 
-        let mut messages = Vec::new();
+        let mut headers = Vec::new();
+
+        for (ordinal, (msg_idx, submessage)) in grib2.iter().enumerate() {
+            if let Some((begin, end)) = range {
+                if ordinal < begin || ordinal >= end {
+                    continue;
+                }
+            }
 
-        for (msg_idx, submessage) in grib2.iter() {
             let discipline = submessage.indicator().discipline;
             let prod_def = submessage.prod_def();
 
@@ -74,32 +589,15 @@ impl Grib2Reader {
                 .map(|(first, _)| (first.surface_type, first.value() as f64))
                 .unwrap_or((0, 0.0));
 
-            let latlons = match submessage.latlons() {
-                Ok(ll) => ll,
-                Err(_) => continue,
-            };
-
-            let decoder = match Grib2SubmessageDecoder::from(submessage) {
-                Ok(d) => d,
-                Err(_) => continue,
-            };
-
-            let values = match decoder.dispatch() {
-                Ok(v) => v,
-                Err(_) => continue,
-            };
-
             let flat_index = (msg_idx.0 * 1000 + msg_idx.1) as u32;
+            let grid_def = submessage.grid_def();
+            let grid_template = grid_def
+                .payload
+                .get(7..9)
+                .map_or(u16::MAX, |b| u16::from_be_bytes([b[0], b[1]]));
 
-            let points: Vec<(f64, f64, f64)> = latlons
-                .zip(values)
-                .map(|((lat, lon), value)| {
-                    let lon_normalized = if lon > 180.0 { lon - 360.0 } else { lon };
-                    (lat as f64, lon_normalized as f64, value as f64)
-                })
-                .collect();
-
-            messages.push(ParsedMessage {
+            headers.push(MessageHeader {
+                ordinal,
                 discipline,
                 parameter_category: param_cat,
                 parameter_number: param_num,
@@ -107,65 +605,264 @@ impl Grib2Reader {
                 surface_type,
                 surface_value,
                 message_index: flat_index,
-                points,
+                num_points: grid_def.num_points() as usize,
+                grid_template,
+                grid: RegularGrid::parse(&grid_def.payload),
             });
         }
 
         Ok(Grib2Reader {
-            messages,
+            grib2,
+            headers,
             current_message: 0,
             current_point: 0,
+            decoded: None,
+            decode_coordinates: true,
+            bbox: None,
+            pinned_points: Vec::new(),
         })
     }
 
     /// Open from file path
     fn new(path: &str) -> Result<Self, String> {
-        let file = File::open(path).map_err(|e| format!("Failed to open file: {}", e))?;
-        let reader = BufReader::new(file);
-        Self::from_reader(reader)
+        Self::new_range(path, None)
     }
 
-    /// Open from in-memory bytes (copies data to owned Vec for Seek support)
-    fn from_bytes(data: &[u8]) -> Result<Self, String> {
-        let owned_data = data.to_vec();
-        let cursor = Cursor::new(owned_data);
-        Self::from_reader(cursor)
+    /// Open from file path, decoding only submessages in `range`. The file
+    /// is memory-mapped, so headers of skipped messages are read in place
+    /// and their data sections are never touched.
+    fn new_range(path: &str, range: Option<(usize, usize)>) -> Result<Self, String> {
+        Self::from_source(Box::new(Cursor::new(map_file(path)?)), range)
     }
 
-    fn read_batch(&mut self, max_count: usize) -> Grib2Batch {
-        let mut points = Vec::with_capacity(max_count);
+    /// Open from in-memory bytes without copying them.
+    ///
+    /// Safety: the caller must keep `data` alive and unmodified until the
+    /// reader is closed (the C++ side owns the HTTP response buffer).
+    unsafe fn from_borrowed_bytes(data: *const u8, len: usize) -> Result<Self, String> {
+        let bytes: &'static [u8] = std::slice::from_raw_parts(data, len);
+        Self::from_source(Box::new(Cursor::new(bytes)), None)
+    }
+
+    /// Count submessages in a file without decoding any data sections
+    fn count_messages(path: &str) -> Result<usize, String> {
+        let grib2 =
+            grib::from_reader(Cursor::new(map_file(path)?)).map_err(|e| format!("Failed to parse GRIB: {}", e))?;
+        Ok(grib2.iter().count())
+    }
+
+    /// Points of a grid under the reader's bounding box, from the shared
+    /// cache or built and added to it
+    fn grid_points<F>(&self, grid_def: &[u8], num_points: usize, latlons: F) -> Option<Arc<GridPoints>>
+    where
+        F: FnOnce() -> Option<Vec<(f64, f64)>>,
+    {
+        let bbox = self
+            .bbox
+            .map(|b| [b.lat_min.to_bits(), b.lat_max.to_bits(), b.lon_min.to_bits(), b.lon_max.to_bits()]);
+        let coordinates = self.decode_coordinates;
+
+        let slot = {
+            let mut cache = GRID_POINTS_CACHE.lock().unwrap_or_else(|e| e.into_inner());
+            match cache.iter().find(|(k, _)| k.matches(grid_def, &bbox, coordinates)) {
+                Some((_, slot)) => slot.clone(),
+                None => {
+                    let slot = GridPointsSlot::default();
+                    if cache.len() >= GRID_POINTS_CACHE_ENTRIES {
+                        cache.remove(0);
+                    }
+                    let key = GridPointsKey {
+                        grid_def: grid_def.into(),
+                        bbox,
+                        coordinates,
+                    };
+                    cache.push((key, slot.clone()));
+                    slot
+                }
+            }
+        };
+
+        // Built outside the cache lock; readers of the same grid wait for
+        // the first one instead of repeating the work
+        slot.get_or_init(|| {
+            let grid = RegularGrid::parse(grid_def);
+            GridPoints::build(grid, num_points, latlons, self.bbox, self.decode_coordinates).map(Arc::new)
+        })
+        .clone()
+    }
+
+    /// Unpack one submessage (section 7). Coordinates and grid indices come
+    /// from the shared grid points; only the values are per message.
+    fn decode(&self, ordinal: usize) -> Option<DecodedMessage> {
+        let (_, submessage) = self.grib2.iter().nth(ordinal)?;
+
+        let grid_def = submessage.grid_def();
+        let points = self.grid_points(&grid_def.payload, grid_def.num_points() as usize, || {
+            let latlons = submessage.latlons().ok()?;
+            Some(latlons.map(|(lat, lon)| (lat as f64, normalize_longitude(lon as f64))).collect())
+        })?;
+        if points.len() == 0 {
+            return Some(DecodedMessage { points, values: Vec::new() });
+        }
+
+        let decoder = Grib2SubmessageDecoder::from(submessage).ok()?;
+        let raw: Vec<f32> = decoder.dispatch().ok()?.collect();
+        let values = points
+            .grid_indices
+            .iter()
+            .map(|&index| raw.get(index as usize).copied().unwrap_or(f32::NAN))
+            .collect();
+        Some(DecodedMessage { points, values })
+    }
+
+    /// Grid points of selected message `idx` without decoding its values.
+    /// The reader keeps them alive until it is closed.
+    fn pin_grid_points(&mut self, idx: usize) -> Option<Arc<GridPoints>> {
+        let hdr = self.headers.get(idx)?;
+        let points = {
+            let (_, submessage) = self.grib2.iter().nth(hdr.ordinal)?;
+            let grid_def = submessage.grid_def();
+            self.grid_points(&grid_def.payload, grid_def.num_points() as usize, || {
+                let latlons = submessage.latlons().ok()?;
+                Some(latlons.map(|(lat, lon)| (lat as f64, normalize_longitude(lon as f64))).collect())
+            })?
+        };
+        if !self.pinned_points.iter().any(|p| Arc::ptr_eq(p, &points)) {
+            self.pinned_points.push(points.clone());
+        }
+        Some(points)
+    }
+
+    fn message_info(&self, idx: usize) -> Option<Grib2MessageInfo> {
+        let hdr = self.headers.get(idx)?;
+        Some(Grib2MessageInfo {
+            forecast_time: hdr.forecast_time,
+            surface_value: hdr.surface_value,
+            num_points: hdr.num_points,
+            message_index: hdr.message_index,
+            discipline: hdr.discipline,
+            parameter_category: hdr.parameter_category,
+            parameter_number: hdr.parameter_number,
+            surface_type: hdr.surface_type,
+        })
+    }
+
+    fn grid_info(&self, idx: usize) -> Option<Grib2GridInfo> {
+        let hdr = self.headers.get(idx)?;
+        let mut info = Grib2GridInfo {
+            ni: 0,
+            nj: 0,
+            lat1: 0.0,
+            lon1: 0.0,
+            di: 0.0,
+            dj: 0.0,
+            template_number: hdr.grid_template,
+            regular: false,
+        };
+        if let Some(grid) = &hdr.grid {
+            info.ni = grid.ni as c_uint;
+            info.nj = grid.nj as c_uint;
+            info.lat1 = grid.lat1;
+            info.lon1 = grid.lon1;
+            info.di = grid.di;
+            info.dj = grid.dj;
+            info.regular = true;
+        }
+        Some(info)
+    }
+
+    /// Keep only messages whose flag in `keep` is non-zero (missing = keep).
+    /// Dropped messages are never unpacked. Resets the batch cursor.
+    fn select_messages(&mut self, keep: &[u8]) {
+        let mut idx = 0;
+        self.headers.retain(|_| {
+            let selected = keep.get(idx).map_or(true, |&flag| flag != 0);
+            idx += 1;
+            selected
+        });
+        self.current_message = 0;
+        self.current_point = 0;
+        self.decoded = None;
+    }
+
+    /// Replace the message part of each flat message index: message k of the
+    /// source becomes `numbers[k]` (used when only some messages of a file
+    /// were fetched). Messages without an entry keep their index.
+    fn renumber_messages(&mut self, numbers: &[u32]) {
+        for hdr in &mut self.headers {
+            let message = (hdr.message_index / 1000) as usize;
+            if let Some(&number) = numbers.get(message) {
+                hdr.message_index = number * 1000 + hdr.message_index % 1000;
+            }
+        }
+    }
+
+    fn advance(&mut self) {
+        self.current_message += 1;
+        self.current_point = 0;
+        self.decoded = None;
+    }
 
-        while points.len() < max_count {
-            if self.current_message >= self.messages.len() {
-                break;
+    /// Decode the message under the cursor if needed, skipping messages that
+    /// cannot be decoded or are exhausted. Returns false at end of input.
+    fn ensure_decoded(&mut self) -> bool {
+        while self.current_message < self.headers.len() {
+            if self.decoded.is_none() {
+                match self.decode(self.headers[self.current_message].ordinal) {
+                    Some(decoded) => {
+                        self.decoded = Some(decoded);
+                        self.current_point = 0;
+                    }
+                    None => {
+                        self.advance();
+                        continue;
+                    }
+                }
             }
+            if self.current_point < self.decoded.as_ref().map_or(0, |m| m.len()) {
+                return true;
+            }
+            self.advance();
+        }
+        false
+    }
 
-            let msg = &self.messages[self.current_message];
+    fn has_more(&self) -> bool {
+        self.current_message < self.headers.len()
+    }
+
+    fn read_batch(&mut self, max_count: usize) -> Grib2Batch {
+        let mut points = Vec::with_capacity(max_count);
 
-            while self.current_point < msg.points.len() && points.len() < max_count {
-                let (lat, lon, value) = msg.points[self.current_point];
+        while points.len() < max_count && self.ensure_decoded() {
+            let hdr = &self.headers[self.current_message];
+            let msg = self.decoded.as_ref().unwrap();
+
+            let start = self.current_point;
+            let n = (msg.len() - start).min(max_count - points.len());
+            for i in start..start + n {
                 points.push(Grib2DataPoint {
-                    latitude: lat,
-                    longitude: lon,
-                    value,
-                    discipline: msg.discipline,
-                    parameter_category: msg.parameter_category,
-                    parameter_number: msg.parameter_number,
-                    forecast_time: msg.forecast_time,
-                    surface_type: msg.surface_type,
-                    surface_value: msg.surface_value,
-                    message_index: msg.message_index,
+                    latitude: msg.points.latitudes.get(i).copied().unwrap_or(f64::NAN),
+                    longitude: msg.points.longitudes.get(i).copied().unwrap_or(f64::NAN),
+                    value: msg.values[i] as f64,
+                    discipline: hdr.discipline,
+                    parameter_category: hdr.parameter_category,
+                    parameter_number: hdr.parameter_number,
+                    forecast_time: hdr.forecast_time,
+                    surface_type: hdr.surface_type,
+                    surface_value: hdr.surface_value,
+                    message_index: hdr.message_index,
                 });
-                self.current_point += 1;
             }
+            let exhausted = start + n >= msg.len();
 
-            if self.current_point >= msg.points.len() {
-                self.current_message += 1;
-                self.current_point = 0;
+            self.current_point += n;
+            if exhausted {
+                self.advance();
             }
         }
 
-        let has_more = self.current_message < self.messages.len();
+        let has_more = self.has_more();
         let count = points.len();
 
         if count == 0 {
@@ -187,8 +884,85 @@ impl Grib2Reader {
         }
     }
 
+    /// Copy up to `max_count` points into caller buffers, one run per message
+    fn read_batch_columnar(&mut self, max_count: usize, buffers: &Grib2ColumnBuffers) -> Grib2ColumnarBatch {
+        let mut count = 0;
+        let mut run_count = 0;
+
+        while count < max_count && run_count < buffers.max_runs && self.ensure_decoded() {
+            let hdr = &self.headers[self.current_message];
+            let msg = self.decoded.as_ref().unwrap();
+
+            let start = self.current_point;
+            let n = (msg.len() - start).min(max_count - count);
+
+            unsafe {
+                msg.write_points(start, n, buffers, count);
+                buffers.runs.add(run_count).write(Grib2MessageRun {
+                    offset: count,
+                    count: n,
+                    forecast_time: hdr.forecast_time,
+                    surface_value: hdr.surface_value,
+                    message_index: hdr.message_index,
+                    discipline: hdr.discipline,
+                    parameter_category: hdr.parameter_category,
+                    parameter_number: hdr.parameter_number,
+                    surface_type: hdr.surface_type,
+                });
+            }
+            let exhausted = start + n >= msg.len();
+
+            run_count += 1;
+            count += n;
+            self.current_point += n;
+            if exhausted {
+                self.advance();
+            }
+        }
+
+        Grib2ColumnarBatch {
+            count,
+            run_count,
+            has_more: self.has_more(),
+            error: ptr::null_mut(),
+        }
+    }
+
+    /// Unpack selected message `idx` into the caller's buffers (which must
+    /// hold `capacity` points) without moving the batch cursor
+    fn read_message(&self, idx: usize, buffers: &Grib2ColumnBuffers, capacity: usize) -> Result<usize, String> {
+        let hdr = self.headers.get(idx).ok_or("Message index out of range")?;
+        let msg = self
+            .decode(hdr.ordinal)
+            .ok_or_else(|| format!("Failed to decode message {}", hdr.message_index))?;
+        let n = msg.len().min(capacity);
+
+        unsafe { msg.write_points(0, n, buffers, 0) };
+        Ok(n)
+    }
+
+    /// Sample selected message `idx` at the given coordinates. Only regular
+    /// lat/lon grids are supported; the grid indices of the points come from
+    /// the section 3 header.
+    fn sample_message(&self, idx: usize, lats: &[f64], lons: &[f64], bilinear: bool, out: &mut [f64]) -> Result<(), String> {
+        let hdr = self.headers.get(idx).ok_or("Message index out of range")?;
+        let grid = hdr
+            .grid
+            .ok_or_else(|| format!("Message {} is not on a regular lat/lon grid", hdr.message_index))?;
+        let decode_error = || format!("Failed to decode message {}", hdr.message_index);
+        let (_, submessage) = self.grib2.iter().nth(hdr.ordinal).ok_or_else(decode_error)?;
+        let decoder = Grib2SubmessageDecoder::from(submessage).map_err(|_| decode_error())?;
+        let values: Vec<f32> = decoder.dispatch().map_err(|_| decode_error())?.collect();
+
+        for ((value, &lat), &lon) in out.iter_mut().zip(lats).zip(lons) {
+            *value = grid.sample(&values, lat, lon, bilinear);
+        }
+        Ok(())
+    }
+
+    /// Total grid points of the selected messages, from section 3 headers
     fn total_points(&self) -> usize {
-        self.messages.iter().map(|m| m.points.len()).sum()
+        self.headers.iter().map(|h| h.num_points).sum()
     }
 }
 
@@ -238,7 +1012,113 @@ pub extern "C" fn grib2_open_with_error(path: *const c_char, error: *mut *mut c_
     }
 }
 
+/// Open a GRIB2 file decoding only submessages [begin, end) in file order
+/// Used to split one large file across several scan threads
+#[no_mangle]
+pub extern "C" fn grib2_open_range_with_error(
+    path: *const c_char,
+    begin: usize,
+    end: usize,
+    error: *mut *mut c_char,
+) -> *mut Grib2Reader {
+    let path_str = match unsafe { CStr::from_ptr(path) }.to_str() {
+        Ok(s) => s,
+        Err(e) => {
+            unsafe {
+                *error = CString::new(format!("Invalid UTF-8 in path: {}", e))
+                    .unwrap()
+                    .into_raw();
+            }
+            return ptr::null_mut();
+        }
+    };
+
+    match Grib2Reader::new_range(path_str, Some((begin, end))) {
+        Ok(reader) => {
+            unsafe { *error = ptr::null_mut(); }
+            Box::into_raw(Box::new(reader))
+        }
+        Err(e) => {
+            unsafe {
+                *error = CString::new(e).unwrap().into_raw();
+            }
+            ptr::null_mut()
+        }
+    }
+}
+
+/// Count submessages in a GRIB2 file (headers only, no decoding)
+/// Returns 0 and sets error on failure
+#[no_mangle]
+pub extern "C" fn grib2_count_messages(path: *const c_char, error: *mut *mut c_char) -> usize {
+    let path_str = match unsafe { CStr::from_ptr(path) }.to_str() {
+        Ok(s) => s,
+        Err(e) => {
+            unsafe {
+                *error = CString::new(format!("Invalid UTF-8 in path: {}", e))
+                    .unwrap()
+                    .into_raw();
+            }
+            return 0;
+        }
+    };
+
+    match Grib2Reader::count_messages(path_str) {
+        Ok(count) => {
+            unsafe { *error = ptr::null_mut(); }
+            count
+        }
+        Err(e) => {
+            unsafe {
+                *error = CString::new(e).unwrap().into_raw();
+            }
+            0
+        }
+    }
+}
+
+/// Locate the messages of a local GRIB2 file from their section 0 lengths,
+/// without parsing any other section. Writes up to `capacity` locations
+/// and returns the total number of messages (call with capacity 0 to size
+/// the buffer). Returns 0 and sets error on failure.
+#[no_mangle]
+pub extern "C" fn grib2_scan_messages(
+    path: *const c_char,
+    locations: *mut Grib2MessageLocation,
+    capacity: usize,
+    error: *mut *mut c_char,
+) -> usize {
+    let set_error = |message: String| unsafe {
+        *error = CString::new(message).unwrap_or_default().into_raw();
+    };
+    let path_str = match unsafe { CStr::from_ptr(path) }.to_str() {
+        Ok(s) => s,
+        Err(e) => {
+            set_error(format!("Invalid UTF-8 in path: {}", e));
+            return 0;
+        }
+    };
+
+    match map_file(path_str).and_then(|data| scan_message_locations(&data)) {
+        Ok(found) => {
+            unsafe { *error = ptr::null_mut() };
+            let count = found.len();
+            if !locations.is_null() {
+                for (k, location) in found.into_iter().take(capacity).enumerate() {
+                    unsafe { locations.add(k).write(location) };
+                }
+            }
+            count
+        }
+        Err(e) => {
+            set_error(e);
+            0
+        }
+    }
+}
+
 /// Open a GRIB2 reader from in-memory bytes (for HTTP fetched data)
+/// The bytes are borrowed, not copied: they must stay alive until grib2_close
 /// Returns opaque handle, caller must close with grib2_close
 #[no_mangle]
 pub extern "C" fn grib2_open_from_bytes(
@@ -253,9 +1133,7 @@ pub extern "C" fn grib2_open_from_bytes(
         return ptr::null_mut();
     }
 
-    let bytes = unsafe { std::slice::from_raw_parts(data, len) };
-
-    match Grib2Reader::from_bytes(bytes) {
+    match unsafe { Grib2Reader::from_borrowed_bytes(data, len) } {
         Ok(reader) => {
             unsafe { *error = ptr::null_mut(); }
             Box::into_raw(Box::new(reader))
@@ -286,6 +1164,238 @@ pub extern "C" fn grib2_read_batch(reader: *mut Grib2Reader, max_count: usize) -
     reader.read_batch(max_count)
 }
 
+/// Read up to max_count points into caller-provided column buffers.
+/// Metadata is returned once per run of points from the same message.
+/// Error (if any) must be freed with grib2_free_error.
+#[no_mangle]
+pub extern "C" fn grib2_read_batch_columnar(
+    reader: *mut Grib2Reader,
+    max_count: usize,
+    buffers: *const Grib2ColumnBuffers,
+) -> Grib2ColumnarBatch {
+    if reader.is_null() || buffers.is_null() || unsafe { (*buffers).runs.is_null() } {
+        return Grib2ColumnarBatch {
+            count: 0,
+            run_count: 0,
+            has_more: false,
+            error: CString::new("Null reader or buffers").unwrap().into_raw(),
+        };
+    }
+
+    let reader = unsafe { &mut *reader };
+    let buffers = unsafe { &*buffers };
+    reader.read_batch_columnar(max_count, buffers)
+}
+
+/// Unpack all points of selected message `idx` into caller-provided buffers
+/// holding `capacity` points each. The runs buffer is not used and the batch
+/// cursor does not move. Error (if any) must be freed with grib2_free_error.
+#[no_mangle]
+pub extern "C" fn grib2_read_message(
+    reader: *mut Grib2Reader,
+    idx: usize,
+    buffers: *const Grib2ColumnBuffers,
+    capacity: usize,
+) -> Grib2ColumnarBatch {
+    let mut batch = Grib2ColumnarBatch {
+        count: 0,
+        run_count: 0,
+        has_more: false,
+        error: ptr::null_mut(),
+    };
+    if reader.is_null() || buffers.is_null() {
+        batch.error = CString::new("Null reader or buffers").unwrap().into_raw();
+        return batch;
+    }
+
+    let reader = unsafe { &*reader };
+    let buffers = unsafe { &*buffers };
+    match reader.read_message(idx, buffers, capacity) {
+        Ok(count) => batch.count = count,
+        Err(e) => batch.error = CString::new(e).unwrap().into_raw(),
+    }
+    batch
+}
+
+/// Sample selected message `idx` at `count` coordinates into `values`
+/// (NaN outside the grid). `bilinear` interpolates between the four
+/// surrounding grid points instead of taking the nearest one.
+/// Returns false and sets `error` (free with grib2_free_error) on failure.
+#[no_mangle]
+pub extern "C" fn grib2_sample_message(
+    reader: *mut Grib2Reader,
+    idx: usize,
+    latitudes: *const c_double,
+    longitudes: *const c_double,
+    count: usize,
+    bilinear: bool,
+    values: *mut c_double,
+    error: *mut *mut c_char,
+) -> bool {
+    let result = if reader.is_null() || (count > 0 && (latitudes.is_null() || longitudes.is_null() || values.is_null())) {
+        Err("Null reader or buffers".to_string())
+    } else if count == 0 {
+        Ok(())
+    } else {
+        let reader = unsafe { &*reader };
+        let lats = unsafe { std::slice::from_raw_parts(latitudes, count) };
+        let lons = unsafe { std::slice::from_raw_parts(longitudes, count) };
+        let out = unsafe { std::slice::from_raw_parts_mut(values, count) };
+        reader.sample_message(idx, lats, lons, bilinear, out)
+    };
+    match result {
+        Ok(()) => true,
+        Err(e) => {
+            if !error.is_null() {
+                unsafe { *error = CString::new(e).unwrap().into_raw() };
+            }
+            false
+        }
+    }
+}
+
+/// Enable or disable latitude/longitude generation for subsequently decoded
+/// messages (enabled by default). When disabled, columnar reads leave the
+/// coordinate buffers untouched.
+#[no_mangle]
+pub extern "C" fn grib2_set_decode_coordinates(reader: *mut Grib2Reader, enabled: bool) {
+    if reader.is_null() {
+        return;
+    }
+    let reader = unsafe { &mut *reader };
+    reader.decode_coordinates = enabled;
+}
+
+/// Restrict decoded points to an inclusive latitude/longitude window
+/// (longitudes in -180..180). Points outside are never emitted; on regular
+/// lat/lon grids rows and columns outside the window are skipped by index.
+/// Resets the batch cursor of the current message.
+#[no_mangle]
+pub extern "C" fn grib2_set_bbox(
+    reader: *mut Grib2Reader,
+    lat_min: c_double,
+    lat_max: c_double,
+    lon_min: c_double,
+    lon_max: c_double,
+) {
+    if reader.is_null() {
+        return;
+    }
+    let reader = unsafe { &mut *reader };
+    reader.bbox = Some(BoundingBox {
+        lat_min,
+        lat_max,
+        lon_min,
+        lon_max,
+    });
+    reader.current_point = 0;
+    reader.decoded = None;
+}
+
+/// Number of messages currently selected in the reader
+#[no_mangle]
+pub extern "C" fn grib2_message_count(reader: *mut Grib2Reader) -> usize {
+    if reader.is_null() {
+        return 0;
+    }
+    let reader = unsafe { &*reader };
+    reader.headers.len()
+}
+
+/// Get header metadata of selected message `idx` (no decoding)
+/// Returns false if reader is null or idx is out of range
+#[no_mangle]
+pub extern "C" fn grib2_message_info(reader: *mut Grib2Reader, idx: usize, info: *mut Grib2MessageInfo) -> bool {
+    if reader.is_null() || info.is_null() {
+        return false;
+    }
+    let reader = unsafe { &*reader };
+    match reader.message_info(idx) {
+        Some(message_info) => {
+            unsafe { info.write(message_info) };
+            true
+        }
+        None => false,
+    }
+}
+
+/// Get the grid definition of selected message `idx` (no decoding)
+/// Returns false if reader is null or idx is out of range
+#[no_mangle]
+pub extern "C" fn grib2_grid_info(reader: *mut Grib2Reader, idx: usize, info: *mut Grib2GridInfo) -> bool {
+    if reader.is_null() || info.is_null() {
+        return false;
+    }
+    let reader = unsafe { &*reader };
+    match reader.grid_info(idx) {
+        Some(grid_info) => {
+            unsafe { info.write(grid_info) };
+            true
+        }
+        None => false,
+    }
+}
+
+/// Get the shared grid points of selected message `idx` without decoding
+/// its values. Every message on the same grid returns the same arrays,
+/// which stay valid until the reader is closed.
+/// Returns false if reader is null or idx is out of range
+#[no_mangle]
+pub extern "C" fn grib2_grid_points(reader: *mut Grib2Reader, idx: usize, out: *mut Grib2GridPoints) -> bool {
+    if reader.is_null() || out.is_null() {
+        return false;
+    }
+    let reader = unsafe { &mut *reader };
+    let Some(points) = reader.pin_grid_points(idx) else {
+        return false;
+    };
+    let coordinate = |values: &Vec<f64>| {
+        if values.is_empty() {
+            ptr::null()
+        } else {
+            values.as_ptr()
+        }
+    };
+    unsafe {
+        out.write(Grib2GridPoints {
+            latitude: coordinate(&points.latitudes),
+            longitude: coordinate(&points.longitudes),
+            grid_index: points.grid_indices.as_ptr(),
+            count: points.len(),
+        })
+    };
+    true
+}
+
+/// Restrict the reader to messages with a non-zero flag in keep[0..count]
+/// Must be called before reading; skipped messages are never unpacked
+#[no_mangle]
+pub extern "C" fn grib2_select_messages(reader: *mut Grib2Reader, keep: *const u8, count: usize) {
+    if reader.is_null() || keep.is_null() {
+        return;
+    }
+    let reader = unsafe { &mut *reader };
+    let keep = unsafe { std::slice::from_raw_parts(keep, count) };
+    reader.select_messages(keep);
+}
+
+/// Map message k of the source to message number `numbers[k]` of the
+/// original file, so message_index stays stable when a reader was opened
+/// from selected byte ranges. Call before filtering on message_index.
+#[no_mangle]
+pub extern "C" fn grib2_renumber_messages(
+    reader: *mut Grib2Reader,
+    numbers: *const u32,
+    count: usize,
+) {
+    if reader.is_null() || numbers.is_null() {
+        return;
+    }
+    let reader = unsafe { &mut *reader };
+    let numbers = unsafe { std::slice::from_raw_parts(numbers, count) };
+    reader.renumber_messages(numbers);
+}
+
 /// Get total number of data points in file (for cardinality)
 #[no_mangle]
 pub extern "C" fn grib2_total_points(reader: *mut Grib2Reader) -> usize {
@@ -387,3 +1497,128 @@ pub extern "C" fn grib2_free_result(result: Grib2ReadResult) {
         }
     }
 }
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    /// examples/gfs_sample.grib2: one message, a regular 5 x 5 grid of 0.25
+    /// degrees from 61N 23E scanned south to north (scanning mode 0x40)
+    fn sample() -> Vec<u8> {
+        let path = std::path::Path::new(env!("CARGO_MANIFEST_DIR")).join("../examples/gfs_sample.grib2");
+        std::fs::read(path).unwrap()
+    }
+
+    /// Section 3 payload (octet 6 onwards) of the sample: section 3 follows
+    /// the 21-byte section 1 after the 16-byte section 0
+    fn sample_grid_payload() -> Vec<u8> {
+        let data = sample();
+        assert_eq!(data[16 + 21 + 4], 3);
+        data[16 + 21 + 5..16 + 21 + 72].to_vec()
+    }
+
+    #[test]
+    fn regular_grid_parse_sample() {
+        let grid = RegularGrid::parse(&sample_grid_payload()).unwrap();
+        assert_eq!((grid.ni, grid.nj), (5, 5));
+        assert_eq!((grid.lat1, grid.lon1), (61.0, 23.0));
+        assert_eq!((grid.di, grid.dj), (0.25, 0.25));
+        assert_eq!(grid.latitude(4), 62.0);
+        assert_eq!(grid.longitude(4), 24.0);
+    }
+
+    #[test]
+    fn regular_grid_parse_scanning_directions() {
+        let mut payload = sample_grid_payload();
+        // Bit 1: points run west, bit 2 cleared: rows run south
+        payload[66] = 0x80;
+        let grid = RegularGrid::parse(&payload).unwrap();
+        assert_eq!((grid.di, grid.dj), (-0.25, -0.25));
+        assert_eq!(grid.latitude(1), 60.75);
+
+        // Consecutive along j and boustrophedon rows are not indexed directly
+        for mode in [0x20, 0x10] {
+            payload[66] = mode;
+            assert!(RegularGrid::parse(&payload).is_none());
+        }
+    }
+
+    #[test]
+    fn regular_grid_parse_longitudes() {
+        let mut payload = sample_grid_payload();
+        // First longitude 350E is -10 in output coordinates
+        payload[45..49].copy_from_slice(&350_000_000u32.to_be_bytes());
+        let grid = RegularGrid::parse(&payload).unwrap();
+        assert_eq!(grid.longitude(0), -10.0);
+        // Sign-magnitude latitude: 61S
+        payload[41..45].copy_from_slice(&(0x8000_0000u32 | 61_000_000).to_be_bytes());
+        assert_eq!(RegularGrid::parse(&payload).unwrap().lat1, -61.0);
+    }
+
+    #[test]
+    fn regular_grid_parse_rejects() {
+        let payload = sample_grid_payload();
+        // Other templates, e.g. 3.40 (Gaussian)
+        let mut gaussian = payload.clone();
+        gaussian[7..9].copy_from_slice(&40u16.to_be_bytes());
+        assert!(RegularGrid::parse(&gaussian).is_none());
+        // Coordinates in units other than microdegrees
+        let mut angle = payload.clone();
+        angle[33..37].copy_from_slice(&1u32.to_be_bytes());
+        assert!(RegularGrid::parse(&angle).is_none());
+        // Truncated payloads
+        assert!(RegularGrid::parse(&payload[..60]).is_none());
+        assert!(RegularGrid::parse(&[]).is_none());
+    }
+
+    #[test]
+    fn scan_message_locations_sample() {
+        let locations = scan_message_locations(&sample()).unwrap();
+        assert_eq!(locations.len(), 1);
+        let location = &locations[0];
+        assert_eq!((location.offset, location.length), (0, 208));
+        assert_eq!((location.year, location.month, location.day), (2026, 1, 20));
+        assert_eq!((location.hour, location.minute, location.second), (0, 0, 0));
+    }
+
+    #[test]
+    fn scan_message_locations_skips_padding() {
+        let message = sample();
+        let mut data = b"padding".to_vec();
+        data.extend_from_slice(&message);
+        data.extend_from_slice(&[0; 3]);
+        data.extend_from_slice(&message);
+        data.extend_from_slice(b"tail");
+        let locations = scan_message_locations(&data).unwrap();
+        let offsets: Vec<u64> = locations.iter().map(|l| l.offset).collect();
+        assert_eq!(offsets, vec![7, 7 + 208 + 3]);
+        assert!(locations.iter().all(|l| l.length == 208 && l.year == 2026));
+
+        assert!(scan_message_locations(b"").unwrap().is_empty());
+        assert!(scan_message_locations(b"no messages in here").unwrap().is_empty());
+    }
+
+    #[test]
+    fn scan_message_locations_errors() {
+        let message = sample();
+        let mut edition1 = message.clone();
+        edition1[7] = 1;
+        assert!(scan_message_locations(&edition1).is_err());
+
+        assert!(scan_message_locations(&message[..200]).is_err());
+
+        let mut short = message.clone();
+        short[8..16].copy_from_slice(&8u64.to_be_bytes());
+        assert!(scan_message_locations(&short).is_err());
+    }
+
+    #[test]
+    fn scan_message_locations_without_identification() {
+        // A section other than 1 after section 0 leaves the time unset
+        let mut message = sample();
+        message[16 + 4] = 2;
+        let locations = scan_message_locations(&message).unwrap();
+        assert_eq!((locations[0].offset, locations[0].length), (0, 208));
+        assert_eq!(locations[0].year, 0);
+    }
+}
@@ -12,8 +12,17 @@
 set -e
 
 REGION=${1:-tampere}
-DATE=$(date -u +%Y%m%d)
-RUN=00  # Latest available run
+
+# Latest run that has started publishing (f000 is written first)
+read DATE RUN <<< "$(./build/release/duckdb -unsigned -noheader -list -separator ' ' -c "
+    LOAD './build/release/weather.duckdb_extension';
+    SELECT run_date, lpad(run_hour::VARCHAR, 2, '0')
+    FROM available_runs(forecast_hours := [0])
+    ORDER BY model_run_at DESC LIMIT 1")"
+if [ -z "$DATE" ]; then
+    DATE=$(date -u +%Y%m%d)
+    RUN=00
+fi
 
 # Region configurations (lat_min lat_max lon_min lon_max)
 case "$REGION" in
@@ -34,7 +43,9 @@ esac
 
 read LAT_MIN LAT_MAX LON_MIN LON_MAX <<< "$BBOX"
 
-GRIB_DIR="/tmp/gfs_${REGION}"
+# One directory per run: hours downloaded by an earlier invocation for the
+# same run are kept, so each file is fetched once as the run is published
+GRIB_DIR="/tmp/gfs_${REGION}/${DATE}_${RUN}"
 OUTPUT_DIR="/tmp/weather_parquet/${REGION}"
 
 mkdir -p "$GRIB_DIR" "$OUTPUT_DIR"
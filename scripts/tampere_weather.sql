@@ -25,8 +25,8 @@ SELECT 'Fetching weather forecast for Tampere, Finland...' as status;
 WITH raw_data AS (
     SELECT
         h3_latlng_to_cell(latitude, longitude, 5)::UBIGINT as h3_index,
-        (strptime(run_date, '%Y%m%d') + interval '1 hour' * run_hour)::TIMESTAMPTZ as model_run_at,
-        (strptime(run_date, '%Y%m%d') + interval '1 hour' * (run_hour + forecast_hour))::TIMESTAMPTZ as forecast_at,
+        model_run_at,
+        valid_at as forecast_at,
         variable,
         level,
         value
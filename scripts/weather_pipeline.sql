@@ -65,8 +65,8 @@ SELECT 'Fetching 36 forecast files from NOAA GFS...' as status;
 COPY (
     SELECT
         h3_latlng_to_cell(latitude, longitude, getvariable('h3_res'))::UBIGINT as h3_index,
-        (strptime(run_date, '%Y%m%d') + interval '1 hour' * run_hour)::TIMESTAMPTZ as model_run_at,
-        (strptime(run_date, '%Y%m%d') + interval '1 hour' * (run_hour + forecast_hour))::TIMESTAMPTZ as forecast_at,
+        model_run_at,
+        valid_at as forecast_at,
         -- Temperature: 2m above ground (K → C)
         MAX(CASE WHEN variable = 'temperature' AND level = '2m'
             THEN value - 273.15 END) as temperature_celsius,
@@ -123,8 +123,8 @@ SELECT 'Pipeline complete!' as status;
 COPY (
     SELECT
         h3_latlng_to_cell(latitude, longitude, 5)::UBIGINT as h3_index,
-        (strptime(run_date, '%Y%m%d') + interval '1 hour' * run_hour)::TIMESTAMPTZ as model_run_at,
-        (strptime(run_date, '%Y%m%d') + interval '1 hour' * (run_hour + forecast_hour))::TIMESTAMPTZ as forecast_at,
+        model_run_at,
+        valid_at as forecast_at,
         MAX(CASE WHEN variable = 'temperature' AND level = '2m'
             THEN value - 273.15 END) as temperature_celsius,
         MAX(CASE WHEN variable = 'humidity' AND level = '2m'
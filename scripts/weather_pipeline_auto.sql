@@ -8,6 +8,11 @@
 --
 -- Memory usage scales with threads: ~4-5GB per thread
 -- Thread count auto-calculated from available memory
+--
+-- Run against a database file to ingest incrementally: the hours of the
+-- latest run loaded by earlier invocations are kept in gfs_raw and not
+-- downloaded again, e.g. every 30 minutes from cron:
+--   duckdb /tmp/weather_global/ingest.duckdb < scripts/weather_pipeline_auto.sql
 
 .timer on
 
@@ -18,7 +23,9 @@ LOAD weather;
 -- ============================================================================
 -- CONFIGURATION
 -- ============================================================================
-SET VARIABLE run_date = strftime(now() AT TIME ZONE 'UTC', '%Y%m%d');
+-- Latest run that has started publishing (f000 comes first)
+SET VARIABLE model_run_at = (
+    SELECT max(model_run_at) FROM available_runs(forecast_hours := [0]));
 SET VARIABLE output_dir = '/tmp/weather_global';
 
 -- ============================================================================
@@ -138,13 +145,25 @@ SELECT strategy, optimal_threads FROM strategy;
 SELECT 'Step 1: Downloading GRIB data...' as status
 WHERE (SELECT strategy FROM exec_config) IN ('direct', 'partitioned');
 
-COPY (
+CREATE TABLE IF NOT EXISTS gfs_raw (
+    latitude DOUBLE, longitude DOUBLE, value DOUBLE,
+    variable VARCHAR, level VARCHAR,
+    model_run_at TIMESTAMPTZ, valid_at TIMESTAMPTZ, forecast_hour INTEGER
+);
+DELETE FROM gfs_raw WHERE model_run_at <> getvariable('model_run_at');
+
+-- Only hours that are published and not loaded yet are downloaded
+SET VARIABLE loaded_hours = (
+    SELECT list(DISTINCT forecast_hour) FROM gfs_raw
+    WHERE model_run_at = getvariable('model_run_at')
+);
+INSERT INTO gfs_raw
     SELECT
         latitude, longitude, value, variable, level,
-        run_date, run_hour, forecast_hour
-    FROM noaa_gfs_forecast_api()
-    WHERE run_date = getvariable('run_date')
-      AND run_hour = 0
+        model_run_at, valid_at, forecast_hour
+    FROM noaa_gfs_forecast_api(loaded_hours := getvariable('loaded_hours'),
+                               skip_unavailable := true)
+    WHERE model_run_at = getvariable('model_run_at')
       AND forecast_hour IN (0, 3, 6, 9, 12, 15, 18, 21, 24,
                             30, 36, 42, 48, 54, 60, 66, 72,
                             84, 96, 108, 120, 132, 144,
@@ -152,7 +171,11 @@ COPY (
       AND variable IN ('temperature', 'humidity', 'wind_u', 'wind_v',
                        'precipitation', 'gust', 'clouds', 'pressure')
       AND level IN ('2m', '10m', 'surface', 'atmosphere', 'msl')
-      AND (SELECT strategy FROM exec_config) IN ('direct', 'partitioned')
+      AND (SELECT strategy FROM exec_config) IN ('direct', 'partitioned');
+
+COPY (
+    SELECT * FROM gfs_raw
+    WHERE (SELECT strategy FROM exec_config) IN ('direct', 'partitioned')
 ) TO '/tmp/weather_global/raw_global.parquet' (FORMAT PARQUET, COMPRESSION ZSTD);
 
 SELECT 'Download complete' as status
@@ -175,8 +198,8 @@ FROM exec_config WHERE strategy = 'direct';
 COPY (
     SELECT
         h3_latlng_to_cell(latitude, longitude, 5)::UBIGINT as h3_index,
-        (strptime(run_date, '%Y%m%d') + interval '1 hour' * run_hour)::TIMESTAMPTZ as model_run_at,
-        (strptime(run_date, '%Y%m%d') + interval '1 hour' * (run_hour + forecast_hour))::TIMESTAMPTZ as forecast_at,
+        model_run_at,
+        valid_at as forecast_at,
         (MAX(CASE WHEN variable = 'temperature' AND level = '2m'
             THEN value - 273.15 END))::REAL as temperature_celsius,
         (MAX(CASE WHEN variable = 'humidity' AND level = '2m'
@@ -212,8 +235,8 @@ WHERE (SELECT strategy FROM exec_config) = 'direct';
 CREATE OR REPLACE MACRO process_band_from_file(lat_min_p, lat_max_p) AS TABLE
     SELECT
         h3_latlng_to_cell(latitude, longitude, 5)::UBIGINT as h3_index,
-        (strptime(run_date, '%Y%m%d') + interval '1 hour' * run_hour)::TIMESTAMPTZ as model_run_at,
-        (strptime(run_date, '%Y%m%d') + interval '1 hour' * (run_hour + forecast_hour))::TIMESTAMPTZ as forecast_at,
+        model_run_at,
+        valid_at as forecast_at,
         (MAX(CASE WHEN variable = 'temperature' AND level = '2m'
             THEN value - 273.15 END))::REAL as temperature_celsius,
         (MAX(CASE WHEN variable = 'humidity' AND level = '2m'
@@ -242,8 +265,8 @@ CREATE OR REPLACE MACRO process_band_from_file(lat_min_p, lat_max_p) AS TABLE
 CREATE OR REPLACE MACRO process_band_streaming(lat_min_p, lat_max_p) AS TABLE
     SELECT
         h3_latlng_to_cell(latitude, longitude, 5)::UBIGINT as h3_index,
-        (strptime(run_date, '%Y%m%d') + interval '1 hour' * run_hour)::TIMESTAMPTZ as model_run_at,
-        (strptime(run_date, '%Y%m%d') + interval '1 hour' * (run_hour + forecast_hour))::TIMESTAMPTZ as forecast_at,
+        model_run_at,
+        valid_at as forecast_at,
         (MAX(CASE WHEN variable = 'temperature' AND level = '2m'
             THEN value - 273.15 END))::REAL as temperature_celsius,
         (MAX(CASE WHEN variable = 'humidity' AND level = '2m'
@@ -264,9 +287,8 @@ CREATE OR REPLACE MACRO process_band_streaming(lat_min_p, lat_max_p) AS TABLE
             THEN value END))::REAL as cloud_cover_percentage,
         (MAX(CASE WHEN variable = 'pressure' AND level = 'msl'
             THEN value / 100.0 END))::REAL as sea_level_pressure_hpa
-    FROM noaa_gfs_forecast_api()
-    WHERE run_date = getvariable('run_date')
-      AND run_hour = 0
+    FROM noaa_gfs_forecast_api(skip_unavailable := true)
+    WHERE model_run_at = getvariable('model_run_at')
       AND forecast_hour IN (0, 3, 6, 9, 12, 15, 18, 21, 24,
                             30, 36, 42, 48, 54, 60, 66, 72,
                             84, 96, 108, 120, 132, 144,
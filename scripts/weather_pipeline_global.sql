@@ -50,8 +50,8 @@ SELECT * FROM (VALUES
 CREATE OR REPLACE MACRO process_band(lat_min, lat_max, band_name) AS TABLE
     SELECT
         h3_latlng_to_cell(latitude, longitude, 5)::UBIGINT as h3_index,
-        (strptime(run_date, '%Y%m%d') + interval '1 hour' * run_hour)::TIMESTAMPTZ as model_run_at,
-        (strptime(run_date, '%Y%m%d') + interval '1 hour' * (run_hour + forecast_hour))::TIMESTAMPTZ as forecast_at,
+        model_run_at,
+        valid_at as forecast_at,
         (MAX(CASE WHEN variable = 'temperature' AND level = '2m'
             THEN value - 273.15 END))::REAL as temperature_celsius,
         (MAX(CASE WHEN variable = 'humidity' AND level = '2m'
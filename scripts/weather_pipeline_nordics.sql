@@ -50,8 +50,8 @@ SELECT 'Run: ' || strftime(now() AT TIME ZONE 'UTC', '%Y-%m-%d') || ' 00Z' as in
 COPY (
     SELECT
         h3_latlng_to_cell(latitude, longitude, getvariable('h3_res'))::UBIGINT as h3_index,
-        (strptime(run_date, '%Y%m%d') + interval '1 hour' * run_hour)::TIMESTAMPTZ as model_run_at,
-        (strptime(run_date, '%Y%m%d') + interval '1 hour' * (run_hour + forecast_hour))::TIMESTAMPTZ as forecast_at,
+        model_run_at,
+        valid_at as forecast_at,
         -- Temperature: 2m above ground (K → C)
         (MAX(CASE WHEN variable = 'temperature' AND level = '2m'
             THEN value - 273.15 END))::REAL as temperature_celsius,
@@ -8,14 +8,24 @@
 #include "duckdb/main/config.hpp"
 #include "duckdb/main/connection.hpp"
 #include "duckdb/optimizer/optimizer_extension.hpp"
+#include "duckdb/planner/expression/bound_cast_expression.hpp"
 #include "duckdb/planner/expression/bound_columnref_expression.hpp"
 #include "duckdb/planner/expression/bound_comparison_expression.hpp"
 #include "duckdb/planner/expression/bound_constant_expression.hpp"
 #include "duckdb/planner/expression/bound_operator_expression.hpp"
 #include "duckdb/planner/operator/logical_get.hpp"
-#include "duckdb/planner/operator/logical_limit.hpp"
+#include "duckdb/storage/statistics/base_statistics.hpp"
+#include "duckdb/storage/statistics/numeric_stats.hpp"
 #include "grib2_ffi.h"
+#include "grib_h3.hpp"
+#include "grib_series.hpp"
+#include "grib_wide.hpp"
+#include "weather_http.hpp"
+#include "weather_limit.hpp"
+#include "weather_metrics.hpp"
+#include <algorithm>
 #include <atomic>
+#include <cmath>
 #include <unordered_map>
 #include <unordered_set>
 
@@ -69,14 +79,119 @@ static const std::unordered_map<string, string> LEVEL_MAP = {
     {"mean_sea_level", "lev_mean_sea_level"},
 };
 
+// Output column positions
+static constexpr idx_t GFS_COL_LATITUDE = 0;
+static constexpr idx_t GFS_COL_LONGITUDE = 1;
+static constexpr idx_t GFS_COL_VALUE = 2;
+static constexpr idx_t GFS_COL_UNIT = 3;
+static constexpr idx_t GFS_COL_VARIABLE = 4;
+static constexpr idx_t GFS_COL_LEVEL = 5;
+static constexpr idx_t GFS_COL_FORECAST_HOUR = 6;
+static constexpr idx_t GFS_COL_RUN_DATE = 7;
+static constexpr idx_t GFS_COL_RUN_HOUR = 8;
+static constexpr idx_t GFS_COL_MODEL_RUN_AT = 9;
+static constexpr idx_t GFS_COL_VALID_AT = 10;
+
+// Output column positions with wide := true; the GFS_WIDE_VARIABLES columns
+// follow the fixed ones
+static constexpr idx_t GFS_WIDE_COL_FORECAST_HOUR = 2;
+static constexpr idx_t GFS_WIDE_COL_RUN_DATE = 3;
+static constexpr idx_t GFS_WIDE_COL_RUN_HOUR = 4;
+static constexpr idx_t GFS_WIDE_COL_MODEL_RUN_AT = 5;
+static constexpr idx_t GFS_WIDE_COL_VALID_AT = 6;
+static constexpr idx_t GFS_WIDE_COL_FIRST_VALUE = 7;
+
+// With h3_resolution, h3_index and point_count replace the coordinates
+static constexpr idx_t GFS_H3_COL_INDEX = 0;
+static constexpr idx_t GFS_H3_COL_POINT_COUNT = 1;
+
+// A (variable, level) column of wide output and the NOMADS filter
+// parameters that download it
+struct GfsWideVariable {
+  const char *name;
+  const char *api_variable;
+  const char *api_level;
+  GribWideColumn column;
+};
+
+static const vector<GfsWideVariable> GFS_WIDE_VARIABLES = {
+    {"temperature_2m", "var_TMP", "lev_2_m_above_ground",
+     {0, 0, 0, 103, 2, true}},
+    {"humidity_2m", "var_RH", "lev_2_m_above_ground", {0, 1, 1, 103, 2, true}},
+    {"wind_u_10m", "var_UGRD", "lev_10_m_above_ground",
+     {0, 2, 2, 103, 10, true}},
+    {"wind_v_10m", "var_VGRD", "lev_10_m_above_ground",
+     {0, 2, 3, 103, 10, true}},
+    {"gust_surface", "var_GUST", "lev_surface", {0, 2, 22, 1, 0, false}},
+    {"precipitation_surface", "var_APCP", "lev_surface",
+     {0, 1, 8, 1, 0, false}},
+    {"clouds_atmosphere", "var_TCDC", "lev_entire_atmosphere",
+     {0, 6, 1, 10, 0, false}},
+    {"pressure_msl", "var_PRMSL", "lev_mean_sea_level",
+     {0, 3, 1, 101, 0, false}},
+};
+
+// ENUM values of the variable column, and the unit of each (nullptr = NULL)
+static const char *GFS_VARIABLE_ENUM = "gfs_variable";
+static const vector<string> GFS_VARIABLE_VALUES = {
+    "temperature", "humidity", "precipitation", "wind_u", "wind_v",
+    "gust",        "pressure", "clouds",        "unknown"};
+static const char *const GFS_VARIABLE_UNITS[] = {
+    "K", "%", "kg/m^2", "m/s", "m/s", "m/s", "Pa", "%", nullptr};
+
+// ENUM values of the level column: the fixed levels, then every height
+// above ground (the first surface of layers such as 3000-0 m helicity) and
+// isobaric level published in pgrb2.0p25 files
+static const char *GFS_LEVEL_ENUM = "gfs_level";
+static const vector<string> GFS_FIXED_LEVELS = {"surface", "atmosphere",
+                                                "msl"};
+static const vector<int32_t> GFS_HEIGHT_LEVELS = {
+    2, 10, 20, 30, 40, 50, 80, 100, 1000, 3000, 4000, 6000};
+// In Pa, down to the 0.01 hPa top of the model
+static const vector<int32_t> GFS_PRESSURE_LEVELS = {
+    100000, 97500, 95000, 92500, 90000, 85000, 80000, 75000, 70000,
+    65000,  60000, 55000, 50000, 45000, 40000, 35000, 30000, 25000,
+    20000,  15000, 10000, 7000,  5000,  4000,  3000,  2000,  1500,
+    1000,   700,   500,   300,   200,   100,   70,    40,    20,
+    10,     7,     4,     2,     1};
+
+static vector<string> GfsLevelValues() {
+  auto values = GFS_FIXED_LEVELS;
+  for (auto height : GFS_HEIGHT_LEVELS) {
+    values.push_back(StringUtil::Format("%dm", height));
+  }
+  // "500hPa", and "0.4hPa" above 1 hPa
+  for (auto pressure : GFS_PRESSURE_LEVELS) {
+    values.push_back(StringUtil::Format("%ghPa", pressure / 100.0));
+  }
+  values.push_back("unknown");
+  return values;
+}
+
+// Forecast hours downloaded ahead of the decoding threads
+static constexpr const char *GFS_MAX_CONCURRENT_DOWNLOADS_KEY =
+    "gfs_max_concurrent_downloads";
+static constexpr idx_t DEFAULT_GFS_MAX_CONCURRENT_DOWNLOADS = 4;
+
+// Scheme and host serving the filter CGI and the pub/ inventories, e.g. a
+// local mock server for benchmarks
+static constexpr const char *GFS_BASE_URL_KEY = "gfs_base_url";
+static constexpr const char *DEFAULT_GFS_BASE_URL =
+    "https://nomads.ncep.noaa.gov";
+
 // ============================================================
 // Bind Data - stores pushed-down filters
 // ============================================================
 
-struct GfsForecastBindData : public TableFunctionData {
+struct GfsForecastBindData : public WeatherLimitBindData {
   // Output schema
   vector<string> column_names;
   vector<LogicalType> column_types;
+  LogicalType variable_type;
+  LogicalType level_type;
+
+  // gfs_base_url at bind time
+  string base_url;
 
   // Pushed-down filters (from WHERE clause)
   string run_date;                // YYYYMMDD format
@@ -84,6 +199,15 @@ struct GfsForecastBindData : public TableFunctionData {
   vector<int32_t> forecast_hours; // f000, f003, etc.
   vector<string> variables;       // var_TMP, var_RH, etc.
   vector<string> levels;          // lev_2_m_above_ground, etc.
+  // Set by forecast_hours := [...]; forecast_hour filters then stay in the
+  // plan instead of replacing the list
+  bool forecast_hours_given = false;
+
+  // Incremental ingestion: skip loaded_hours, the hours of the run already
+  // present downstream, and with skip_unavailable the hours NOMADS has not
+  // published yet
+  vector<int32_t> loaded_hours;
+  bool skip_unavailable = false;
 
   // Bounding box (subregion)
   double lat_min = -90.0;
@@ -92,8 +216,14 @@ struct GfsForecastBindData : public TableFunctionData {
   double lon_max = 360.0;
   bool has_bbox = false;
 
-  // LIMIT pushdown
-  idx_t max_results = 0; // 0 = unlimited
+  // One row per grid point and forecast hour, GFS_WIDE_VARIABLES as columns
+  bool wide = false;
+  // With a resolution (0-15), wide rows are averaged per H3 cell
+  int32_t h3_resolution = -1;
+  shared_ptr<const GribH3CellFunction> h3_cells;
+  // layout := 'series': one row per point (or cell) over all forecast hours,
+  // in the wide column positions
+  bool series = false;
 };
 
 // ============================================================
@@ -101,36 +231,83 @@ struct GfsForecastBindData : public TableFunctionData {
 // ============================================================
 
 struct GfsForecastGlobalState : public GlobalTableFunctionState {
-  Grib2Reader *reader = nullptr;
-  string http_data; // Keep HTTP data alive
-  bool finished = false;
-  idx_t rows_returned = 0;
+  // Downloads forecast hours in the background; scan threads claim them
+  // in order and decode them as they arrive
+  unique_ptr<WeatherFetchPool> pool;
+  std::atomic<idx_t> rows_returned{0};
+  idx_t max_threads = 1;
+
+  // The forecast hours downloaded, one per pool URL: the requested hours
+  // without the skipped ones
+  vector<int32_t> forecast_hours;
+
+  // Projected columns (projection pushdown)
+  vector<column_t> column_ids;
+  bool needs_coordinates = true;
+
+  // Wide mode: the projected value columns, and for each output column its
+  // position in wide_columns (INVALID_INDEX for the fixed columns)
+  vector<GribWideColumn> wide_columns;
+  vector<idx_t> wide_slots;
+
+  // Start of the model run, from the pushed-down run_date and run_hour
+  timestamp_t model_run_at;
+
+  // Progress tracking: a forecast hour is half done once downloaded
+  idx_t total_files = 0;
+  std::atomic<idx_t> completed_files{0};
 
-  // Multi-forecast-hour support
-  idx_t current_fhour_idx = 0;
-  bool current_file_initialized = false;
+  // Series layout: the steps of every forecast hour, emitted by the thread
+  // that adds the last one
+  unique_ptr<GribSeriesBuffer> series;
+  std::atomic<idx_t> series_steps{0};
+  idx_t series_offset = 0;
 
-  // Progress tracking (using fine-grained progress within files)
-  std::atomic<idx_t> total_files{0};
-  std::atomic<idx_t> completed_files{0};
-  std::atomic<int> current_file_progress{0}; // 0-100 within current file
+  shared_ptr<WeatherScanMetrics> metrics;
+
+  idx_t MaxThreads() const override { return max_threads; }
+};
 
-  idx_t MaxThreads() const override { return 1; }
+// ============================================================
+// Local State - one downloaded forecast hour per thread
+// ============================================================
 
-  ~GfsForecastGlobalState() {
-    if (reader) {
-      grib2_close(reader);
-      reader = nullptr;
-    }
-  }
+// No message has been read from a newly opened forecast hour
+static constexpr uint32_t GFS_NO_MESSAGE = 0xffffffff;
 
-  void CloseCurrentReader() {
+struct GfsForecastLocalState : public LocalTableFunctionState {
+  Grib2Reader *reader = nullptr;
+  string http_data; // Borrowed by the decoder until the reader is closed
+  int32_t fhour = 0;
+  // Position of the open forecast hour in forecast_hours; hours are claimed
+  // in order, so this is the batch index that keeps insertion order
+  idx_t batch_index = 0;
+  // Shared with the fetch pool, which counts http_data as buffered
+  shared_ptr<WeatherScanMetrics> metrics;
+  // Message of the last run read, to count messages across batches
+  uint32_t last_message = GFS_NO_MESSAGE;
+  vector<Grib2MessageRun> runs = vector<Grib2MessageRun>(STANDARD_VECTOR_SIZE);
+
+  // Wide mode: zipped messages of the forecast hour and the next row
+  unique_ptr<GribWideReader> wide_reader;
+  idx_t wide_offset = 0;
+  // With h3_resolution: the per-cell rows of the forecast hour
+  GribH3Aggregate h3_aggregate;
+  // Series layout: this thread added the last step and writes the rows
+  bool series_emitter = false;
+
+  ~GfsForecastLocalState() { CloseReader(); }
+
+  void CloseReader() {
+    last_message = GFS_NO_MESSAGE;
+    wide_reader.reset();
+    h3_aggregate.Clear();
     if (reader) {
       grib2_close(reader);
       reader = nullptr;
     }
+    metrics->ReleaseBuffered(http_data.size());
     http_data.clear();
-    current_file_initialized = false;
   }
 };
 
@@ -138,9 +315,26 @@ struct GfsForecastGlobalState : public GlobalTableFunctionState {
 // URL Builder
 // ============================================================
 
+// Filter parameters downloaded when no variable or level is pushed down
+static const vector<string> GFS_DEFAULT_VARIABLES = {"var_TMP", "var_RH",
+                                                     "var_UGRD", "var_VGRD"};
+static const vector<string> GFS_DEFAULT_LEVELS = {
+    "lev_2_m_above_ground", "lev_10_m_above_ground", "lev_surface"};
+
+static const vector<string> &
+GfsRequestedVariables(const vector<string> &variables) {
+  return variables.empty() ? GFS_DEFAULT_VARIABLES : variables;
+}
+
+static const vector<string> &GfsRequestedLevels(const vector<string> &levels) {
+  return levels.empty() ? GFS_DEFAULT_LEVELS : levels;
+}
+
 static string BuildGfsUrl(const GfsForecastBindData &bind_data,
+                          const vector<string> &variables,
+                          const vector<string> &levels,
                           int32_t forecast_hour) {
-  string url = "https://nomads.ncep.noaa.gov/cgi-bin/filter_gfs_0p25.pl?";
+  string url = bind_data.base_url + "/cgi-bin/filter_gfs_0p25.pl?";
 
   // Directory: /gfs.YYYYMMDD/HH/atmos
   string run_hour_str = StringUtil::Format(
@@ -151,24 +345,12 @@ static string BuildGfsUrl(const GfsForecastBindData &bind_data,
   string fhour_str = StringUtil::Format("%03d", forecast_hour);
   url += "&file=gfs.t" + run_hour_str + "z.pgrb2.0p25.f" + fhour_str;
 
-  // Variables
-  if (bind_data.variables.empty()) {
-    // Default variables
-    url += "&var_TMP=on&var_RH=on&var_UGRD=on&var_VGRD=on";
-  } else {
-    for (const auto &var : bind_data.variables) {
-      url += "&" + var + "=on";
-    }
+  // Variables and levels
+  for (const auto &var : GfsRequestedVariables(variables)) {
+    url += "&" + var + "=on";
   }
-
-  // Levels
-  if (bind_data.levels.empty()) {
-    // Default levels
-    url += "&lev_2_m_above_ground=on&lev_10_m_above_ground=on&lev_surface=on";
-  } else {
-    for (const auto &lev : bind_data.levels) {
-      url += "&" + lev + "=on";
-    }
+  for (const auto &lev : GfsRequestedLevels(levels)) {
+    url += "&" + lev + "=on";
   }
 
   // Subregion (bounding box)
@@ -181,53 +363,165 @@ static string BuildGfsUrl(const GfsForecastBindData &bind_data,
   return url;
 }
 
-// ============================================================
-// HTTP Fetch using DuckDB's HTTPUtil
-// ============================================================
-
-static string FetchGribData(ClientContext &context, const string &url) {
-  auto &http_util = HTTPUtil::Get(*context.db);
-  auto params = http_util.InitializeParameters(context, url);
-
-  HTTPHeaders headers;
-  GetRequestInfo get_request(url, headers, *params, nullptr, nullptr);
-
-  auto response = http_util.Request(get_request);
+// The inventory of a forecast hour; NOMADS writes it once the GRIB file is
+// complete, so it doubles as the availability marker
+static string BuildGfsIndexUrl(const string &base_url, const string &run_date,
+                               int32_t run_hour, int32_t forecast_hour) {
+  return base_url +
+         StringUtil::Format("/pub/data/nccf/com/gfs/prod/"
+                            "gfs.%s/%02d/atmos/gfs.t%02dz.pgrb2.0p25.f%03d.idx",
+                            run_date, run_hour, run_hour, forecast_hour);
+}
 
-  if (!response->Success()) {
-    throw IOException("GFS API returned status %d for URL: %s",
-                      static_cast<int32_t>(response->status), url);
+static string GetGfsBaseUrl(ClientContext &context) {
+  Value base_url_val;
+  string base_url = DEFAULT_GFS_BASE_URL;
+  if (context.TryGetCurrentSetting(GFS_BASE_URL_KEY, base_url_val) &&
+      !base_url_val.IsNull()) {
+    base_url = base_url_val.ToString();
   }
-
-  return response->body;
+  while (StringUtil::EndsWith(base_url, "/")) {
+    base_url.pop_back();
+  }
+  return base_url;
 }
 
 // ============================================================
 // Bind Function
 // ============================================================
 
+static LogicalType CreateGfsEnumType(const char *name,
+                                     const vector<string> &values) {
+  Vector vec(LogicalType::VARCHAR, values.size());
+  auto data = FlatVector::GetData<string_t>(vec);
+  for (idx_t i = 0; i < values.size(); i++) {
+    data[i] = StringVector::AddString(vec, values[i]);
+  }
+  return LogicalType::ENUM(name, vec, values.size());
+}
+
 static unique_ptr<FunctionData>
 GfsForecastBind(ClientContext &context, TableFunctionBindInput &input,
                 vector<LogicalType> &return_types, vector<string> &names) {
   auto bind_data = make_uniq<GfsForecastBindData>();
+  bind_data->variable_type =
+      CreateGfsEnumType(GFS_VARIABLE_ENUM, GFS_VARIABLE_VALUES);
+  bind_data->level_type = CreateGfsEnumType(GFS_LEVEL_ENUM, GfsLevelValues());
 
   // Define output schema
-  bind_data->column_names = {"latitude",      "longitude", "value",
-                             "unit",          "variable",  "level",
-                             "forecast_hour", "run_date",  "run_hour"};
+  bind_data->column_names = {"latitude",      "longitude",    "value",
+                             "unit",          "variable",     "level",
+                             "forecast_hour", "run_date",     "run_hour",
+                             "model_run_at",  "valid_at"};
 
   return_types = {
-      LogicalType::DOUBLE,  // latitude
-      LogicalType::DOUBLE,  // longitude
-      LogicalType::DOUBLE,  // value
-      LogicalType::VARCHAR, // unit
-      LogicalType::VARCHAR, // variable
-      LogicalType::VARCHAR, // level
-      LogicalType::INTEGER, // forecast_hour
-      LogicalType::VARCHAR, // run_date
-      LogicalType::INTEGER  // run_hour
+      LogicalType::DOUBLE,       // latitude
+      LogicalType::DOUBLE,       // longitude
+      LogicalType::DOUBLE,       // value
+      LogicalType::VARCHAR,      // unit
+      bind_data->variable_type,  // variable
+      bind_data->level_type,     // level
+      LogicalType::INTEGER,      // forecast_hour
+      LogicalType::VARCHAR,      // run_date
+      LogicalType::INTEGER,      // run_hour
+      LogicalType::TIMESTAMP_TZ, // model_run_at
+      LogicalType::TIMESTAMP_TZ  // valid_at
   };
 
+  for (auto &kv : input.named_parameters) {
+    if (kv.first == "wide") {
+      bind_data->wide = BooleanValue::Get(kv.second);
+    } else if (kv.first == "layout") {
+      auto layout = StringUtil::Lower(kv.second.ToString());
+      if (layout != "long" && layout != "wide" && layout != "series") {
+        throw InvalidInputException("noaa_gfs_forecast_api() layout must be "
+                                    "'long', 'wide' or 'series', got '%s'",
+                                    layout);
+      }
+      bind_data->wide = bind_data->wide || layout != "long";
+      bind_data->series = layout == "series";
+    } else if (kv.first == "forecast_hours") {
+      for (auto &hour : ListValue::GetChildren(kv.second)) {
+        if (hour.IsNull() || hour.GetValue<int32_t>() < 0) {
+          throw InvalidInputException(
+              "noaa_gfs_forecast_api() forecast_hours must be non-negative");
+        }
+        bind_data->forecast_hours.push_back(hour.GetValue<int32_t>());
+      }
+      // Series steps, and their array positions, are in forecast order
+      auto &hours = bind_data->forecast_hours;
+      if (hours.empty()) {
+        throw InvalidInputException(
+            "noaa_gfs_forecast_api() forecast_hours must not be empty");
+      }
+      bind_data->forecast_hours_given = true;
+      std::sort(hours.begin(), hours.end());
+      hours.erase(std::unique(hours.begin(), hours.end()), hours.end());
+    } else if (kv.first == "loaded_hours") {
+      // NULL, as list() gives for a run without rows, is an empty list
+      if (!kv.second.IsNull()) {
+        for (auto &hour : ListValue::GetChildren(kv.second)) {
+          if (!hour.IsNull()) {
+            bind_data->loaded_hours.push_back(hour.GetValue<int32_t>());
+          }
+        }
+      }
+    } else if (kv.first == "skip_unavailable") {
+      bind_data->skip_unavailable = BooleanValue::Get(kv.second);
+    } else if (kv.first == "h3_resolution") {
+      auto resolution = kv.second.GetValue<int32_t>();
+      if (resolution < 0 || resolution > 15) {
+        throw InvalidInputException("noaa_gfs_forecast_api() h3_resolution "
+                                    "must be between 0 and 15, got %d",
+                                    resolution);
+      }
+      bind_data->h3_cells = BindGribH3CellFunction(context, resolution);
+      bind_data->h3_resolution = resolution;
+      bind_data->wide = true;
+    }
+  }
+  if (bind_data->wide) {
+    bind_data->column_names = {"latitude", "longitude",    "forecast_hour",
+                               "run_date", "run_hour",     "model_run_at",
+                               "valid_at"};
+    return_types = {LogicalType::DOUBLE,       LogicalType::DOUBLE,
+                    LogicalType::INTEGER,      LogicalType::VARCHAR,
+                    LogicalType::INTEGER,      LogicalType::TIMESTAMP_TZ,
+                    LogicalType::TIMESTAMP_TZ};
+    if (bind_data->h3_resolution >= 0) {
+      bind_data->column_names[GFS_H3_COL_INDEX] = "h3_index";
+      bind_data->column_names[GFS_H3_COL_POINT_COUNT] = "point_count";
+      return_types[GFS_H3_COL_INDEX] = LogicalType::UBIGINT;
+      return_types[GFS_H3_COL_POINT_COUNT] = LogicalType::UINTEGER;
+    }
+    for (auto &variable : GFS_WIDE_VARIABLES) {
+      bind_data->column_names.push_back(variable.name);
+      return_types.push_back(LogicalType::DOUBLE);
+    }
+  }
+  if (bind_data->series) {
+    // The hours are known here, so every step list is a fixed-size array
+    if (bind_data->forecast_hours.empty()) {
+      throw InvalidInputException("noaa_gfs_forecast_api(layout := 'series') "
+                                  "requires forecast_hours := [...]");
+    }
+    // Every requested hour is an array element, so none can be skipped
+    if (!bind_data->loaded_hours.empty() || bind_data->skip_unavailable) {
+      throw InvalidInputException(
+          "noaa_gfs_forecast_api(layout := 'series') does not support "
+          "loaded_hours or skip_unavailable");
+    }
+    idx_t steps = bind_data->forecast_hours.size();
+    bind_data->column_names[GFS_WIDE_COL_FORECAST_HOUR] = "forecast_hours";
+    return_types[GFS_WIDE_COL_FORECAST_HOUR] =
+        LogicalType::ARRAY(LogicalType::INTEGER, steps);
+    return_types[GFS_WIDE_COL_VALID_AT] =
+        LogicalType::ARRAY(LogicalType::TIMESTAMP_TZ, steps);
+    for (idx_t i = GFS_WIDE_COL_FIRST_VALUE; i < return_types.size(); i++) {
+      return_types[i] = LogicalType::ARRAY(LogicalType::FLOAT, steps);
+    }
+  }
+
   names = bind_data->column_names;
 
   // Set defaults: today's date, run hour 00, forecast hour 0
@@ -237,7 +531,10 @@ GfsForecastBind(ClientContext &context, TableFunctionBindInput &input,
   Date::Convert(date, year, month, day);
   bind_data->run_date = StringUtil::Format("%04d%02d%02d", year, month, day);
   bind_data->run_hour = 0;
-  bind_data->forecast_hours.push_back(0);
+  bind_data->base_url = GetGfsBaseUrl(context);
+  if (bind_data->forecast_hours.empty()) {
+    bind_data->forecast_hours.push_back(0);
+  }
 
   return std::move(bind_data);
 }
@@ -272,6 +569,30 @@ static string NormalizeLevelName(const string &input) {
   return "";
 }
 
+// Name of a filtered column. variable and level compared with strings may
+// be wrapped in a cast to VARCHAR.
+static bool GetFilterColumnName(Expression &expr, string &name) {
+  Expression *target = &expr;
+  if (expr.GetExpressionClass() == ExpressionClass::BOUND_CAST) {
+    auto &cast = expr.Cast<BoundCastExpression>();
+    if (cast.return_type.id() != LogicalTypeId::VARCHAR) {
+      return false;
+    }
+    target = cast.child.get();
+  }
+  if (target->GetExpressionClass() != ExpressionClass::BOUND_COLUMN_REF) {
+    return false;
+  }
+  name = target->Cast<BoundColumnRefExpression>().GetName();
+  return true;
+}
+
+static bool IsStringConstant(const Value &value) {
+  auto type_id = value.type().id();
+  return !value.IsNull() &&
+         (type_id == LogicalTypeId::VARCHAR || type_id == LogicalTypeId::ENUM);
+}
+
 static void GfsForecastPushdownFilter(ClientContext &context, LogicalGet &get,
                                       FunctionData *bind_data_p,
                                       vector<unique_ptr<Expression>> &filters) {
@@ -292,11 +613,9 @@ static void GfsForecastPushdownFilter(ClientContext &context, LogicalGet &get,
     if (filter->GetExpressionClass() == ExpressionClass::BOUND_OPERATOR) {
       auto &op = filter->Cast<BoundOperatorExpression>();
 
-      if (op.children.size() >= 2 && op.children[0]->GetExpressionClass() ==
-                                         ExpressionClass::BOUND_COLUMN_REF) {
-
-        auto &col_ref = op.children[0]->Cast<BoundColumnRefExpression>();
-        string col_name = col_ref.GetName();
+      string col_name;
+      if (op.children.size() >= 2 &&
+          GetFilterColumnName(*op.children[0], col_name)) {
 
         // variable IN ('temperature', 'humidity', ...)
         if (col_name == "variable") {
@@ -307,7 +626,7 @@ static void GfsForecastPushdownFilter(ClientContext &context, LogicalGet &get,
             if (op.children[j]->GetExpressionClass() ==
                 ExpressionClass::BOUND_CONSTANT) {
               auto &constant = op.children[j]->Cast<BoundConstantExpression>();
-              if (constant.value.type().id() == LogicalTypeId::VARCHAR) {
+              if (IsStringConstant(constant.value)) {
                 string var = NormalizeVariableName(constant.value.ToString());
                 if (!var.empty()) {
                   vars.push_back(var);
@@ -335,7 +654,7 @@ static void GfsForecastPushdownFilter(ClientContext &context, LogicalGet &get,
             if (op.children[j]->GetExpressionClass() ==
                 ExpressionClass::BOUND_CONSTANT) {
               auto &constant = op.children[j]->Cast<BoundConstantExpression>();
-              if (constant.value.type().id() == LogicalTypeId::VARCHAR) {
+              if (IsStringConstant(constant.value)) {
                 string lev = NormalizeLevelName(constant.value.ToString());
                 if (!lev.empty()) {
                   levs.push_back(lev);
@@ -355,7 +674,7 @@ static void GfsForecastPushdownFilter(ClientContext &context, LogicalGet &get,
         }
 
         // forecast_hour IN (0, 6, 12, ...)
-        if (col_name == "forecast_hour") {
+        if (col_name == "forecast_hour" && !bind_data.forecast_hours_given) {
           vector<int32_t> hours;
           bool all_valid = true;
 
@@ -385,14 +704,11 @@ static void GfsForecastPushdownFilter(ClientContext &context, LogicalGet &get,
     if (filter->GetExpressionClass() == ExpressionClass::BOUND_COMPARISON) {
       auto &comparison = filter->Cast<BoundComparisonExpression>();
 
-      if (comparison.left->GetExpressionClass() ==
-              ExpressionClass::BOUND_COLUMN_REF &&
+      string col_name;
+      if (GetFilterColumnName(*comparison.left, col_name) &&
           comparison.right->GetExpressionClass() ==
               ExpressionClass::BOUND_CONSTANT) {
-
-        auto &col_ref = comparison.left->Cast<BoundColumnRefExpression>();
         auto &constant = comparison.right->Cast<BoundConstantExpression>();
-        string col_name = col_ref.GetName();
 
         // run_date = '2026-01-20' or run_date = DATE '2026-01-20'
         if (col_name == "run_date" &&
@@ -416,6 +732,32 @@ static void GfsForecastPushdownFilter(ClientContext &context, LogicalGet &get,
           }
         }
 
+        // model_run_at = TIMESTAMPTZ '2026-01-20 06:00:00+00'
+        auto constant_type = constant.value.type().id();
+        if (col_name == "model_run_at" &&
+            filter->type == ExpressionType::COMPARE_EQUAL &&
+            !constant.value.IsNull() &&
+            (constant_type == LogicalTypeId::TIMESTAMP_TZ ||
+             constant_type == LogicalTypeId::TIMESTAMP)) {
+          // Both are stored as microseconds since the epoch in UTC
+          timestamp_t run_at(constant.value.GetValueUnsafe<int64_t>());
+          int32_t year, month, day, hour, minute, second, micros;
+          date_t date;
+          dtime_t time;
+          Timestamp::Convert(run_at, date, time);
+          Date::Convert(date, year, month, day);
+          Time::Convert(time, hour, minute, second, micros);
+          // Only a run start names a run; any other instant stays in the
+          // plan, where it matches no row
+          if (minute == 0 && second == 0 && micros == 0 && hour % 6 == 0) {
+            bind_data.run_date =
+                StringUtil::Format("%04d%02d%02d", year, month, day);
+            bind_data.run_hour = hour;
+            filters_to_remove.push_back(i);
+            continue;
+          }
+        }
+
         // run_hour = 0 (or 6, 12, 18)
         if (col_name == "run_hour" &&
             filter->type == ExpressionType::COMPARE_EQUAL) {
@@ -427,7 +769,7 @@ static void GfsForecastPushdownFilter(ClientContext &context, LogicalGet &get,
         }
 
         // forecast_hour = 24
-        if (col_name == "forecast_hour" &&
+        if (col_name == "forecast_hour" && !bind_data.forecast_hours_given &&
             filter->type == ExpressionType::COMPARE_EQUAL) {
           if (constant.value.type().IsIntegral()) {
             bind_data.forecast_hours.clear();
@@ -441,7 +783,7 @@ static void GfsForecastPushdownFilter(ClientContext &context, LogicalGet &get,
         // variable = 'temperature'
         if (col_name == "variable" &&
             filter->type == ExpressionType::COMPARE_EQUAL) {
-          if (constant.value.type().id() == LogicalTypeId::VARCHAR) {
+          if (IsStringConstant(constant.value)) {
             string var = NormalizeVariableName(constant.value.ToString());
             if (!var.empty()) {
               bind_data.variables.clear();
@@ -455,7 +797,7 @@ static void GfsForecastPushdownFilter(ClientContext &context, LogicalGet &get,
         // level = '2m'
         if (col_name == "level" &&
             filter->type == ExpressionType::COMPARE_EQUAL) {
-          if (constant.value.type().id() == LogicalTypeId::VARCHAR) {
+          if (IsStringConstant(constant.value)) {
             string lev = NormalizeLevelName(constant.value.ToString());
             if (!lev.empty()) {
               bind_data.levels.clear();
@@ -527,299 +869,1015 @@ static double GfsForecastProgress(ClientContext &context,
                                   const FunctionData *bind_data_p,
                                   const GlobalTableFunctionState *gstate_p) {
   auto &gstate = gstate_p->Cast<GfsForecastGlobalState>();
-  idx_t total = gstate.total_files.load();
-  idx_t completed = gstate.completed_files.load();
-  int current_progress = gstate.current_file_progress.load();
-
-  if (total <= 0) {
+  if (gstate.total_files == 0 || !gstate.pool) {
     return -1.0; // Unknown progress
   }
 
-  // Calculate progress including partial progress of current file
-  // Each file contributes (100/total)% to overall progress
-  double per_file = 100.0 / static_cast<double>(total);
-  double base_progress = static_cast<double>(completed) * per_file;
-  double current_file_contribution =
-      (static_cast<double>(current_progress) / 100.0) * per_file;
-
-  return base_progress + current_file_contribution;
+  // Each forecast hour counts half when downloaded and half when decoded
+  double done = static_cast<double>(gstate.pool->Completed()) +
+                static_cast<double>(gstate.completed_files.load());
+  return 100.0 * done / (2.0 * static_cast<double>(gstate.total_files));
 }
 
 // ============================================================
 // Init Global
 // ============================================================
 
+// run_date is YYYYMMDD, either the default or a pushed-down filter
+static bool TryParseRunDate(const string &text, date_t &result) {
+  if (text.size() != 8 ||
+      !std::all_of(text.begin(), text.end(), StringUtil::CharacterIsDigit)) {
+    return false;
+  }
+  int32_t year = std::stoi(text.substr(0, 4));
+  int32_t month = std::stoi(text.substr(4, 2));
+  int32_t day = std::stoi(text.substr(6, 2));
+  if (!Date::IsValid(year, month, day)) {
+    return false;
+  }
+  result = Date::FromDate(year, month, day);
+  return true;
+}
+
+idx_t GetGfsMaxDownloads(ClientContext &context) {
+  idx_t max_downloads = DEFAULT_GFS_MAX_CONCURRENT_DOWNLOADS;
+  Value max_downloads_val;
+  if (context.TryGetCurrentSetting(GFS_MAX_CONCURRENT_DOWNLOADS_KEY,
+                                   max_downloads_val)) {
+    max_downloads = max_downloads_val.GetValue<idx_t>();
+  }
+  if (max_downloads == 0) {
+    throw InvalidInputException("%s must be at least 1",
+                                GFS_MAX_CONCURRENT_DOWNLOADS_KEY);
+  }
+  return max_downloads;
+}
+
+static void RemoveLoadedHours(const vector<int32_t> &loaded_hours,
+                              vector<int32_t> &hours) {
+  std::unordered_set<int32_t> loaded(loaded_hours.begin(),
+                                     loaded_hours.end());
+  hours.erase(std::remove_if(hours.begin(), hours.end(),
+                             [&](int32_t hour) { return loaded.count(hour); }),
+              hours.end());
+}
+
+static void RemoveUnpublishedHours(ClientContext &context,
+                                   const GfsForecastBindData &bind_data,
+                                   idx_t max_probes, vector<int32_t> &hours,
+                                   WeatherScanMetrics *metrics) {
+  vector<string> urls;
+  for (auto fhour : hours) {
+    urls.push_back(BuildGfsIndexUrl(bind_data.base_url, bind_data.run_date,
+                                    bind_data.run_hour, fhour));
+  }
+  auto published = WeatherHttpProbe(context, urls, max_probes, metrics);
+  vector<int32_t> available;
+  for (idx_t i = 0; i < hours.size(); i++) {
+    if (published[i]) {
+      available.push_back(hours[i]);
+    }
+  }
+  hours = std::move(available);
+}
+
 static unique_ptr<GlobalTableFunctionState>
 GfsForecastInitGlobal(ClientContext &context, TableFunctionInitInput &input) {
   auto &bind_data = input.bind_data->Cast<GfsForecastBindData>();
   auto state = make_uniq<GfsForecastGlobalState>();
+  state->metrics = RegisterWeatherScan(context, "noaa_gfs_forecast_api");
+
+  date_t run_date;
+  if (!TryParseRunDate(bind_data.run_date, run_date)) {
+    throw InvalidInputException(
+        "noaa_gfs_forecast_api() run_date must be a YYYYMMDD date, got '%s'",
+        bind_data.run_date);
+  }
+  state->model_run_at = Timestamp::FromDatetime(
+      run_date, dtime_t(bind_data.run_hour * Interval::MICROS_PER_HOUR));
+
+  state->column_ids = input.column_ids;
+  state->needs_coordinates = false;
+  for (auto column_id : state->column_ids) {
+    // H3 cells are looked up by grid index
+    if ((column_id == GFS_COL_LATITUDE || column_id == GFS_COL_LONGITUDE) &&
+        bind_data.h3_resolution < 0) {
+      state->needs_coordinates = true;
+    }
+  }
+
+  idx_t max_downloads = GetGfsMaxDownloads(context);
+
+  state->forecast_hours = bind_data.forecast_hours;
+  RemoveLoadedHours(bind_data.loaded_hours, state->forecast_hours);
+  if (bind_data.skip_unavailable) {
+    RemoveUnpublishedHours(context, bind_data, max_downloads,
+                           state->forecast_hours, state->metrics.get());
+  }
 
   // Set total files for progress tracking
-  state->total_files = bind_data.forecast_hours.size();
+  state->total_files = state->forecast_hours.size();
+  state->max_threads = MaxValue<idx_t>(state->total_files, 1);
+
+  // Wide mode downloads exactly the projected (variable, level) pairs
+  auto variables = bind_data.variables;
+  auto levels = bind_data.levels;
+  if (bind_data.wide) {
+    variables.clear();
+    levels.clear();
+    for (auto column_id : state->column_ids) {
+      idx_t slot = DConstants::INVALID_INDEX;
+      if (column_id >= GFS_WIDE_COL_FIRST_VALUE &&
+          column_id < GFS_WIDE_COL_FIRST_VALUE + GFS_WIDE_VARIABLES.size()) {
+        auto &variable =
+            GFS_WIDE_VARIABLES[column_id - GFS_WIDE_COL_FIRST_VALUE];
+        slot = state->wide_columns.size();
+        state->wide_columns.push_back(variable.column);
+        variables.push_back(variable.api_variable);
+        levels.push_back(variable.api_level);
+      }
+      state->wide_slots.push_back(slot);
+    }
+    // Without projected values the first variable still defines the rows
+    if (state->wide_columns.empty()) {
+      auto &variable = GFS_WIDE_VARIABLES[0];
+      state->wide_columns.push_back(variable.column);
+      variables.push_back(variable.api_variable);
+      levels.push_back(variable.api_level);
+    }
+    std::sort(variables.begin(), variables.end());
+    variables.erase(std::unique(variables.begin(), variables.end()),
+                    variables.end());
+    std::sort(levels.begin(), levels.end());
+    levels.erase(std::unique(levels.begin(), levels.end()), levels.end());
+  }
+  if (bind_data.series) {
+    state->series = make_uniq<GribSeriesBuffer>(state->wide_columns.size());
+  }
+
+  // Start downloading right away so the first hours are ready by the time
+  // the scan threads ask for them
+  vector<string> urls;
+  for (auto fhour : state->forecast_hours) {
+    urls.push_back(BuildGfsUrl(bind_data, variables, levels, fhour));
+  }
+  // Under a LIMIT the first forecast hour almost always has enough rows, so
+  // later hours are fetched one at a time instead of ahead
+  if (bind_data.max_rows > 0) {
+    max_downloads = 1;
+  }
+  state->pool = make_uniq<WeatherFetchPool>(
+      context, std::move(urls), max_downloads, HTTPHeaders(),
+      WeatherCachePolicy::IMMUTABLE, state->metrics);
 
   return std::move(state);
 }
 
+static unique_ptr<LocalTableFunctionState>
+GfsForecastInitLocal(ExecutionContext &context, TableFunctionInitInput &input,
+                     GlobalTableFunctionState *global_state) {
+  auto state = make_uniq<GfsForecastLocalState>();
+  state->metrics = global_state->Cast<GfsForecastGlobalState>().metrics;
+  return std::move(state);
+}
+
 // ============================================================
 // Scan Function
 // ============================================================
 
-// Map GRIB parameter codes to human-readable names
-static string ParameterCodeToName(uint8_t discipline, uint8_t category,
-                                  uint8_t number) {
+// Position of GRIB parameter codes in GFS_VARIABLE_VALUES
+static uint8_t GfsVariableIndex(uint8_t discipline, uint8_t category,
+                                uint8_t number) {
   if (discipline == 0) { // Meteorological
     if (category == 0) { // Temperature
       if (number == 0)
-        return "temperature";
+        return 0;
     }
     if (category == 1) { // Moisture
       if (number == 1)
-        return "humidity";
+        return 1;
       if (number == 8)
-        return "precipitation";
+        return 2;
     }
     if (category == 2) { // Momentum
       if (number == 2)
-        return "wind_u";
+        return 3;
       if (number == 3)
-        return "wind_v";
+        return 4;
       if (number == 22)
-        return "gust";
+        return 5;
     }
     if (category == 3) { // Mass
       if (number == 1)
-        return "pressure";
+        return 6;
     }
     if (category == 6) { // Cloud
       if (number == 1)
-        return "clouds";
+        return 7;
     }
   }
-  return "unknown";
+  return static_cast<uint8_t>(GFS_VARIABLE_VALUES.size() - 1); // unknown
+}
+
+static uint8_t VariableIndexOf(const Grib2MessageRun &run) {
+  return GfsVariableIndex(run.discipline, run.parameter_category,
+                          run.parameter_number);
 }
 
-// Map GRIB surface codes to human-readable names
-static string SurfaceCodeToName(uint8_t code, double value) {
+// Position of a GRIB surface in GfsLevelValues()
+static uint8_t GfsLevelIndex(uint8_t code, double value) {
+  idx_t heights_begin = GFS_FIXED_LEVELS.size();
+  idx_t pressures_begin = heights_begin + GFS_HEIGHT_LEVELS.size();
+  idx_t unknown = pressures_begin + GFS_PRESSURE_LEVELS.size();
+  idx_t index = unknown;
   switch (code) {
   case 1:
-    return "surface";
+    index = 0;
+    break;
   case 10:
-    return "atmosphere";
-  case 100:
-    return StringUtil::Format("%dhPa", static_cast<int>(value / 100));
+    index = 1;
+    break;
   case 101:
-    return "msl";
-  case 103:
-    if (value == 2)
-      return "2m";
-    if (value == 10)
-      return "10m";
-    return StringUtil::Format("%dm", static_cast<int>(value));
+    index = 2;
+    break;
+  case 103: {
+    auto it = std::find(GFS_HEIGHT_LEVELS.begin(), GFS_HEIGHT_LEVELS.end(),
+                        static_cast<int32_t>(std::lround(value)));
+    if (it != GFS_HEIGHT_LEVELS.end()) {
+      index = heights_begin + (it - GFS_HEIGHT_LEVELS.begin());
+    }
+    break;
+  }
+  case 100: {
+    // Isobaric levels are encoded in Pa
+    auto it = std::find(GFS_PRESSURE_LEVELS.begin(),
+                        GFS_PRESSURE_LEVELS.end(),
+                        static_cast<int32_t>(std::lround(value)));
+    if (it != GFS_PRESSURE_LEVELS.end()) {
+      index = pressures_begin + (it - GFS_PRESSURE_LEVELS.begin());
+    }
+    break;
+  }
   default:
-    return "unknown";
+    break;
   }
+  return static_cast<uint8_t>(index);
 }
 
-// Get unit for a variable name (empty string means NULL)
-static string GetVariableUnit(const string &variable) {
-  if (variable == "temperature")
-    return "K";
-  if (variable == "humidity")
-    return "%";
-  if (variable == "wind_u" || variable == "wind_v" || variable == "gust")
-    return "m/s";
-  if (variable == "pressure")
-    return "Pa";
-  if (variable == "clouds")
-    return "%";
-  if (variable == "precipitation")
-    return "kg/m^2";
-  return ""; // Will be converted to NULL
+static uint8_t LevelIndexOf(const Grib2MessageRun &run) {
+  return GfsLevelIndex(run.surface_type, run.surface_value);
 }
 
-static void GfsForecastScan(ClientContext &context, TableFunctionInput &data,
-                            DataChunk &output) {
-  auto &gstate = data.global_state->Cast<GfsForecastGlobalState>();
-  auto &bind_data = data.bind_data->Cast<GfsForecastBindData>();
-
-  if (gstate.finished) {
-    output.SetCardinality(0);
+// Fill an ENUM column per message run: a constant vector when the batch is
+// a single run
+static void FillRunEnum(Vector &vec, const Grib2MessageRun *runs,
+                        idx_t run_count,
+                        uint8_t (*index_of)(const Grib2MessageRun &)) {
+  if (run_count == 1) {
+    vec.SetVectorType(VectorType::CONSTANT_VECTOR);
+    ConstantVector::GetData<uint8_t>(vec)[0] = index_of(runs[0]);
     return;
   }
-
-  // Check LIMIT before fetching more data
-  if (bind_data.max_results > 0 &&
-      gstate.rows_returned >= bind_data.max_results) {
-    gstate.finished = true;
-    output.SetCardinality(0);
-    return;
+  auto data = FlatVector::GetData<uint8_t>(vec);
+  for (idx_t r = 0; r < run_count; r++) {
+    auto &run = runs[r];
+    std::fill(data + run.offset, data + run.offset + run.count,
+              index_of(run));
   }
+}
 
-  // Initialize or move to next forecast hour if needed
-  while (!gstate.current_file_initialized) {
-    if (gstate.current_fhour_idx >= bind_data.forecast_hours.size()) {
-      gstate.finished = true;
-      output.SetCardinality(0);
-      return;
+// Fill the unit column per message run. Units are static strings, so they
+// are inlined or referenced without copying into the vector's heap.
+static void FillRunUnits(Vector &vec, const Grib2MessageRun *runs,
+                         idx_t run_count) {
+  if (run_count == 1) {
+    auto unit = GFS_VARIABLE_UNITS[VariableIndexOf(runs[0])];
+    vec.SetVectorType(VectorType::CONSTANT_VECTOR);
+    if (unit) {
+      ConstantVector::GetData<string_t>(vec)[0] = string_t(unit);
+    } else {
+      ConstantVector::SetNull(vec, true);
     }
-
-    // Reset progress for new file
-    gstate.current_file_progress = 0;
-
-    int32_t fhour = bind_data.forecast_hours[gstate.current_fhour_idx];
-    string url = BuildGfsUrl(bind_data, fhour);
-
-    // Mark 10% - starting HTTP fetch
-    gstate.current_file_progress = 10;
-
-    try {
-      gstate.http_data = FetchGribData(context, url);
-    } catch (const std::exception &e) {
-      throw IOException("Failed to fetch GFS data for fhour %d: %s", fhour,
-                        e.what());
+    return;
+  }
+  auto data = FlatVector::GetData<string_t>(vec);
+  for (idx_t r = 0; r < run_count; r++) {
+    auto &run = runs[r];
+    auto unit = GFS_VARIABLE_UNITS[VariableIndexOf(run)];
+    if (unit) {
+      std::fill(data + run.offset, data + run.offset + run.count,
+                string_t(unit));
+    } else {
+      for (idx_t i = run.offset; i < run.offset + run.count; i++) {
+        FlatVector::SetNull(vec, i, true);
+      }
     }
+  }
+}
 
-    // Mark 40% - HTTP fetch complete, starting GRIB parse
-    gstate.current_file_progress = 40;
+static void SetConstantTimestamp(Vector &vec, timestamp_t value) {
+  vec.SetVectorType(VectorType::CONSTANT_VECTOR);
+  ConstantVector::GetData<timestamp_tz_t>(vec)[0] = timestamp_tz_t(value);
+}
 
-    // Parse GRIB from memory
-    char *error = nullptr;
-    gstate.reader = grib2_open_from_bytes(
-        reinterpret_cast<const uint8_t *>(gstate.http_data.data()),
-        gstate.http_data.size(), &error);
+static timestamp_t GfsValidAt(timestamp_t model_run_at, int32_t fhour) {
+  return timestamp_t(model_run_at.value + fhour * Interval::MICROS_PER_HOUR);
+}
 
-    if (!gstate.reader) {
-      string err_msg = error ? string(error) : "Unknown error";
-      if (error)
-        grib2_free_error(error);
-      throw IOException("Failed to parse GRIB data for fhour %d: %s", fhour,
-                        err_msg);
+// Fill the projected per-message columns of a columnar batch. Variables,
+// levels and units are only resolved once per message run; the per-file
+// columns are constant vectors.
+static void WriteGfsRuns(const Grib2ColumnarBatch &batch,
+                         const Grib2MessageRun *runs,
+                         const GfsForecastBindData &bind_data,
+                         const GfsForecastGlobalState &gstate, int32_t fhour,
+                         DataChunk &output) {
+  auto run_count = batch.run_count;
+  auto &column_ids = gstate.column_ids;
+  for (idx_t i = 0; i < column_ids.size(); i++) {
+    auto &vec = output.data[i];
+    switch (column_ids[i]) {
+    case GFS_COL_LATITUDE:
+    case GFS_COL_LONGITUDE:
+    case GFS_COL_VALUE:
+      // Written by the decoder
+      break;
+    case GFS_COL_UNIT:
+      FillRunUnits(vec, runs, run_count);
+      break;
+    case GFS_COL_VARIABLE:
+      FillRunEnum(vec, runs, run_count, VariableIndexOf);
+      break;
+    case GFS_COL_LEVEL:
+      FillRunEnum(vec, runs, run_count, LevelIndexOf);
+      break;
+    // One file per forecast hour, so these never change within a batch
+    case GFS_COL_FORECAST_HOUR:
+      vec.SetVectorType(VectorType::CONSTANT_VECTOR);
+      ConstantVector::GetData<int32_t>(vec)[0] = fhour;
+      break;
+    case GFS_COL_RUN_DATE:
+      vec.SetVectorType(VectorType::CONSTANT_VECTOR);
+      ConstantVector::GetData<string_t>(vec)[0] =
+          StringVector::AddString(vec, bind_data.run_date);
+      break;
+    case GFS_COL_RUN_HOUR:
+      vec.SetVectorType(VectorType::CONSTANT_VECTOR);
+      ConstantVector::GetData<int32_t>(vec)[0] = bind_data.run_hour;
+      break;
+    case GFS_COL_MODEL_RUN_AT:
+      SetConstantTimestamp(vec, gstate.model_run_at);
+      break;
+    case GFS_COL_VALID_AT:
+      SetConstantTimestamp(vec, GfsValidAt(gstate.model_run_at, fhour));
+      break;
+    default:
+      // Row id or other virtual column
+      vec.SetVectorType(VectorType::CONSTANT_VECTOR);
+      ConstantVector::SetNull(vec, true);
+      break;
     }
+  }
 
-    // Mark 50% - GRIB parsed, ready to read batches
-    gstate.current_file_progress = 50;
+  output.SetCardinality(batch.count);
+}
 
-    gstate.current_file_initialized = true;
+// Claim the next forecast hour, wait for its download and open it; false
+// when every forecast hour has been claimed. Under a LIMIT no hour is
+// claimed once max_rows rows are out: its rows all come after them.
+static bool OpenNextForecastHour(GfsForecastGlobalState &gstate,
+                                 GfsForecastLocalState &lstate,
+                                 const GfsForecastBindData &bind_data) {
+  if (bind_data.max_rows > 0 &&
+      gstate.rows_returned.load() >= bind_data.max_rows) {
+    return false;
+  }
+  WeatherFetchResult result;
+  if (!gstate.pool->NextInOrder(result)) {
+    return false;
+  }
+  lstate.batch_index = result.url_idx;
+  lstate.fhour = gstate.forecast_hours[result.url_idx];
+  if (!result.error.empty()) {
+    throw IOException("Failed to fetch GFS data for fhour %d: %s",
+                      lstate.fhour, result.error);
+  }
+  lstate.http_data = std::move(result.body);
+
+  // Parse GRIB from memory
+  char *error = nullptr;
+  lstate.reader = grib2_open_from_bytes(
+      reinterpret_cast<const uint8_t *>(lstate.http_data.data()),
+      lstate.http_data.size(), &error);
+
+  if (!lstate.reader) {
+    string err_msg = error ? string(error) : "Unknown error";
+    if (error)
+      grib2_free_error(error);
+    throw IOException("Failed to parse GRIB data for fhour %d: %s",
+                      lstate.fhour, err_msg);
   }
 
-  // Get current forecast hour before reading
-  int32_t fhour = bind_data.forecast_hours[gstate.current_fhour_idx];
+  grib2_set_decode_coordinates(lstate.reader, gstate.needs_coordinates);
+  if (bind_data.wide) {
+    // One file per forecast hour: all its messages form one group, which
+    // also keeps accumulations (forecast time = interval start) aligned
+    lstate.wide_reader = make_uniq<GribWideReader>(
+        lstate.reader, gstate.wide_columns, false, gstate.metrics.get());
+    lstate.wide_offset = 0;
+  }
+  return true;
+}
 
-  // Read batch from current file
-  const idx_t BATCH_SIZE = STANDARD_VECTOR_SIZE;
-  Grib2Batch batch = grib2_read_batch(gstate.reader, BATCH_SIZE);
+// Fill the projected columns of wide rows [offset, offset + count) of the
+// current forecast hour, or of its per-cell rows when cells is set
+static void WriteGfsWideRows(const GribWideReader &wide,
+                             const GribH3Aggregate *cells, idx_t offset,
+                             idx_t count, const GfsForecastGlobalState &gstate,
+                             const GfsForecastBindData &bind_data,
+                             int32_t fhour, DataChunk &output) {
+  for (idx_t i = 0; i < gstate.column_ids.size(); i++) {
+    auto &vec = output.data[i];
+    switch (gstate.column_ids[i]) {
+    case GFS_COL_LATITUDE:
+      if (cells) {
+        cells->CopyCells(offset, count, vec);
+      } else {
+        wide.CopyLatitudes(offset, count, vec);
+      }
+      break;
+    case GFS_COL_LONGITUDE:
+      if (cells) {
+        cells->CopyPointCounts(offset, count, vec);
+      } else {
+        wide.CopyLongitudes(offset, count, vec);
+      }
+      break;
+    case GFS_WIDE_COL_FORECAST_HOUR:
+      vec.SetVectorType(VectorType::CONSTANT_VECTOR);
+      ConstantVector::GetData<int32_t>(vec)[0] = fhour;
+      break;
+    case GFS_WIDE_COL_RUN_DATE:
+      vec.SetVectorType(VectorType::CONSTANT_VECTOR);
+      ConstantVector::GetData<string_t>(vec)[0] =
+          StringVector::AddString(vec, bind_data.run_date);
+      break;
+    case GFS_WIDE_COL_RUN_HOUR:
+      vec.SetVectorType(VectorType::CONSTANT_VECTOR);
+      ConstantVector::GetData<int32_t>(vec)[0] = bind_data.run_hour;
+      break;
+    case GFS_WIDE_COL_MODEL_RUN_AT:
+      SetConstantTimestamp(vec, gstate.model_run_at);
+      break;
+    case GFS_WIDE_COL_VALID_AT:
+      SetConstantTimestamp(vec, GfsValidAt(gstate.model_run_at, fhour));
+      break;
+    default:
+      if (gstate.wide_slots[i] == DConstants::INVALID_INDEX) {
+        // Row id or other virtual column
+        vec.SetVectorType(VectorType::CONSTANT_VECTOR);
+        ConstantVector::SetNull(vec, true);
+      } else {
+        if (cells) {
+          cells->CopyValues(gstate.wide_slots[i], offset, count, vec);
+        } else {
+          wide.CopyValues(gstate.wide_slots[i], offset, count, vec);
+        }
+      }
+      break;
+    }
+  }
+  output.SetCardinality(count);
+}
 
-  if (batch.error) {
-    string err_msg(batch.error);
-    grib2_free_batch(batch);
-    throw IOException("GRIB read error: %s", err_msg);
+// Fill the projected columns of series rows [offset, offset + count), one
+// array element per forecast hour
+static void WriteGfsSeriesRows(const GribSeriesBuffer &series, idx_t offset,
+                               idx_t count,
+                               const GfsForecastGlobalState &gstate,
+                               const GfsForecastBindData &bind_data,
+                               DataChunk &output) {
+  bool h3 = bind_data.h3_resolution >= 0;
+  for (idx_t i = 0; i < gstate.column_ids.size(); i++) {
+    auto &vec = output.data[i];
+    switch (gstate.column_ids[i]) {
+    case GFS_COL_LATITUDE:
+      if (h3) {
+        series.CopyCells(offset, count, vec);
+      } else {
+        series.CopyLatitudes(offset, count, vec);
+      }
+      break;
+    case GFS_COL_LONGITUDE:
+      if (h3) {
+        series.CopyPointCounts(offset, count, vec);
+      } else {
+        series.CopyLongitudes(offset, count, vec);
+      }
+      break;
+    case GFS_WIDE_COL_FORECAST_HOUR:
+      series.CopyForecastTimes(count, vec);
+      break;
+    case GFS_WIDE_COL_RUN_DATE:
+      vec.SetVectorType(VectorType::CONSTANT_VECTOR);
+      ConstantVector::GetData<string_t>(vec)[0] =
+          StringVector::AddString(vec, bind_data.run_date);
+      break;
+    case GFS_WIDE_COL_RUN_HOUR:
+      vec.SetVectorType(VectorType::CONSTANT_VECTOR);
+      ConstantVector::GetData<int32_t>(vec)[0] = bind_data.run_hour;
+      break;
+    case GFS_WIDE_COL_MODEL_RUN_AT:
+      SetConstantTimestamp(vec, gstate.model_run_at);
+      break;
+    case GFS_WIDE_COL_VALID_AT:
+      // Steps are keyed by the fNNN hour of their URL, not by the message
+      // headers, so they count hours whatever unit the messages use
+      series.CopyValidTimes(gstate.model_run_at, Interval::MICROS_PER_HOUR,
+                            count, vec);
+      break;
+    default:
+      if (gstate.wide_slots[i] == DConstants::INVALID_INDEX) {
+        vec.SetVectorType(VectorType::CONSTANT_VECTOR);
+        ConstantVector::SetNull(vec, true);
+      } else {
+        series.CopyValues(gstate.wide_slots[i], offset, count, vec);
+      }
+      break;
+    }
   }
+  output.SetCardinality(count);
+}
 
-  // If current file exhausted, move to next forecast hour
-  if (batch.count == 0) {
-    grib2_free_batch(batch);
-    gstate.CloseCurrentReader();
-    gstate.current_fhour_idx++;
-    // Recurse to fetch next file
-    GfsForecastScan(context, data, output);
-    return;
+// Add every group of the open forecast hour as a series step and close it.
+// True when this was the last forecast hour, which makes the caller the
+// thread that writes the rows.
+static bool AddGfsSeriesSteps(ClientContext &context,
+                              GfsForecastGlobalState &gstate,
+                              GfsForecastLocalState &lstate,
+                              const GfsForecastBindData &bind_data) {
+  auto &wide = *lstate.wide_reader;
+  bool h3 = bind_data.h3_resolution >= 0;
+  bool added = false;
+  while (wide.NextGroup()) {
+    if (h3) {
+      lstate.h3_aggregate.Aggregate(context, wide, *bind_data.h3_cells);
+    }
+    gstate.series->AddStep(lstate.fhour, 0, wide,
+                           h3 ? &lstate.h3_aggregate : nullptr);
+    added = true;
   }
+  // Keep the arrays one element per requested hour
+  if (!added) {
+    gstate.series->AddEmptyStep(lstate.fhour, 0);
+  }
+  lstate.CloseReader();
+  gstate.completed_files++;
+  if (++gstate.series_steps < gstate.total_files) {
+    return false;
+  }
+  gstate.series->Finalize();
+  return true;
+}
 
-  for (idx_t i = 0; i < batch.count; i++) {
-    auto &point = batch.data[i];
+static void GfsForecastScan(ClientContext &context, TableFunctionInput &data,
+                            DataChunk &output) {
+  auto &gstate = data.global_state->Cast<GfsForecastGlobalState>();
+  auto &lstate = data.local_state->Cast<GfsForecastLocalState>();
+  auto &bind_data = data.bind_data->Cast<GfsForecastBindData>();
 
-    // Normalize longitude to -180 to 180
-    double lon = point.longitude;
-    if (lon > 180)
-      lon -= 360;
+  while (true) {
+    if (lstate.series_emitter) {
+      auto &series = *gstate.series;
+      idx_t count = MinValue<idx_t>(STANDARD_VECTOR_SIZE,
+                                    series.Size() - gstate.series_offset);
+      WriteGfsSeriesRows(series, gstate.series_offset, count, gstate,
+                         bind_data, output);
+      gstate.series_offset += count;
+      gstate.rows_returned += count;
+      return;
+    }
 
-    string variable = ParameterCodeToName(
-        point.discipline, point.parameter_category, point.parameter_number);
+    if (!lstate.reader && !OpenNextForecastHour(gstate, lstate, bind_data)) {
+      output.SetCardinality(0);
+      return;
+    }
 
-    string unit = GetVariableUnit(variable);
+    if (gstate.series) {
+      lstate.series_emitter =
+          AddGfsSeriesSteps(context, gstate, lstate, bind_data);
+      if (lstate.series_emitter) {
+        lstate.batch_index = gstate.forecast_hours.size();
+      }
+      continue;
+    }
 
-    output.SetValue(0, i, Value(point.latitude));
-    output.SetValue(1, i, Value(lon));
-    output.SetValue(2, i, Value(point.value));
-    output.SetValue(3, i,
-                    unit.empty() ? Value(LogicalType::VARCHAR) : Value(unit));
-    output.SetValue(4, i, Value(variable));
-    output.SetValue(
-        5, i,
-        Value(SurfaceCodeToName(point.surface_type, point.surface_value)));
-    output.SetValue(6, i, Value::INTEGER(fhour));
-    output.SetValue(7, i, Value(bind_data.run_date));
-    output.SetValue(8, i, Value::INTEGER(bind_data.run_hour));
-  }
+    if (lstate.wide_reader) {
+      auto &wide = *lstate.wide_reader;
+      bool h3 = bind_data.h3_resolution >= 0;
+      idx_t size = h3 ? lstate.h3_aggregate.Size() : wide.Size();
+      if (lstate.wide_offset >= size) {
+        lstate.wide_offset = 0;
+        if (!wide.NextGroup()) {
+          lstate.CloseReader();
+          gstate.completed_files++;
+          continue;
+        }
+        if (h3) {
+          lstate.h3_aggregate.Aggregate(context, wide, *bind_data.h3_cells);
+        }
+        continue;
+      }
+      idx_t count =
+          MinValue<idx_t>(STANDARD_VECTOR_SIZE, size - lstate.wide_offset);
+      WriteGfsWideRows(wide, h3 ? &lstate.h3_aggregate : nullptr,
+                       lstate.wide_offset, count, gstate, bind_data,
+                       lstate.fhour, output);
+      lstate.wide_offset += count;
+      gstate.rows_returned += count;
+      return;
+    }
 
-  output.SetCardinality(batch.count);
-  gstate.rows_returned += batch.count;
+    // Read batch from current file
+    const idx_t BATCH_SIZE = STANDARD_VECTOR_SIZE;
+    Grib2ColumnBuffers buffers = {nullptr, nullptr, nullptr, nullptr,
+                                  lstate.runs.data(), lstate.runs.size()};
+    for (idx_t i = 0; i < gstate.column_ids.size(); i++) {
+      switch (gstate.column_ids[i]) {
+      case GFS_COL_LATITUDE:
+        buffers.latitude = FlatVector::GetData<double>(output.data[i]);
+        break;
+      case GFS_COL_LONGITUDE:
+        buffers.longitude = FlatVector::GetData<double>(output.data[i]);
+        break;
+      case GFS_COL_VALUE:
+        buffers.value = FlatVector::GetData<double>(output.data[i]);
+        break;
+      default:
+        break;
+      }
+    }
+    auto &metrics = *gstate.metrics;
+    Grib2ColumnarBatch batch;
+    {
+      WeatherScanTimer timer(&metrics.decode_nanos);
+      batch = grib2_read_batch_columnar(lstate.reader, BATCH_SIZE, &buffers);
+    }
 
-  // Check if current file is done
-  if (!batch.has_more) {
-    gstate.current_file_progress = 100;
-    gstate.CloseCurrentReader();
-    gstate.current_fhour_idx++;
-    gstate.completed_files++;
-  } else {
-    // Increment progress within file (50% to 95% range during batch reads)
-    int current = gstate.current_file_progress.load();
-    if (current < 95) {
-      gstate.current_file_progress = std::min(95, current + 5);
+    if (batch.error) {
+      string err_msg(batch.error);
+      grib2_free_error(batch.error);
+      throw IOException("GRIB read error: %s", err_msg);
+    }
+    metrics.points_decoded += batch.count;
+    for (idx_t r = 0; r < batch.run_count; r++) {
+      if (lstate.runs[r].message_index != lstate.last_message) {
+        lstate.last_message = lstate.runs[r].message_index;
+        metrics.messages_decoded++;
+      }
     }
-  }
 
-  grib2_free_batch(batch);
+    // Current file exhausted, move to the next downloaded forecast hour
+    if (batch.count == 0) {
+      lstate.CloseReader();
+      gstate.completed_files++;
+      continue;
+    }
 
-  // Check LIMIT
-  if (bind_data.max_results > 0 &&
-      gstate.rows_returned >= bind_data.max_results) {
-    gstate.finished = true;
+    WriteGfsRuns(batch, lstate.runs.data(), bind_data, gstate, lstate.fhour,
+                 output);
+    gstate.rows_returned += batch.count;
+
+    if (!batch.has_more) {
+      lstate.CloseReader();
+      gstate.completed_files++;
+    }
+    return;
   }
 }
 
 // ============================================================
-// Cardinality for LIMIT pushdown detection
+// Cardinality and statistics
 // ============================================================
 
-static constexpr idx_t GFS_REPORTED_CARDINALITY = 10000000;
+// Spacing and extent of the pgrb2.0p25 grid
+static constexpr double GFS_GRID_STEP = 0.25;
+static constexpr idx_t GFS_GRID_ROWS = 721;
+static constexpr idx_t GFS_GRID_COLUMNS = 1440;
+
+// Rows and columns of the subregion in the URL, which NOMADS snaps to the
+// grid; without a box it covers the globe
+static void GfsSubregionSize(const GfsForecastBindData &bind_data,
+                             idx_t &rows, idx_t &columns) {
+  double top = static_cast<int>(bind_data.lat_max);
+  double bottom = static_cast<int>(bind_data.lat_min);
+  double left = static_cast<int>(bind_data.lon_min);
+  double right = static_cast<int>(bind_data.lon_max);
+  // A box across the antimeridian has its left edge east of the right one
+  double lon_span = right - left;
+  if (lon_span < 0) {
+    lon_span += 360;
+  }
+  rows = MinValue<idx_t>(
+      GFS_GRID_ROWS,
+      static_cast<idx_t>(MaxValue(0.0, top - bottom) / GFS_GRID_STEP) + 1);
+  columns = MinValue<idx_t>(
+      GFS_GRID_COLUMNS, static_cast<idx_t>(lon_span / GFS_GRID_STEP) + 1);
+}
+
+// Messages per forecast hour of long output: the known (variable, level)
+// pairs among the requested ones, and every requested level of variables
+// without known pairs
+static idx_t GfsMessagesPerHour(const GfsForecastBindData &bind_data) {
+  auto &variables = GfsRequestedVariables(bind_data.variables);
+  auto &levels = GfsRequestedLevels(bind_data.levels);
+  idx_t messages = 0;
+  for (auto &variable : variables) {
+    bool known = false;
+    for (auto &pair : GFS_WIDE_VARIABLES) {
+      if (variable != pair.api_variable) {
+        continue;
+      }
+      known = true;
+      if (std::find(levels.begin(), levels.end(), pair.api_level) !=
+          levels.end()) {
+        messages++;
+      }
+    }
+    messages += known ? 0 : levels.size();
+  }
+  return MaxValue<idx_t>(1, messages);
+}
 
+// Rows from the pushed-down run, hours, variables and box. NOMADS decides
+// which pairs exist and skipped hours are only known once the scan starts,
+// so this is an estimate (bounded only by a LIMIT).
 static unique_ptr<NodeStatistics>
-GfsForecastCardinality(ClientContext &context, const FunctionData *bind_data) {
-  return make_uniq<NodeStatistics>(GFS_REPORTED_CARDINALITY,
-                                   GFS_REPORTED_CARDINALITY);
+GfsForecastCardinality(ClientContext &context,
+                       const FunctionData *bind_data_p) {
+  auto &bind_data = bind_data_p->Cast<GfsForecastBindData>();
+  idx_t rows, columns;
+  GfsSubregionSize(bind_data, rows, columns);
+  idx_t points = rows * columns;
+  if (bind_data.h3_resolution >= 0) {
+    // 2 + 120 * 7^r cells cover the globe
+    double cells = 2.0 + 120.0 * std::pow(7.0, bind_data.h3_resolution);
+    double share = static_cast<double>(points) /
+                   static_cast<double>(GFS_GRID_ROWS * GFS_GRID_COLUMNS);
+    auto in_box = MaxValue<idx_t>(1, static_cast<idx_t>(cells * share));
+    points = MinValue(points, in_box);
+  }
+
+  idx_t estimate = points;
+  if (!bind_data.series) {
+    estimate *= bind_data.forecast_hours.size();
+  }
+  if (!bind_data.wide) {
+    estimate *= GfsMessagesPerHour(bind_data);
+  }
+  if (bind_data.max_rows > 0) {
+    return make_uniq<NodeStatistics>(MinValue(estimate, bind_data.max_rows),
+                                     bind_data.max_rows);
+  }
+  return make_uniq<NodeStatistics>(estimate);
+}
+
+static unique_ptr<BaseStatistics>
+GfsDistinctStatistics(const LogicalType &type, idx_t distinct_count) {
+  auto stats = BaseStatistics::CreateUnknown(type);
+  stats.SetDistinctCount(distinct_count);
+  return stats.ToUnique();
+}
+
+// The forecast hours and run are exact after pushdown (skipped hours only
+// narrow them); coordinates and enums get distinct counts for join ordering
+static unique_ptr<BaseStatistics>
+GfsForecastStatistics(ClientContext &context, const FunctionData *bind_data_p,
+                      column_t column_index) {
+  auto &bind_data = bind_data_p->Cast<GfsForecastBindData>();
+  if (IsVirtualColumn(column_index)) {
+    return nullptr;
+  }
+  bool wide = bind_data.wide;
+  idx_t forecast_hour_column =
+      wide ? GFS_WIDE_COL_FORECAST_HOUR : GFS_COL_FORECAST_HOUR;
+  idx_t run_hour_column = wide ? GFS_WIDE_COL_RUN_HOUR : GFS_COL_RUN_HOUR;
+
+  auto &hours = bind_data.forecast_hours;
+  if (column_index == forecast_hour_column && !bind_data.series &&
+      !hours.empty()) {
+    auto stats = BaseStatistics::CreateUnknown(LogicalType::INTEGER);
+    NumericStats::SetMin(
+        stats, Value::INTEGER(*std::min_element(hours.begin(), hours.end())));
+    NumericStats::SetMax(
+        stats, Value::INTEGER(*std::max_element(hours.begin(), hours.end())));
+    stats.SetDistinctCount(hours.size());
+    return stats.ToUnique();
+  }
+  if (column_index == run_hour_column) {
+    auto stats = BaseStatistics::CreateUnknown(LogicalType::INTEGER);
+    NumericStats::SetMin(stats, Value::INTEGER(bind_data.run_hour));
+    NumericStats::SetMax(stats, Value::INTEGER(bind_data.run_hour));
+    stats.SetDistinctCount(1);
+    return stats.ToUnique();
+  }
+  if (!wide && column_index == GFS_COL_VARIABLE) {
+    return GfsDistinctStatistics(
+        bind_data.variable_type,
+        GfsRequestedVariables(bind_data.variables).size());
+  }
+  if (!wide && column_index == GFS_COL_LEVEL) {
+    return GfsDistinctStatistics(bind_data.level_type,
+                                 GfsRequestedLevels(bind_data.levels).size());
+  }
+  if (bind_data.h3_resolution < 0 && (column_index == GFS_COL_LATITUDE ||
+                                      column_index == GFS_COL_LONGITUDE)) {
+    idx_t rows, columns;
+    GfsSubregionSize(bind_data, rows, columns);
+    return GfsDistinctStatistics(LogicalType::DOUBLE,
+                                 column_index == GFS_COL_LATITUDE ? rows
+                                                                  : columns);
+  }
+  return nullptr;
 }
 
 // ============================================================
-// LIMIT Pushdown Optimizer
+// Run discovery: available_runs(days := 2, forecast_hours := [...])
 // ============================================================
 
-void OptimizeGfsForecastLimitPushdown(unique_ptr<LogicalOperator> &op) {
-  if (op->type == LogicalOperatorType::LOGICAL_LIMIT) {
-    auto &limit = op->Cast<LogicalLimit>();
-    reference<LogicalOperator> child = *op->children[0];
+struct GfsAvailableRunsBindData : public TableFunctionData {
+  string base_url;
+  int32_t days = 2;
+  vector<int32_t> forecast_hours;
+};
 
-    // Skip projection operators
-    while (child.get().type == LogicalOperatorType::LOGICAL_PROJECTION) {
-      child = *child.get().children[0];
-    }
+struct GfsAvailableRun {
+  string run_date;
+  int32_t run_hour = 0;
+  timestamp_t model_run_at;
+  // The leading forecast_hours NOMADS has published
+  idx_t published = 0;
+};
 
-    if (child.get().type == LogicalOperatorType::LOGICAL_GET) {
-      auto &get = child.get().Cast<LogicalGet>();
-      if (get.function.name == "noaa_gfs_forecast_api") {
-        auto &bind_data = get.bind_data->Cast<GfsForecastBindData>();
+struct GfsAvailableRunsGlobalState : public GlobalTableFunctionState {
+  vector<GfsAvailableRun> runs;
+  idx_t run_idx = 0;
+  idx_t hour_idx = 0;
+};
 
-        if (limit.limit_val.Type() == LimitNodeType::CONSTANT_VALUE) {
-          bind_data.max_results = limit.limit_val.GetConstantValue();
+// 0.25 degree output: hourly up to 120 hours, then every 3 hours to 384
+static vector<int32_t> GfsPublishedHours() {
+  vector<int32_t> hours;
+  for (int32_t hour = 0; hour <= 384; hour += hour < 120 ? 1 : 3) {
+    hours.push_back(hour);
+  }
+  return hours;
+}
+
+static unique_ptr<FunctionData>
+GfsAvailableRunsBind(ClientContext &context, TableFunctionBindInput &input,
+                     vector<LogicalType> &return_types, vector<string> &names) {
+  auto bind_data = make_uniq<GfsAvailableRunsBindData>();
+  bind_data->base_url = GetGfsBaseUrl(context);
+  for (auto &kv : input.named_parameters) {
+    if (kv.first == "days") {
+      bind_data->days = kv.second.GetValue<int32_t>();
+      // NOMADS keeps about ten days of runs
+      if (bind_data->days < 1 || bind_data->days > 10) {
+        throw InvalidInputException(
+            "available_runs() days must be between 1 and 10, got %d",
+            bind_data->days);
+      }
+    } else if (kv.first == "forecast_hours") {
+      for (auto &hour : ListValue::GetChildren(kv.second)) {
+        if (hour.IsNull() || hour.GetValue<int32_t>() < 0) {
+          throw InvalidInputException(
+              "available_runs() forecast_hours must be non-negative");
         }
+        bind_data->forecast_hours.push_back(hour.GetValue<int32_t>());
       }
     }
   }
+  auto &hours = bind_data->forecast_hours;
+  if (hours.empty()) {
+    hours = GfsPublishedHours();
+  }
+  std::sort(hours.begin(), hours.end());
+  hours.erase(std::unique(hours.begin(), hours.end()), hours.end());
+
+  names = {"run_date", "run_hour", "model_run_at", "forecast_hour",
+           "valid_at"};
+  return_types = {LogicalType::VARCHAR, LogicalType::INTEGER,
+                  LogicalType::TIMESTAMP_TZ, LogicalType::INTEGER,
+                  LogicalType::TIMESTAMP_TZ};
+  return std::move(bind_data);
+}
 
-  // Recurse
-  for (auto &child : op->children) {
-    OptimizeGfsForecastLimitPushdown(child);
+// A run writes its forecast hours in order, so the published hours are a
+// prefix of forecast_hours. The prefix of every run is found by a binary
+// search over the .idx files, with the probes of all runs sent together in
+// each round.
+static unique_ptr<GlobalTableFunctionState>
+GfsAvailableRunsInitGlobal(ClientContext &context,
+                           TableFunctionInitInput &input) {
+  auto &bind_data = input.bind_data->Cast<GfsAvailableRunsBindData>();
+  auto &hours = bind_data.forecast_hours;
+  auto state = make_uniq<GfsAvailableRunsGlobalState>();
+
+  auto now = Timestamp::GetCurrentTimestamp();
+  auto today = Timestamp::GetDate(now);
+  for (int32_t day = bind_data.days - 1; day >= 0; day--) {
+    auto date = today - day;
+    int32_t year, month, month_day;
+    Date::Convert(date, year, month, month_day);
+    for (int32_t run_hour = 0; run_hour < 24; run_hour += 6) {
+      GfsAvailableRun run;
+      run.run_date =
+          StringUtil::Format("%04d%02d%02d", year, month, month_day);
+      run.run_hour = run_hour;
+      run.model_run_at = Timestamp::FromDatetime(
+          date, dtime_t(run_hour * Interval::MICROS_PER_HOUR));
+      if (run.model_run_at <= now) {
+        state->runs.push_back(run);
+      }
+    }
   }
+
+  // Hours before low are published, hours from high on are not
+  auto &runs = state->runs;
+  vector<idx_t> low(runs.size(), 0);
+  vector<idx_t> high(runs.size(), hours.size());
+  idx_t max_probes = GetGfsMaxDownloads(context);
+  while (true) {
+    vector<string> urls;
+    vector<idx_t> probed;
+    for (idx_t r = 0; r < runs.size(); r++) {
+      if (low[r] < high[r]) {
+        auto middle = low[r] + (high[r] - low[r]) / 2;
+        urls.push_back(BuildGfsIndexUrl(bind_data.base_url, runs[r].run_date,
+                                        runs[r].run_hour, hours[middle]));
+        probed.push_back(r);
+      }
+    }
+    if (urls.empty()) {
+      break;
+    }
+    auto published = WeatherHttpProbe(context, urls, max_probes);
+    for (idx_t i = 0; i < probed.size(); i++) {
+      auto r = probed[i];
+      auto middle = low[r] + (high[r] - low[r]) / 2;
+      if (published[i]) {
+        low[r] = middle + 1;
+      } else {
+        high[r] = middle;
+      }
+    }
+  }
+  for (idx_t r = 0; r < runs.size(); r++) {
+    runs[r].published = low[r];
+  }
+  return std::move(state);
+}
+
+static void GfsAvailableRunsScan(ClientContext &context,
+                                 TableFunctionInput &data, DataChunk &output) {
+  auto &bind_data = data.bind_data->Cast<GfsAvailableRunsBindData>();
+  auto &state = data.global_state->Cast<GfsAvailableRunsGlobalState>();
+  auto run_dates = FlatVector::GetData<string_t>(output.data[0]);
+  auto run_hours = FlatVector::GetData<int32_t>(output.data[1]);
+  auto run_ats = FlatVector::GetData<timestamp_tz_t>(output.data[2]);
+  auto forecast_hours = FlatVector::GetData<int32_t>(output.data[3]);
+  auto valid_ats = FlatVector::GetData<timestamp_tz_t>(output.data[4]);
+
+  idx_t count = 0;
+  while (count < STANDARD_VECTOR_SIZE && state.run_idx < state.runs.size()) {
+    auto &run = state.runs[state.run_idx];
+    if (state.hour_idx >= run.published) {
+      state.run_idx++;
+      state.hour_idx = 0;
+      continue;
+    }
+    auto fhour = bind_data.forecast_hours[state.hour_idx++];
+    run_dates[count] = StringVector::AddString(output.data[0], run.run_date);
+    run_hours[count] = run.run_hour;
+    run_ats[count] = timestamp_tz_t(run.model_run_at);
+    forecast_hours[count] = fhour;
+    valid_ats[count] =
+        timestamp_tz_t(GfsValidAt(run.model_run_at, fhour));
+    count++;
+  }
+  output.SetCardinality(count);
+}
+
+static OperatorPartitionData
+GfsForecastGetPartitionData(ClientContext &context,
+                            TableFunctionGetPartitionInput &input) {
+  if (input.partition_info.RequiresPartitionColumns()) {
+    throw InternalException(
+        "noaa_gfs_forecast_api does not support partition columns");
+  }
+  auto &lstate = input.local_state->Cast<GfsForecastLocalState>();
+  return OperatorPartitionData(lstate.batch_index);
 }
 
 // ============================================================
@@ -827,13 +1885,49 @@ void OptimizeGfsForecastLimitPushdown(unique_ptr<LogicalOperator> &op) {
 // ============================================================
 
 void RegisterGfsForecastFunction(ExtensionLoader &loader) {
+  auto &db = loader.GetDatabaseInstance();
+
+  auto &config = DBConfig::GetConfig(db);
+  config.AddExtensionOption(
+      GFS_MAX_CONCURRENT_DOWNLOADS_KEY,
+      "Maximum number of NOMADS forecast hour downloads, and of "
+      "read_grib_lateral() downloads, in flight at once "
+      "(keep low, NOMADS throttles aggressive clients)",
+      LogicalType::UBIGINT,
+      Value::UBIGINT(DEFAULT_GFS_MAX_CONCURRENT_DOWNLOADS));
+  config.AddExtensionOption(
+      GFS_BASE_URL_KEY,
+      "Base URL of NOMADS (scheme and host), e.g. a mirror or a local mock",
+      LogicalType::VARCHAR, Value(DEFAULT_GFS_BASE_URL));
+
   TableFunction func("noaa_gfs_forecast_api", {}, GfsForecastScan,
-                     GfsForecastBind, GfsForecastInitGlobal);
+                     GfsForecastBind, GfsForecastInitGlobal,
+                     GfsForecastInitLocal);
+  func.projection_pushdown = true;
   func.pushdown_complex_filter = GfsForecastPushdownFilter;
   func.cardinality = GfsForecastCardinality;
+  func.statistics = GfsForecastStatistics;
   func.table_scan_progress = GfsForecastProgress;
+  func.get_partition_data = GfsForecastGetPartitionData;
+  func.dynamic_to_string =
+      WeatherScanDynamicToString<GfsForecastGlobalState>;
+  func.named_parameters["wide"] = LogicalType::BOOLEAN;
+  func.named_parameters["layout"] = LogicalType::VARCHAR;
+  func.named_parameters["forecast_hours"] =
+      LogicalType::LIST(LogicalType::INTEGER);
+  func.named_parameters["h3_resolution"] = LogicalType::INTEGER;
+  func.named_parameters["loaded_hours"] =
+      LogicalType::LIST(LogicalType::INTEGER);
+  func.named_parameters["skip_unavailable"] = LogicalType::BOOLEAN;
 
   loader.RegisterFunction(func);
+
+  TableFunction runs_func("available_runs", {}, GfsAvailableRunsScan,
+                          GfsAvailableRunsBind, GfsAvailableRunsInitGlobal);
+  runs_func.named_parameters["days"] = LogicalType::INTEGER;
+  runs_func.named_parameters["forecast_hours"] =
+      LogicalType::LIST(LogicalType::INTEGER);
+  loader.RegisterFunction(runs_func);
 }
 
 } // namespace duckdb
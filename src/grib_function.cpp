@@ -1,14 +1,51 @@
 #include "grib_function.hpp"
 #include "duckdb/catalog/catalog.hpp"
+#include "duckdb/catalog/catalog_entry/copy_function_catalog_entry.hpp"
 #include "duckdb/catalog/catalog_entry/type_catalog_entry.hpp"
+#include "duckdb/common/case_insensitive_map.hpp"
 #include "duckdb/common/exception.hpp"
-#include "duckdb/common/http_util.hpp"
+#include "duckdb/common/file_system.hpp"
+#include "duckdb/common/operator/comparison_operators.hpp"
 #include "duckdb/common/string_util.hpp"
+#include "duckdb/common/table_column.hpp"
+#include "duckdb/common/types/column/column_data_collection.hpp"
 #include "duckdb/common/types/value.hpp"
+#include "duckdb/execution/expression_executor.hpp"
+#include "duckdb/function/copy_function.hpp"
 #include "duckdb/function/table_function.hpp"
 #include "duckdb/main/client_context.hpp"
 #include "duckdb/main/connection.hpp"
+#include "duckdb/main/extension_helper.hpp"
+#include "duckdb/parallel/task_scheduler.hpp"
+#include "duckdb/parser/parsed_data/copy_info.hpp"
+#include "duckdb/planner/expression/bound_between_expression.hpp"
+#include "duckdb/planner/expression/bound_cast_expression.hpp"
+#include "duckdb/planner/expression/bound_columnref_expression.hpp"
+#include "duckdb/planner/expression/bound_comparison_expression.hpp"
+#include "duckdb/planner/expression/bound_constant_expression.hpp"
+#include "duckdb/planner/expression/bound_operator_expression.hpp"
+#include "duckdb/planner/expression/bound_reference_expression.hpp"
+#include "duckdb/planner/expression_iterator.hpp"
+#include "duckdb/planner/operator/logical_get.hpp"
+#include "duckdb/storage/statistics/base_statistics.hpp"
+#include "duckdb/storage/statistics/numeric_stats.hpp"
+#include "gfs_forecast_function.hpp"
 #include "grib2_ffi.h"
+#include "grib_h3.hpp"
+#include "grib_series.hpp"
+#include "grib_index.hpp"
+#include "grib_wide.hpp"
+#include "weather_limit.hpp"
+#include "weather_http.hpp"
+#include "weather_metrics.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <mutex>
+#include <unordered_map>
+#include <unordered_set>
 
 namespace duckdb {
 
@@ -18,14 +55,18 @@ static bool IsHttpUrl(const string &path) {
          StringUtil::StartsWith(path, "https://");
 }
 
+// Paths the decoder opens itself. HTTP URLs are downloaded through the
+// weather HTTP layer; s3://, gs:// and other extension file systems are read
+// through DuckDB's file system, so that their credentials apply.
+static bool IsLocalPath(const string &path) {
+  return !IsHttpUrl(path) && !FileSystem::IsRemoteFile(path);
+}
+
 // ENUM type names
 static const char *DISCIPLINE_ENUM = "grib_discipline";
 static const char *SURFACE_ENUM = "grib_surface";
 static const char *PARAMETER_ENUM = "grib_parameter";
 
-// High cardinality for LIMIT pushdown detection
-static constexpr idx_t GRIB_REPORTED_CARDINALITY = 100000000;
-
 // Discipline enum values
 static const vector<string> DISCIPLINE_VALUES = {
     "Meteorological", "Hydrological",  "Land_Surface", "Satellite",
@@ -111,14 +152,123 @@ static const vector<string> PARAMETER_VALUES = {"Temperature",
                                                 "Sea_Temp",
                                                 "Unknown"};
 
+// Output column positions of read_grib()
+static constexpr idx_t GRIB_COL_LATITUDE = 0;
+static constexpr idx_t GRIB_COL_LONGITUDE = 1;
+static constexpr idx_t GRIB_COL_VALUE = 2;
+static constexpr idx_t GRIB_COL_DISCIPLINE = 3;
+static constexpr idx_t GRIB_COL_SURFACE = 4;
+static constexpr idx_t GRIB_COL_PARAMETER = 5;
+static constexpr idx_t GRIB_COL_FORECAST_TIME = 6;
+static constexpr idx_t GRIB_COL_SURFACE_VALUE = 7;
+static constexpr idx_t GRIB_COL_MESSAGE_INDEX = 8;
+static constexpr idx_t GRIB_COL_FILE_INDEX = 9;
+static constexpr idx_t GRIB_COL_GRID_INDEX = 10;
+
+// latitude and longitude, leading both layouts; coords := 'index' drops them
+static constexpr idx_t GRIB_COORDINATE_COLUMNS = 2;
+// grid_index of the long layout, a virtual column unless coords := 'index'
+static const column_t GRIB_VIRTUAL_COL_GRID_INDEX = VIRTUAL_COLUMN_START;
+
+// Output column positions of read_grib(wide := true); coordinates keep their
+// positions, one value column per (parameter, level) follows the fixed ones
+static constexpr idx_t GRIB_WIDE_COL_FORECAST_TIME = 2;
+static constexpr idx_t GRIB_WIDE_COL_FILE_INDEX = 3;
+static constexpr idx_t GRIB_WIDE_COL_GRID_INDEX = 4;
+static constexpr idx_t GRIB_WIDE_COL_FIRST_VALUE = 5;
+
+// Output column positions with h3_resolution: wide output averaged per H3
+// cell, with the same forecast_time and file_index positions
+static constexpr idx_t GRIB_H3_COL_INDEX = 0;
+static constexpr idx_t GRIB_H3_COL_POINT_COUNT = 1;
+static constexpr idx_t GRIB_H3_COL_FIRST_VALUE = 4;
+
+// A pushed-down predicate on a column that is constant per GRIB message.
+// Enum columns compare by enum index, numeric columns by value.
+struct GribMessageFilter {
+  idx_t column;
+  ExpressionType comparison; // COMPARE_* or COMPARE_IN
+  vector<double> constants;  // One constant, or the IN list
+};
+
+// Headers of one source read for the optimizer: decoded section 1-4 headers
+// of a local file, or only the .idx inventory of a remote one (no grids)
+struct GribStatsSource {
+  vector<GribIndexRecord> records;
+  vector<Grib2GridInfo> grids; // Per record, empty for inventories
+};
+
+// Sources inspected when the optimizer first asks, once per bind. complete
+// when every source was decoded, so that column ranges are exact.
+struct GribHeaderSummary {
+  vector<GribStatsSource> sources;
+  bool complete = true;
+};
+
 // Bind data - stores file paths and ENUM types
-struct GribBindData : public TableFunctionData {
+struct GribBindData : public WeatherLimitBindData {
   vector<string> file_paths; // Support multiple paths
+  // Positions in file_paths left to scan after partition and forecast hour
+  // pruning; file_index keeps referring to file_paths
+  vector<idx_t> scan_files;
+
+  // hive_partitioning := true: a column per key of the key=value
+  // directories, appended to the schema at partition_column_start (a
+  // position in the full schema), with the values of every file
+  vector<string> partition_names;
+  vector<LogicalType> partition_types;
+  vector<vector<Value>> partition_values;
+  idx_t partition_column_start = 0;
+
+  // Message-level filters evaluated against section 0/4 headers
+  vector<GribMessageFilter> message_filters;
+
+  // Inclusive spatial window from latitude/longitude filters; the filters
+  // themselves stay in the plan
+  bool has_bbox = false;
+  double lat_min = -90.0;
+  double lat_max = 90.0;
+  double lon_min = -180.0;
+  double lon_max = 180.0;
+
+  // Never mix rows of two messages in one output chunk, so that row groups
+  // written by COPY can line up with messages
+  bool split_messages = false;
+
+  // One row per grid point and forecast time with a column per (parameter,
+  // level) found in the first source
+  bool wide = false;
+  vector<GribWideColumn> wide_columns;
+  // layout := 'series': one wide row per grid point (or cell) over all
+  // sources, with a FLOAT[n] per value column, one element per step. n is
+  // the number of sources times the forecast times of the first one.
+  bool series = false;
+  idx_t series_steps = 0;
+  // Body of a non-local first source, read at bind for the wide schema and
+  // decoded from here by the scan
+  shared_ptr<string> first_source_data;
+
+  // With a resolution (0-15), wide rows are averaged per H3 cell in the
+  // scan; -1 keeps one row per grid point
+  int32_t h3_resolution = -1;
+  shared_ptr<const GribH3CellFunction> h3_cells;
+
+  // value_type := 'float' and coords := 'float' | 'index': FLOAT values and
+  // coordinates, or no latitude/longitude columns at all (grid_index only)
+  bool float_values = false;
+  bool float_coordinates = false;
+  bool index_coordinates = false;
+  // Long layout: grid_index is left out of SELECT * and only produced when
+  // selected by name
+  bool virtual_grid_index = false;
 
   // ENUM type handles
   LogicalType discipline_type;
   LogicalType surface_type;
   LogicalType parameter_type;
+
+  // Read lazily by the cardinality and statistics callbacks
+  mutable shared_ptr<GribHeaderSummary> header_summary;
 };
 
 // Map discipline code to enum index
@@ -358,290 +508,2544 @@ static void CreateEnumTypes(GribBindData &bind_data) {
       LogicalType::ENUM(PARAMETER_ENUM, param_vec, PARAMETER_VALUES.size());
 }
 
-// Helper to open a GRIB file/URL
-static Grib2Reader *OpenGribSource(ClientContext &context, const string &path,
-                                   string &http_data_out) {
-  char *error = nullptr;
-  Grib2Reader *reader = nullptr;
-
-  if (IsHttpUrl(path)) {
-    auto &http_util = HTTPUtil::Get(*context.db);
-    auto params = http_util.InitializeParameters(context, path);
-
-    HTTPHeaders headers;
-    GetRequestInfo get_request(path, headers, *params, nullptr, nullptr);
+// Read the next batch from the decoder straight into the output vectors.
+// The decoder copies coordinates and values into the flat vector buffers of
+// the projected columns and fills `runs` with one entry per message run.
+// FLOAT columns are filled through the *_float buffers.
+static Grib2ColumnarBatch ReadGribColumns(Grib2Reader *reader,
+                                          DataChunk &output,
+                                          const vector<column_t> &column_ids,
+                                          vector<Grib2MessageRun> &runs,
+                                          idx_t max_count) {
+  Grib2ColumnBuffers buffers = {nullptr, nullptr, nullptr, nullptr,
+                                runs.data(), runs.size()};
+  for (idx_t i = 0; i < column_ids.size(); i++) {
+    auto &vec = output.data[i];
+    bool is_float = vec.GetType().id() == LogicalTypeId::FLOAT;
+    switch (column_ids[i]) {
+    case GRIB_COL_LATITUDE:
+      if (is_float) {
+        buffers.latitude_float = FlatVector::GetData<float>(vec);
+      } else {
+        buffers.latitude = FlatVector::GetData<double>(vec);
+      }
+      break;
+    case GRIB_COL_LONGITUDE:
+      if (is_float) {
+        buffers.longitude_float = FlatVector::GetData<float>(vec);
+      } else {
+        buffers.longitude = FlatVector::GetData<double>(vec);
+      }
+      break;
+    case GRIB_COL_VALUE:
+      if (is_float) {
+        buffers.value_float = FlatVector::GetData<float>(vec);
+      } else {
+        buffers.value = FlatVector::GetData<double>(vec);
+      }
+      break;
+    case GRIB_COL_GRID_INDEX:
+      buffers.grid_index = FlatVector::GetData<uint32_t>(vec);
+      break;
+    default:
+      break;
+    }
+  }
 
-    auto response = http_util.Request(get_request);
+  auto batch = grib2_read_batch_columnar(reader, max_count, &buffers);
+  if (batch.error) {
+    string error_msg = batch.error;
+    grib2_free_error(batch.error);
+    throw IOException("Error reading GRIB data: " + error_msg);
+  }
+  return batch;
+}
 
-    if (!response->Success()) {
-      throw IOException("HTTP request failed with status " +
-                        to_string(static_cast<int32_t>(response->status)) +
-                        " for URL: " + path);
+// No message has been read from a newly opened source
+static constexpr uint32_t GRIB_NO_MESSAGE = 0xffffffff;
+
+// ReadGribColumns, adding the decode time, values and messages of the batch
+// to metrics. A message spans consecutive runs, possibly across batches;
+// last_message is the message of the previous run of the same source.
+static Grib2ColumnarBatch
+ReadCountedGribColumns(Grib2Reader *reader, DataChunk &output,
+                       const vector<column_t> &column_ids,
+                       vector<Grib2MessageRun> &runs, idx_t max_count,
+                       WeatherScanMetrics &metrics, uint32_t &last_message) {
+  Grib2ColumnarBatch batch;
+  {
+    WeatherScanTimer timer(&metrics.decode_nanos);
+    batch = ReadGribColumns(reader, output, column_ids, runs, max_count);
+  }
+  metrics.points_decoded += batch.count;
+  for (idx_t r = 0; r < batch.run_count; r++) {
+    if (runs[r].message_index != last_message) {
+      last_message = runs[r].message_index;
+      metrics.messages_decoded++;
     }
+  }
+  return batch;
+}
 
-    http_data_out = response->body;
+// Whether any coordinate column is projected
+static bool NeedsCoordinates(const vector<column_t> &column_ids) {
+  for (auto column_id : column_ids) {
+    if (column_id == GRIB_COL_LATITUDE || column_id == GRIB_COL_LONGITUDE) {
+      return true;
+    }
+  }
+  return false;
+}
 
-    reader = grib2_open_from_bytes(
-        reinterpret_cast<const uint8_t *>(http_data_out.data()),
-        http_data_out.size(), &error);
-  } else {
-    reader = grib2_open_with_error(path.c_str(), &error);
+// Fill a per-message column from the run metadata: a constant vector when
+// the batch is a single run, otherwise one std::fill per run
+template <class T, class FUNC>
+static void FillMessageColumn(Vector &vec, const Grib2MessageRun *runs,
+                              idx_t run_count, FUNC value_of) {
+  if (run_count == 1) {
+    vec.SetVectorType(VectorType::CONSTANT_VECTOR);
+    ConstantVector::GetData<T>(vec)[0] = value_of(runs[0]);
+    return;
+  }
+  auto data = FlatVector::GetData<T>(vec);
+  for (idx_t r = 0; r < run_count; r++) {
+    auto begin = data + runs[r].offset;
+    std::fill(begin, begin + runs[r].count, value_of(runs[r]));
   }
+}
 
-  if (!reader) {
-    string error_msg = error ? error : "Unknown error";
-    if (error)
-      grib2_free_error(error);
-    throw IOException("Failed to open GRIB source: " + error_msg);
+// Fill the projected per-message columns of a columnar batch. Enum columns
+// are stored by their physical uint8_t index.
+static void WriteGribRuns(const Grib2ColumnarBatch &batch,
+                          const Grib2MessageRun *runs, DataChunk &output,
+                          const vector<column_t> &column_ids,
+                          idx_t file_index) {
+  auto run_count = batch.run_count;
+  for (idx_t i = 0; i < column_ids.size(); i++) {
+    auto &vec = output.data[i];
+    switch (column_ids[i]) {
+    case GRIB_COL_LATITUDE:
+    case GRIB_COL_LONGITUDE:
+    case GRIB_COL_VALUE:
+    case GRIB_COL_GRID_INDEX:
+      // Written by the decoder
+      break;
+    case GRIB_COL_DISCIPLINE:
+      FillMessageColumn<uint8_t>(
+          vec, runs, run_count, [](const Grib2MessageRun &run) {
+            return DisciplineToEnumIndex(run.discipline);
+          });
+      break;
+    case GRIB_COL_SURFACE:
+      FillMessageColumn<uint8_t>(
+          vec, runs, run_count, [](const Grib2MessageRun &run) {
+            return SurfaceToEnumIndex(run.surface_type);
+          });
+      break;
+    case GRIB_COL_PARAMETER:
+      FillMessageColumn<uint8_t>(
+          vec, runs, run_count, [](const Grib2MessageRun &run) {
+            return ParameterToEnumIndex(run.discipline,
+                                        run.parameter_category,
+                                        run.parameter_number);
+          });
+      break;
+    case GRIB_COL_FORECAST_TIME:
+      FillMessageColumn<int64_t>(
+          vec, runs, run_count, [](const Grib2MessageRun &run) {
+            return run.forecast_time;
+          });
+      break;
+    case GRIB_COL_SURFACE_VALUE:
+      FillMessageColumn<double>(
+          vec, runs, run_count, [](const Grib2MessageRun &run) {
+            return run.surface_value;
+          });
+      break;
+    case GRIB_COL_MESSAGE_INDEX:
+      FillMessageColumn<uint32_t>(
+          vec, runs, run_count, [](const Grib2MessageRun &run) {
+            return run.message_index;
+          });
+      break;
+    case GRIB_COL_FILE_INDEX:
+      vec.SetVectorType(VectorType::CONSTANT_VECTOR);
+      ConstantVector::GetData<uint32_t>(vec)[0] =
+          static_cast<uint32_t>(file_index);
+      break;
+    default:
+      // Row id or other virtual column
+      vec.SetVectorType(VectorType::CONSTANT_VECTOR);
+      ConstantVector::SetNull(vec, true);
+      break;
+    }
   }
 
-  return reader;
+  output.SetCardinality(batch.count);
 }
 
 // ============================================================================
-// Standard table function (for literal paths and arrays)
+// Message-level filter pushdown
 // ============================================================================
 
-struct GribGlobalState : public GlobalTableFunctionState {
-  Grib2Reader *reader = nullptr;
-  idx_t current_file_idx = 0;
-  idx_t total_points = 0;
-  idx_t rows_returned = 0;
-  idx_t limit_from_query = 0;
-  bool finished = false;
-  string http_data;
-  ClientContext *context_ptr = nullptr;
+static bool IsEnumMessageColumn(idx_t column) {
+  return column == GRIB_COL_DISCIPLINE || column == GRIB_COL_SURFACE ||
+         column == GRIB_COL_PARAMETER;
+}
 
-  ~GribGlobalState() {
-    if (reader) {
-      grib2_close(reader);
+// Resolve a filter operand to a message-level column. Enum columns may be
+// wrapped in a cast to VARCHAR, which keeps equality semantics.
+static bool GetMessageColumn(Expression &expr, idx_t &column) {
+  Expression *target = &expr;
+  bool casted = false;
+  if (expr.GetExpressionClass() == ExpressionClass::BOUND_CAST) {
+    auto &cast = expr.Cast<BoundCastExpression>();
+    if (cast.return_type.id() != LogicalTypeId::VARCHAR) {
+      return false;
     }
+    target = cast.child.get();
+    casted = true;
+  }
+  if (target->GetExpressionClass() != ExpressionClass::BOUND_COLUMN_REF) {
+    return false;
   }
 
-  idx_t MaxThreads() const override { return 1; }
+  static const std::unordered_map<string, idx_t> MESSAGE_COLUMNS = {
+      {"discipline", GRIB_COL_DISCIPLINE},
+      {"surface", GRIB_COL_SURFACE},
+      {"parameter", GRIB_COL_PARAMETER},
+      {"forecast_time", GRIB_COL_FORECAST_TIME},
+      {"surface_value", GRIB_COL_SURFACE_VALUE},
+      {"message_index", GRIB_COL_MESSAGE_INDEX}};
+
+  auto it = MESSAGE_COLUMNS.find(
+      target->Cast<BoundColumnRefExpression>().GetName());
+  if (it == MESSAGE_COLUMNS.end()) {
+    return false;
+  }
+  if (casted && !IsEnumMessageColumn(it->second)) {
+    return false;
+  }
+  column = it->second;
+  return true;
+}
 
-  bool OpenFile(const string &path) {
-    if (reader) {
-      grib2_close(reader);
-      reader = nullptr;
+// Enum constants are matched by name; unknown names get index -1, which
+// never matches any message
+static bool EnumConstantIndex(const vector<string> &values, const Value &value,
+                              double &result) {
+  auto type_id = value.type().id();
+  if (type_id != LogicalTypeId::ENUM && type_id != LogicalTypeId::VARCHAR) {
+    return false;
+  }
+  auto it = std::find(values.begin(), values.end(), value.ToString());
+  result = it == values.end() ? -1.0
+                              : static_cast<double>(it - values.begin());
+  return true;
+}
+
+static bool ConvertFilterConstant(idx_t column, const Value &value,
+                                  double &result) {
+  if (value.IsNull()) {
+    return false;
+  }
+  switch (column) {
+  case GRIB_COL_DISCIPLINE:
+    return EnumConstantIndex(DISCIPLINE_VALUES, value, result);
+  case GRIB_COL_SURFACE:
+    return EnumConstantIndex(SURFACE_VALUES, value, result);
+  case GRIB_COL_PARAMETER:
+    return EnumConstantIndex(PARAMETER_VALUES, value, result);
+  default:
+    if (!value.type().IsNumeric()) {
+      return false;
     }
-    http_data.clear();
-    reader = OpenGribSource(*context_ptr, path, http_data);
-    total_points += grib2_total_points(reader);
+    result = value.GetValue<double>();
     return true;
   }
-};
-
-struct GribLocalState : public LocalTableFunctionState {};
-
-// Bind function - accepts VARCHAR or LIST(VARCHAR)
-static unique_ptr<FunctionData> GribBind(ClientContext &context,
-                                         TableFunctionBindInput &input,
-                                         vector<LogicalType> &return_types,
-                                         vector<string> &names) {
-  auto bind_data = make_uniq<GribBindData>();
+}
 
-  if (input.inputs.empty()) {
-    throw InvalidInputException(
-        "read_grib() requires a file path or array of paths");
+static bool TryConvertMessageFilter(Expression &filter,
+                                    GribMessageFilter &result) {
+  // column IN (c1, c2, ...)
+  if (filter.GetExpressionClass() == ExpressionClass::BOUND_OPERATOR) {
+    auto &op = filter.Cast<BoundOperatorExpression>();
+    if (filter.type != ExpressionType::COMPARE_IN || op.children.size() < 2 ||
+        !GetMessageColumn(*op.children[0], result.column)) {
+      return false;
+    }
+    result.comparison = ExpressionType::COMPARE_IN;
+    for (idx_t j = 1; j < op.children.size(); j++) {
+      if (op.children[j]->GetExpressionClass() !=
+          ExpressionClass::BOUND_CONSTANT) {
+        return false;
+      }
+      double constant;
+      auto &value = op.children[j]->Cast<BoundConstantExpression>().value;
+      if (!ConvertFilterConstant(result.column, value, constant)) {
+        return false;
+      }
+      result.constants.push_back(constant);
+    }
+    return true;
   }
 
-  auto &arg = input.inputs[0];
-  auto arg_type = arg.type().id();
+  // column <op> constant (or constant <op> column)
+  if (filter.GetExpressionClass() == ExpressionClass::BOUND_COMPARISON) {
+    auto &comparison = filter.Cast<BoundComparisonExpression>();
+    auto comparison_type = filter.type;
+    Expression *column_expr = comparison.left.get();
+    Expression *constant_expr = comparison.right.get();
+    if (column_expr->GetExpressionClass() == ExpressionClass::BOUND_CONSTANT) {
+      std::swap(column_expr, constant_expr);
+      comparison_type = FlipComparisonExpression(comparison_type);
+    }
+    if (constant_expr->GetExpressionClass() !=
+            ExpressionClass::BOUND_CONSTANT ||
+        !GetMessageColumn(*column_expr, result.column)) {
+      return false;
+    }
 
-  if (arg_type == LogicalTypeId::VARCHAR) {
-    bind_data->file_paths.push_back(arg.GetValue<string>());
-  } else if (arg_type == LogicalTypeId::LIST) {
-    auto &list_children = ListValue::GetChildren(arg);
-    if (list_children.empty()) {
-      throw InvalidInputException("read_grib() array cannot be empty");
+    switch (comparison_type) {
+    case ExpressionType::COMPARE_EQUAL:
+    case ExpressionType::COMPARE_NOTEQUAL:
+      break;
+    case ExpressionType::COMPARE_LESSTHAN:
+    case ExpressionType::COMPARE_LESSTHANOREQUALTO:
+    case ExpressionType::COMPARE_GREATERTHAN:
+    case ExpressionType::COMPARE_GREATERTHANOREQUALTO:
+      // Enum order is an implementation detail, only push equality
+      if (IsEnumMessageColumn(result.column)) {
+        return false;
+      }
+      break;
+    default:
+      return false;
     }
-    for (auto &child : list_children) {
-      bind_data->file_paths.push_back(child.GetValue<string>());
+
+    double constant;
+    auto &value = constant_expr->Cast<BoundConstantExpression>().value;
+    if (!ConvertFilterConstant(result.column, value, constant)) {
+      return false;
     }
+    result.comparison = comparison_type;
+    result.constants.push_back(constant);
+    return true;
+  }
+
+  return false;
+}
+
+// Resolve a latitude/longitude column reference to its column index
+static bool GetCoordinateColumn(Expression &expr, idx_t &column) {
+  if (expr.GetExpressionClass() != ExpressionClass::BOUND_COLUMN_REF) {
+    return false;
+  }
+  auto &name = expr.Cast<BoundColumnRefExpression>().GetName();
+  if (name == "latitude") {
+    column = GRIB_COL_LATITUDE;
+  } else if (name == "longitude") {
+    column = GRIB_COL_LONGITUDE;
   } else {
-    throw InvalidInputException(
-        "read_grib() requires VARCHAR or VARCHAR[] argument");
+    return false;
   }
+  return true;
+}
 
-  CreateEnumTypes(*bind_data);
+static bool GetNumericConstant(Expression &expr, double &result) {
+  if (expr.GetExpressionClass() != ExpressionClass::BOUND_CONSTANT) {
+    return false;
+  }
+  auto &value = expr.Cast<BoundConstantExpression>().value;
+  if (value.IsNull() || !value.type().IsNumeric()) {
+    return false;
+  }
+  result = value.GetValue<double>();
+  return true;
+}
 
-  names = {"latitude",      "longitude", "value",         "discipline",
-           "surface",       "parameter", "forecast_time", "surface_value",
-           "message_index", "file_index"};
+// Narrow one side of the bounding box. Strict comparisons are widened to
+// inclusive ones; the original filter still removes the boundary points.
+static void NarrowBoundingBox(GribBindData &bind_data, idx_t column,
+                              ExpressionType comparison, double constant) {
+  double &lower =
+      column == GRIB_COL_LATITUDE ? bind_data.lat_min : bind_data.lon_min;
+  double &upper =
+      column == GRIB_COL_LATITUDE ? bind_data.lat_max : bind_data.lon_max;
+  // FLOAT coordinates are filtered after rounding, while the box is checked
+  // against the exact grid coordinates: a point up to half a float step past
+  // the constant still matches it, so the box is one step wider
+  double lower_bound = constant;
+  double upper_bound = constant;
+  if (bind_data.float_coordinates) {
+    auto rounded = static_cast<float>(constant);
+    lower_bound =
+        std::nextafter(rounded, -std::numeric_limits<float>::infinity());
+    upper_bound =
+        std::nextafter(rounded, std::numeric_limits<float>::infinity());
+  }
+  switch (comparison) {
+  case ExpressionType::COMPARE_EQUAL:
+    lower = MaxValue(lower, lower_bound);
+    upper = MinValue(upper, upper_bound);
+    break;
+  case ExpressionType::COMPARE_GREATERTHAN:
+  case ExpressionType::COMPARE_GREATERTHANOREQUALTO:
+    lower = MaxValue(lower, lower_bound);
+    break;
+  case ExpressionType::COMPARE_LESSTHAN:
+  case ExpressionType::COMPARE_LESSTHANOREQUALTO:
+    upper = MinValue(upper, upper_bound);
+    break;
+  default:
+    return;
+  }
+  bind_data.has_bbox = true;
+}
 
-  return_types = {LogicalType::DOUBLE,     LogicalType::DOUBLE,
-                  LogicalType::DOUBLE,     bind_data->discipline_type,
-                  bind_data->surface_type, bind_data->parameter_type,
-                  LogicalType::BIGINT,     LogicalType::DOUBLE,
-                  LogicalType::UINTEGER,   LogicalType::UINTEGER};
+// Fold "coordinate <op> constant" and "coordinate BETWEEN a AND b" filters
+// into the bounding box
+static void TryExtractBoundingBox(Expression &filter, GribBindData &bind_data) {
+  idx_t column;
+  if (filter.GetExpressionClass() == ExpressionClass::BOUND_BETWEEN) {
+    auto &between = filter.Cast<BoundBetweenExpression>();
+    double lower, upper;
+    if (GetCoordinateColumn(*between.input, column) &&
+        GetNumericConstant(*between.lower, lower) &&
+        GetNumericConstant(*between.upper, upper)) {
+      NarrowBoundingBox(bind_data, column,
+                        ExpressionType::COMPARE_GREATERTHANOREQUALTO, lower);
+      NarrowBoundingBox(bind_data, column,
+                        ExpressionType::COMPARE_LESSTHANOREQUALTO, upper);
+    }
+    return;
+  }
+  if (filter.GetExpressionClass() != ExpressionClass::BOUND_COMPARISON) {
+    return;
+  }
+  auto &comparison = filter.Cast<BoundComparisonExpression>();
+  auto comparison_type = filter.type;
+  Expression *column_expr = comparison.left.get();
+  Expression *constant_expr = comparison.right.get();
+  if (column_expr->GetExpressionClass() == ExpressionClass::BOUND_CONSTANT) {
+    std::swap(column_expr, constant_expr);
+    comparison_type = FlipComparisonExpression(comparison_type);
+  }
+  double constant;
+  if (GetCoordinateColumn(*column_expr, column) &&
+      GetNumericConstant(*constant_expr, constant)) {
+    NarrowBoundingBox(bind_data, column, comparison_type, constant);
+  }
+}
 
-  return std::move(bind_data);
+// ============================================================================
+// File pruning
+// ============================================================================
+
+// Rewrite references to partition columns as references into a chunk of
+// partition values. False when the expression reads any other column.
+static bool BindPartitionReferences(const GribBindData &bind_data,
+                                    unique_ptr<Expression> &expr,
+                                    idx_t &reference_count) {
+  if (expr->GetExpressionClass() == ExpressionClass::BOUND_COLUMN_REF) {
+    auto &names = bind_data.partition_names;
+    auto it = std::find(names.begin(), names.end(),
+                        expr->Cast<BoundColumnRefExpression>().GetName());
+    if (it == names.end()) {
+      return false;
+    }
+    expr = make_uniq<BoundReferenceExpression>(
+        expr->return_type, static_cast<idx_t>(it - names.begin()));
+    reference_count++;
+    return true;
+  }
+  bool bound = true;
+  ExpressionIterator::EnumerateChildren(
+      *expr, [&](unique_ptr<Expression> &child) {
+        bound = BindPartitionReferences(bind_data, child, reference_count) &&
+                bound;
+      });
+  return bound;
 }
 
-static unique_ptr<NodeStatistics>
-GribCardinality(ClientContext &context, const FunctionData *bind_data) {
-  return make_uniq<NodeStatistics>(GRIB_REPORTED_CARDINALITY,
-                                   GRIB_REPORTED_CARDINALITY);
+// Keep the files whose partition values pass a filter bound by
+// BindPartitionReferences
+static void PruneGribPartitions(ClientContext &context,
+                                GribBindData &bind_data, Expression &filter) {
+  ExpressionExecutor executor(context, filter);
+  DataChunk chunk;
+  chunk.Initialize(Allocator::Get(context), bind_data.partition_types);
+  SelectionVector sel(STANDARD_VECTOR_SIZE);
+  auto &files = bind_data.scan_files;
+  vector<idx_t> kept;
+  for (idx_t offset = 0; offset < files.size();
+       offset += STANDARD_VECTOR_SIZE) {
+    idx_t count =
+        MinValue<idx_t>(STANDARD_VECTOR_SIZE, files.size() - offset);
+    chunk.Reset();
+    for (idx_t row = 0; row < count; row++) {
+      auto &values = bind_data.partition_values[files[offset + row]];
+      for (idx_t col = 0; col < values.size(); col++) {
+        chunk.SetValue(col, row, values[col]);
+      }
+    }
+    chunk.SetCardinality(count);
+    idx_t match_count = executor.SelectExpression(chunk, sel);
+    for (idx_t i = 0; i < match_count; i++) {
+      kept.push_back(files[offset + sel.get_index(i)]);
+    }
+  }
+  files = std::move(kept);
 }
 
-static unique_ptr<GlobalTableFunctionState>
-GribInitGlobal(ClientContext &context, TableFunctionInitInput &input) {
-  auto state = make_uniq<GribGlobalState>();
-  auto &bind_data = input.bind_data->Cast<GribBindData>();
+// Evaluate a partition filter on the files and drop it from the plan; false
+// when it reads a column that is not a partition column
+static bool TryPruneGribPartitions(ClientContext &context,
+                                   GribBindData &bind_data,
+                                   const Expression &filter) {
+  if (bind_data.partition_names.empty() || filter.IsVolatile()) {
+    return false;
+  }
+  auto bound = filter.Copy();
+  idx_t reference_count = 0;
+  if (!BindPartitionReferences(bind_data, bound, reference_count) ||
+      reference_count == 0) {
+    return false;
+  }
+  PruneGribPartitions(context, bind_data, *bound);
+  return true;
+}
 
-  state->context_ptr = &context;
+// Forecast hour in file names known to count hours: GFS and GEFS
+// "gfs.t00z.pgrb2.0p25.f006", HRRR "hrrr.t00z.wrfsfcf06.grib2" and ECMWF open
+// data "20260120000000-6h-oper-fc.grib2". Other names, such as HRRR sub-hourly
+// "wrfsubhf06" files whose forecast_time counts minutes, give no hour.
+static bool ParseFileForecastHour(const string &path, int64_t &hour) {
+  auto name = StringUtil::Lower(path.substr(path.find_last_of('/') + 1));
+  for (auto extension : {".grib2", ".grb2", ".grib", ".grb"}) {
+    if (StringUtil::EndsWith(name, extension)) {
+      name = name.substr(0, name.size() - strlen(extension));
+      break;
+    }
+  }
 
-  if (input.op) {
-    idx_t estimated = input.op->estimated_cardinality;
-    if (estimated > 0 && estimated < GRIB_REPORTED_CARDINALITY) {
-      state->limit_from_query = estimated;
+  // Trailing ".pgrb2*.f006" or "wrfsfcf06"
+  idx_t begin = name.size();
+  while (begin > 0 && StringUtil::CharacterIsDigit(name[begin - 1])) {
+    begin--;
+  }
+  idx_t digits = name.size() - begin;
+  if (digits >= 2 && digits <= 3 && begin > 0 && name[begin - 1] == 'f') {
+    auto prefix = name.substr(0, begin - 1);
+    bool hourly = name.find(".pgrb2") != string::npos &&
+                  StringUtil::EndsWith(prefix, ".");
+    for (auto product : {"wrfsfc", "wrfprs", "wrfnat"}) {
+      hourly = hourly || StringUtil::EndsWith(prefix, product);
     }
+    if (hourly) {
+      hour = std::strtoll(name.c_str() + begin, nullptr, 10);
+      return true;
+    }
+    return false;
   }
 
-  if (!bind_data.file_paths.empty()) {
-    state->OpenFile(bind_data.file_paths[0]);
+  // "<14-digit run time>-6h-"
+  static const idx_t ECMWF_RUN_DIGITS = 14;
+  idx_t run_digits = 0;
+  while (run_digits < name.size() &&
+         StringUtil::CharacterIsDigit(name[run_digits])) {
+    run_digits++;
+  }
+  if (run_digits != ECMWF_RUN_DIGITS || run_digits >= name.size() ||
+      name[run_digits] != '-') {
+    return false;
   }
+  idx_t step_begin = run_digits + 1;
+  idx_t step_end = step_begin;
+  while (step_end < name.size() &&
+         StringUtil::CharacterIsDigit(name[step_end])) {
+    step_end++;
+  }
+  if (step_end == step_begin || name.compare(step_end, 2, "h-") != 0) {
+    return false;
+  }
+  hour = std::strtoll(name.c_str() + step_begin, nullptr, 10);
+  return true;
+}
 
-  return std::move(state);
+// Whether a filter can hold for some value in [low, high]
+static bool FilterMatchesRange(const GribMessageFilter &filter, double low,
+                               double high) {
+  double constant = filter.constants[0];
+  switch (filter.comparison) {
+  case ExpressionType::COMPARE_IN:
+  case ExpressionType::COMPARE_EQUAL:
+    return std::any_of(filter.constants.begin(), filter.constants.end(),
+                       [&](double c) { return c >= low && c <= high; });
+  case ExpressionType::COMPARE_NOTEQUAL:
+    return low != high || low != constant;
+  case ExpressionType::COMPARE_LESSTHAN:
+    return low < constant;
+  case ExpressionType::COMPARE_LESSTHANOREQUALTO:
+    return low <= constant;
+  case ExpressionType::COMPARE_GREATERTHAN:
+    return high > constant;
+  default:
+    return high >= constant;
+  }
 }
 
-static unique_ptr<LocalTableFunctionState>
-GribInitLocal(ExecutionContext &context, TableFunctionInitInput &input,
-              GlobalTableFunctionState *global_state) {
-  return make_uniq<GribLocalState>();
+// Skip files whose name encodes a forecast hour no forecast_time filter can
+// match. Messages of hour h hold forecast_time h, or for accumulations and
+// averages the start of their interval, anything from 0 up to h. Files with
+// any other name are kept and filtered by their message headers.
+static void PruneGribForecastHours(GribBindData &bind_data) {
+  vector<const GribMessageFilter *> time_filters;
+  for (auto &filter : bind_data.message_filters) {
+    if (filter.column == GRIB_COL_FORECAST_TIME) {
+      time_filters.push_back(&filter);
+    }
+  }
+  if (time_filters.empty()) {
+    return;
+  }
+  auto &files = bind_data.scan_files;
+  files.erase(std::remove_if(files.begin(), files.end(),
+                             [&](idx_t file_idx) {
+                               int64_t hour;
+                               if (!ParseFileForecastHour(
+                                       bind_data.file_paths[file_idx], hour)) {
+                                 return false;
+                               }
+                               for (auto filter : time_filters) {
+                                 if (!FilterMatchesRange(
+                                         *filter, 0,
+                                         static_cast<double>(hour))) {
+                                   return true;
+                                 }
+                               }
+                               return false;
+                             }),
+              files.end());
 }
 
-static void GribScan(ClientContext &context, TableFunctionInput &data,
-                     DataChunk &output) {
-  auto &state = data.global_state->Cast<GribGlobalState>();
-  auto &bind_data = data.bind_data->Cast<GribBindData>();
+// Extract filters on per-message columns. They are evaluated exactly against
+// each message header, so they are removed from the plan. Coordinate filters
+// only narrow the decoded window and are kept. Filters on partition columns
+// and forecast hours in file names drop whole files before any is opened.
+// Series arrays have a slot for every forecast time of every file, fixed at
+// bind, so a series scan drops no message or file and its filters stay in
+// the plan.
+static void GribPushdownFilter(ClientContext &context, LogicalGet &get,
+                               FunctionData *bind_data_p,
+                               vector<unique_ptr<Expression>> &filters) {
+  auto &bind_data = bind_data_p->Cast<GribBindData>();
+  idx_t file_count = bind_data.scan_files.size();
 
-  if (state.finished) {
-    output.SetCardinality(0);
-    return;
+  vector<idx_t> filters_to_remove;
+  for (idx_t i = 0; i < filters.size(); i++) {
+    if (TryPruneGribPartitions(context, bind_data, *filters[i])) {
+      filters_to_remove.push_back(i);
+      continue;
+    }
+    GribMessageFilter message_filter;
+    if (!bind_data.series &&
+        TryConvertMessageFilter(*filters[i], message_filter)) {
+      bind_data.message_filters.push_back(std::move(message_filter));
+      filters_to_remove.push_back(i);
+      continue;
+    }
+    TryExtractBoundingBox(*filters[i], bind_data);
   }
 
-  idx_t effective_limit = GRIB_REPORTED_CARDINALITY;
-  if (state.limit_from_query > 0) {
-    effective_limit = state.limit_from_query;
+  // Remove handled filters (reverse order)
+  for (auto it = filters_to_remove.rbegin(); it != filters_to_remove.rend();
+       ++it) {
+    filters.erase(filters.begin() + *it);
   }
 
-  if (state.rows_returned >= effective_limit) {
-    state.finished = true;
-    output.SetCardinality(0);
-    return;
+  PruneGribForecastHours(bind_data);
+  if (bind_data.scan_files.size() != file_count) {
+    // Summarized before pruning, e.g. for a statistics lookup at bind time
+    bind_data.header_summary.reset();
   }
+}
 
-  idx_t remaining = effective_limit - state.rows_returned;
-  idx_t batch_size = std::min(remaining, (idx_t)STANDARD_VECTOR_SIZE);
+static double MessageColumnValue(idx_t column, const Grib2MessageInfo &info) {
+  switch (column) {
+  case GRIB_COL_DISCIPLINE:
+    return DisciplineToEnumIndex(info.discipline);
+  case GRIB_COL_SURFACE:
+    return SurfaceToEnumIndex(info.surface_type);
+  case GRIB_COL_PARAMETER:
+    return ParameterToEnumIndex(info.discipline, info.parameter_category,
+                                info.parameter_number);
+  case GRIB_COL_FORECAST_TIME:
+    return static_cast<double>(info.forecast_time);
+  case GRIB_COL_SURFACE_VALUE:
+    return info.surface_value;
+  default:
+    return static_cast<double>(info.message_index);
+  }
+}
 
-  Grib2Batch batch = grib2_read_batch(state.reader, batch_size);
+// Compared with DuckDB's operators, so that NaN surface values (surface, mean
+// sea level, entire atmosphere) equal NaN and sort above every number, as
+// they do when the filter runs in the plan
+static bool FilterMatches(const GribMessageFilter &filter, double value) {
+  double constant = filter.constants[0];
+  switch (filter.comparison) {
+  case ExpressionType::COMPARE_IN:
+    return std::any_of(
+        filter.constants.begin(), filter.constants.end(),
+        [&](double c) { return Equals::Operation<double>(value, c); });
+  case ExpressionType::COMPARE_EQUAL:
+    return Equals::Operation<double>(value, constant);
+  case ExpressionType::COMPARE_NOTEQUAL:
+    return NotEquals::Operation<double>(value, constant);
+  case ExpressionType::COMPARE_LESSTHAN:
+    return LessThan::Operation<double>(value, constant);
+  case ExpressionType::COMPARE_LESSTHANOREQUALTO:
+    return LessThanEquals::Operation<double>(value, constant);
+  case ExpressionType::COMPARE_GREATERTHAN:
+    return GreaterThan::Operation<double>(value, constant);
+  default:
+    return GreaterThanEquals::Operation<double>(value, constant);
+  }
+}
 
-  if (batch.error) {
-    string error_msg = batch.error;
-    grib2_free_batch(batch);
-    throw IOException("Error reading GRIB data: " + error_msg);
+static bool MessageMatchesFilters(const vector<GribMessageFilter> &filters,
+                                  const Grib2MessageInfo &info) {
+  for (auto &filter : filters) {
+    if (!FilterMatches(filter, MessageColumnValue(filter.column, info))) {
+      return false;
+    }
   }
+  return true;
+}
 
-  while (batch.count == 0) {
-    grib2_free_batch(batch);
-    state.current_file_idx++;
-    if (state.current_file_idx >= bind_data.file_paths.size()) {
-      state.finished = true;
-      output.SetCardinality(0);
-      return;
+// Evaluate filters against a .idx record. Columns the inventory text did not
+// identify are assumed to match; the message header decides exactly later.
+static bool IndexRecordMatchesFilters(const vector<GribMessageFilter> &filters,
+                                      const GribIndexRecord &record) {
+  for (auto &filter : filters) {
+    bool known;
+    switch (filter.column) {
+    case GRIB_COL_DISCIPLINE:
+    case GRIB_COL_PARAMETER:
+      known = record.parameter_known;
+      break;
+    case GRIB_COL_SURFACE:
+      known = record.surface_known;
+      break;
+    case GRIB_COL_SURFACE_VALUE:
+      known = record.surface_value_known;
+      break;
+    case GRIB_COL_FORECAST_TIME:
+      known = record.forecast_time_known;
+      break;
+    default:
+      known = true;
+      break;
     }
-    state.OpenFile(bind_data.file_paths[state.current_file_idx]);
-    batch = grib2_read_batch(state.reader, batch_size);
-    if (batch.error) {
-      string error_msg = batch.error;
-      grib2_free_batch(batch);
-      throw IOException("Error reading GRIB data: " + error_msg);
+    if (!known) {
+      continue;
+    }
+    double value = MessageColumnValue(filter.column, record.info);
+    if (!FilterMatches(filter, value)) {
+      return false;
     }
   }
+  return true;
+}
 
-  idx_t current_file = state.current_file_idx;
-  for (idx_t i = 0; i < batch.count; i++) {
-    auto &point = batch.data[i];
-    output.SetValue(0, i, Value::DOUBLE(point.latitude));
-    output.SetValue(1, i, Value::DOUBLE(point.longitude));
-    output.SetValue(2, i, Value::DOUBLE(point.value));
-
-    auto disc_idx = DisciplineToEnumIndex(point.discipline);
-    output.SetValue(3, i,
-                    Value(DISCIPLINE_VALUES[disc_idx])
-                        .DefaultCastAs(bind_data.discipline_type));
+// Drop messages that cannot match the pushed-down filters before any of
+// them is unpacked
+static void ApplyMessageFilters(Grib2Reader *reader,
+                                const vector<GribMessageFilter> &filters,
+                                WeatherScanMetrics *metrics = nullptr) {
+  if (filters.empty()) {
+    return;
+  }
+  idx_t message_count = grib2_message_count(reader);
+  vector<uint8_t> keep(message_count, 0);
+  for (idx_t i = 0; i < message_count; i++) {
+    Grib2MessageInfo info;
+    if (grib2_message_info(reader, i, &info)) {
+      keep[i] = MessageMatchesFilters(filters, info) ? 1 : 0;
+    }
+    if (metrics && !keep[i]) {
+      metrics->messages_skipped++;
+    }
+  }
+  grib2_select_messages(reader, keep.data(), keep.size());
+}
 
-    auto surf_idx = SurfaceToEnumIndex(point.surface_type);
-    output.SetValue(
-        4, i,
-        Value(SURFACE_VALUES[surf_idx]).DefaultCastAs(bind_data.surface_type));
+// Messages closer than this are fetched with a single range request
+static constexpr idx_t GRIB_INDEX_MAX_GAP = 256 * 1024;
+
+// Byte ranges of the messages in an inventory that can match the filters,
+// and the number of messages left out of them. Returns false when the text
+// is not a usable inventory.
+static bool SelectIndexedRanges(const string &index_text,
+                                const vector<GribMessageFilter> &filters,
+                                vector<GribByteRange> &ranges,
+                                idx_t &skipped) {
+  vector<GribIndexRecord> records;
+  if (!TryParseGribIndex(index_text, records) || records.empty()) {
+    return false;
+  }
 
-    auto param_idx = ParameterToEnumIndex(
-        point.discipline, point.parameter_category, point.parameter_number);
-    output.SetValue(5, i,
-                    Value(PARAMETER_VALUES[param_idx])
-                        .DefaultCastAs(bind_data.parameter_type));
+  vector<bool> selected;
+  bool any_selected = false;
+  for (auto &record : records) {
+    selected.push_back(IndexRecordMatchesFilters(filters, record));
+    any_selected = any_selected || selected.back();
+  }
+  if (!any_selected) {
+    // The reader needs at least one message; the header filter drops it
+    selected[0] = true;
+  }
+  ranges = CoalesceGribRanges(records, selected, GRIB_INDEX_MAX_GAP);
+  // Messages in the gaps between matches are read and filtered later
+  skipped = records.size();
+  for (auto &range : ranges) {
+    skipped -= range.message_numbers.size();
+  }
+  return true;
+}
 
-    output.SetValue(6, i, Value::BIGINT(point.forecast_time));
-    output.SetValue(7, i, Value::DOUBLE(point.surface_value));
-    output.SetValue(8, i, Value::UINTEGER(point.message_index));
-    output.SetValue(9, i, Value::UINTEGER(static_cast<uint32_t>(current_file)));
+// Fetch only the messages of a remote file that can match the filters, using
+// the "<url>.idx" inventory published next to NOAA GRIB files. Returns false
+// when there is nothing to filter on or no usable inventory.
+static bool TryFetchIndexedMessages(ClientContext &context, const string &url,
+                                    const vector<GribMessageFilter> &filters,
+                                    string &data_out,
+                                    vector<uint32_t> &message_numbers,
+                                    WeatherScanMetrics *metrics) {
+  // CGI endpoints (e.g. NOMADS filter_gfs) have no inventory
+  if (filters.empty() || url.find('?') != string::npos) {
+    return false;
+  }
+  string index_text;
+  vector<GribByteRange> ranges;
+  idx_t skipped = 0;
+  if (!WeatherHttpTryGet(context, url + ".idx", index_text, metrics) ||
+      !SelectIndexedRanges(index_text, filters, ranges, skipped)) {
+    return false;
   }
 
-  output.SetCardinality(batch.count);
-  state.rows_returned += batch.count;
-  grib2_free_batch(batch);
+  vector<std::pair<idx_t, idx_t>> byte_ranges;
+  for (auto &range : ranges) {
+    byte_ranges.emplace_back(range.begin, range.end);
+    message_numbers.insert(message_numbers.end(),
+                           range.message_numbers.begin(),
+                           range.message_numbers.end());
+  }
+  WeatherHttpGetRanges(context, url, byte_ranges, data_out, metrics);
+  if (metrics) {
+    metrics->messages_skipped += skipped;
+  }
+  return true;
 }
 
-static double GribProgress(ClientContext &context,
-                           const FunctionData *bind_data_p,
-                           const GlobalTableFunctionState *gstate_p) {
-  auto &state = gstate_p->Cast<GribGlobalState>();
-  auto &bind_data = bind_data_p->Cast<GribBindData>();
+// Read only the messages of a non-HTTP file that can match the filters, using
+// a "<path>.idx" sidecar (wgrib2 -s output or grib_inventory(write_index :=
+// true)). A sidecar older than the file, or one whose offsets do not point
+// at messages, is ignored.
+static bool TryReadIndexedMessages(ClientContext &context, const string &path,
+                                   const vector<GribMessageFilter> &filters,
+                                   string &data_out,
+                                   vector<uint32_t> &message_numbers,
+                                   WeatherScanMetrics *metrics) {
+  auto &fs = FileSystem::GetFileSystem(context);
+  auto index_path = path + ".idx";
+  if (filters.empty() || !fs.FileExists(index_path)) {
+    return false;
+  }
 
-  if (state.total_points == 0)
-    return -1.0;
-  double file_progress = static_cast<double>(state.current_file_idx) /
-                         static_cast<double>(bind_data.file_paths.size());
-  return file_progress * 100.0;
+  auto index_handle = fs.OpenFile(index_path, FileFlags::FILE_FLAGS_READ);
+  auto handle = fs.OpenFile(path, FileFlags::FILE_FLAGS_READ);
+  if (fs.GetLastModifiedTime(*index_handle) < fs.GetLastModifiedTime(*handle)) {
+    return false;
+  }
+  string index_text(NumericCast<idx_t>(index_handle->GetFileSize()), '\0');
+  index_handle->Read(&index_text[0], index_text.size(), 0);
+  vector<GribByteRange> ranges;
+  idx_t skipped = 0;
+  if (!SelectIndexedRanges(index_text, filters, ranges, skipped)) {
+    return false;
+  }
+
+  idx_t file_size = NumericCast<idx_t>(handle->GetFileSize());
+  string data;
+  vector<uint32_t> numbers;
+  for (auto &range : ranges) {
+    idx_t end = range.end == 0 ? file_size : range.end;
+    if (end > file_size || range.begin + 4 > end) {
+      return false;
+    }
+    idx_t start = data.size();
+    data.resize(start + end - range.begin);
+    handle->Read(&data[start], end - range.begin, range.begin);
+    if (data.compare(start, 4, "GRIB") != 0) {
+      return false;
+    }
+    numbers.insert(numbers.end(), range.message_numbers.begin(),
+                   range.message_numbers.end());
+  }
+  data_out = std::move(data);
+  message_numbers = std::move(numbers);
+  if (metrics) {
+    metrics->messages_skipped += skipped;
+  }
+  return true;
 }
 
-// ============================================================================
-// In-out table function (for LATERAL joins)
-// ============================================================================
+// Read a whole file through DuckDB's file system (s3://, gs://, ...)
+static void ReadVirtualFile(ClientContext &context, const string &path,
+                            string &data, WeatherScanMetrics *metrics) {
+  auto &fs = FileSystem::GetFileSystem(context);
+  auto handle = fs.OpenFile(path, FileFlags::FILE_FLAGS_READ);
+  data.assign(NumericCast<idx_t>(handle->GetFileSize()), '\0');
+  handle->Read(&data[0], data.size(), 0);
+  if (metrics) {
+    metrics->bytes_downloaded += data.size();
+  }
+}
 
-struct GribInOutGlobalState : public GlobalTableFunctionState {
-  idx_t MaxThreads() const override { return 1; }
-};
+// Open a reader over a downloaded body. The reader borrows the buffer, which
+// must outlive it.
+static Grib2Reader *OpenGribBuffer(const string &data) {
+  char *error = nullptr;
+  auto reader = grib2_open_from_bytes(
+      reinterpret_cast<const uint8_t *>(data.data()), data.size(), &error);
+  if (!reader) {
+    string error_msg = error ? error : "Unknown error";
+    if (error)
+      grib2_free_error(error);
+    throw IOException("Failed to open GRIB source: " + error_msg);
+  }
+  return reader;
+}
 
-struct GribInOutLocalState : public LocalTableFunctionState {
+// Helper to open a GRIB file/URL
+// For local files, [message_begin, message_end) restricts decoding to a
+// submessage range (message_end == 0 means the whole file). Files with an
+// .idx inventory only download or read messages that can match
+// message_filters; buffer_out then holds them (and remote bodies, or files
+// of other file systems) for as long as the reader lives. Downloads and
+// skipped messages are added to metrics when given.
+static Grib2Reader *
+OpenGribSource(ClientContext &context, const string &path, string &buffer_out,
+               idx_t message_begin = 0, idx_t message_end = 0,
+               const vector<GribMessageFilter> *message_filters = nullptr,
+               WeatherScanMetrics *metrics = nullptr) {
+  char *error = nullptr;
   Grib2Reader *reader = nullptr;
-  string http_data;
-  bool initialized = false;
-  ClientContext *context_ptr = nullptr;
-
-  ~GribInOutLocalState() {
-    if (reader) {
-      grib2_close(reader);
+  bool remote = IsHttpUrl(path);
+  bool virtual_file = !remote && !IsLocalPath(path);
+  vector<uint32_t> message_numbers;
+  bool indexed = false;
+
+  if (remote) {
+    indexed = message_filters &&
+              TryFetchIndexedMessages(context, path, *message_filters,
+                                      buffer_out, message_numbers, metrics);
+    if (!indexed) {
+      buffer_out = WeatherHttpGet(context, path, metrics);
     }
+  } else if (message_end == 0 && message_filters) {
+    indexed = TryReadIndexedMessages(context, path, *message_filters,
+                                     buffer_out, message_numbers, metrics);
+  }
+  if (virtual_file && !indexed) {
+    ReadVirtualFile(context, path, buffer_out, metrics);
   }
 
-  void Reset() {
-    if (reader) {
-      grib2_close(reader);
-      reader = nullptr;
+  if (remote || virtual_file || indexed) {
+    // The decoder borrows this buffer until the reader is closed
+    reader = grib2_open_from_bytes(
+        reinterpret_cast<const uint8_t *>(buffer_out.data()),
+        buffer_out.size(), &error);
+    if (reader && indexed) {
+      grib2_renumber_messages(reader, message_numbers.data(),
+                              message_numbers.size());
     }
-    http_data.clear();
-    initialized = false;
+  } else if (message_end > 0) {
+    // Local files are memory-mapped, so a range only touches its own pages
+    reader = grib2_open_range_with_error(path.c_str(), message_begin,
+                                         message_end, &error);
+  } else {
+    reader = grib2_open_with_error(path.c_str(), &error);
   }
-};
+
+  if (!reader) {
+    string error_msg = error ? error : "Unknown error";
+    if (error)
+      grib2_free_error(error);
+    throw IOException("Failed to open GRIB source: " + error_msg);
+  }
+
+  return reader;
+}
+
+// ============================================================================
+// Standard table function (for paths, globs and arrays)
+// ============================================================================
+
+// A unit of scan work handed out to worker threads: a whole file, or a
+// submessage range of a large local file
+struct GribScanTask {
+  idx_t file_idx = 0;
+  idx_t message_begin = 0;
+  idx_t message_end = 0; // Exclusive, 0 = whole file
+};
+
+struct GribGlobalState : public GlobalTableFunctionState {
+  vector<GribScanTask> tasks;
+  std::atomic<idx_t> next_task{0};
+  std::atomic<idx_t> completed_tasks{0};
+  std::atomic<idx_t> rows_returned{0};
+  idx_t max_threads = 1;
+
+  // Projected columns (projection pushdown)
+  vector<column_t> column_ids;
+  bool needs_coordinates = true;
+
+  // Wide mode: the projected value columns, and for each output column its
+  // position in wide_columns (INVALID_INDEX for the fixed columns)
+  vector<GribWideColumn> wide_columns;
+  vector<idx_t> wide_slots;
+
+  // Series layout: the groups of every task, emitted by the thread that
+  // finishes the last one
+  unique_ptr<GribSeriesBuffer> series;
+  std::atomic<idx_t> series_tasks{0};
+  idx_t series_offset = 0;
+
+  shared_ptr<WeatherScanMetrics> metrics;
+
+  idx_t MaxThreads() const override { return max_threads; }
+};
+
+struct GribLocalState : public LocalTableFunctionState {
+  Grib2Reader *reader = nullptr;
+  string http_data;
+  idx_t file_idx = 0;
+  ClientContext *context_ptr = nullptr;
+  // Owned by the global state
+  WeatherScanMetrics *metrics = nullptr;
+  uint32_t last_message = GRIB_NO_MESSAGE;
+  vector<Grib2MessageRun> runs =
+      vector<Grib2MessageRun>(STANDARD_VECTOR_SIZE);
+  // Index of the task being read; tasks follow file and message order, so
+  // this is the batch index that keeps insertion order across threads
+  idx_t batch_index = 0;
+  // Rows emitted from the open task, counted against max_rows
+  idx_t task_rows = 0;
+
+  // Wide mode: zipped messages of the open task and the next row to emit
+  unique_ptr<GribWideReader> wide_reader;
+  idx_t wide_offset = 0;
+  // With h3_resolution: the per-cell rows of the current group
+  GribH3Aggregate h3_aggregate;
+  // Series layout: this thread finished the last task and writes the rows
+  bool series_emitter = false;
+
+  ~GribLocalState() { CloseFile(); }
+
+  void CloseFile() {
+    task_rows = 0;
+    last_message = GRIB_NO_MESSAGE;
+    wide_reader.reset();
+    h3_aggregate.Clear();
+    if (reader) {
+      grib2_close(reader);
+      reader = nullptr;
+    }
+    metrics->ReleaseBuffered(http_data.size());
+    http_data.clear();
+  }
+
+  // Under a LIMIT a task emits at most max_rows rows: its later rows can't
+  // be among the first max_rows of the scan
+  idx_t RowBudget(const GribBindData &bind_data) const {
+    if (bind_data.max_rows == 0) {
+      return STANDARD_VECTOR_SIZE;
+    }
+    return MinValue<idx_t>(STANDARD_VECTOR_SIZE,
+                           bind_data.max_rows -
+                               MinValue(task_rows, bind_data.max_rows));
+  }
+
+  // Claim the next task from the global cursor; false when none are left.
+  // Tasks are claimed in order, so once max_rows rows are out every row of
+  // an unclaimed task comes after them.
+  bool OpenNextTask(GribGlobalState &gstate, const GribBindData &bind_data) {
+    CloseFile();
+    if (bind_data.max_rows > 0 &&
+        gstate.rows_returned.load() >= bind_data.max_rows) {
+      return false;
+    }
+    idx_t task_idx = gstate.next_task++;
+    if (task_idx >= gstate.tasks.size()) {
+      return false;
+    }
+    auto &task = gstate.tasks[task_idx];
+    file_idx = task.file_idx;
+    batch_index = task_idx;
+    if (task.file_idx == 0 && bind_data.first_source_data) {
+      // Owned by the bind data, which outlives the reader
+      reader = OpenGribBuffer(*bind_data.first_source_data);
+    } else {
+      reader = OpenGribSource(
+          *context_ptr, bind_data.file_paths[task.file_idx], http_data,
+          task.message_begin, task.message_end, &bind_data.message_filters,
+          metrics);
+      metrics->AddBuffered(http_data.size());
+    }
+    grib2_set_decode_coordinates(reader, gstate.needs_coordinates);
+    if (bind_data.has_bbox) {
+      grib2_set_bbox(reader, bind_data.lat_min, bind_data.lat_max,
+                     bind_data.lon_min, bind_data.lon_max);
+    }
+    ApplyMessageFilters(reader, bind_data.message_filters, metrics);
+    if (bind_data.wide) {
+      wide_reader = make_uniq<GribWideReader>(reader, gstate.wide_columns,
+                                              true, metrics);
+      wide_offset = 0;
+    }
+    return true;
+  }
+};
+
+// Column name of a (parameter, level) pair in wide output, e.g.
+// "temperature_height_above_ground_2" or "pressure_msl_mean_sea_level"
+static string GribWideColumnName(const Grib2MessageInfo &info) {
+  auto parameter = ParameterToEnumIndex(
+      info.discipline, info.parameter_category, info.parameter_number);
+  string name;
+  if (PARAMETER_VALUES[parameter] == "Unknown") {
+    name = StringUtil::Format("param_%d_%d_%d", info.discipline,
+                              info.parameter_category, info.parameter_number);
+  } else {
+    name = StringUtil::Lower(PARAMETER_VALUES[parameter]);
+  }
+
+  auto surface = SurfaceToEnumIndex(info.surface_type);
+  if (SURFACE_VALUES[surface] == "Unknown") {
+    name += StringUtil::Format("_surface_%d", info.surface_type);
+  } else {
+    name += "_" + StringUtil::Lower(SURFACE_VALUES[surface]);
+  }
+
+  auto level = info.surface_value;
+  if (!std::isnan(level) && level != 0) {
+    if (level == std::floor(level)) {
+      name += StringUtil::Format("_%d", static_cast<int64_t>(level));
+    } else {
+      auto text = Value::DOUBLE(level).ToString();
+      std::replace(text.begin(), text.end(), '.', 'p');
+      std::replace(text.begin(), text.end(), '-', 'm');
+      name += "_" + text;
+    }
+  }
+  return name;
+}
+
+// Headers of the first source of a wide scan, from the .idx inventory of a
+// remote file when it identifies every message
+static bool TryReadGribWideInventory(ClientContext &context, const string &url,
+                                     vector<Grib2MessageInfo> &infos) {
+  string index_text;
+  vector<GribIndexRecord> records;
+  if (url.find('?') != string::npos ||
+      !WeatherHttpTryGet(context, url + ".idx", index_text) ||
+      !TryParseGribIndex(index_text, records) || records.empty()) {
+    return false;
+  }
+  for (auto &record : records) {
+    // Levels without a value are NaN, as in the message header
+    bool level_known = record.surface_value_known ||
+                       (record.surface_known &&
+                        std::isnan(record.info.surface_value));
+    if (!record.parameter_known || !level_known ||
+        !record.forecast_time_known) {
+      return false;
+    }
+    infos.push_back(record.info);
+  }
+  return true;
+}
+
+// Headers of the first source of a wide scan. A remote source is described
+// by its inventory when it has one; otherwise it is read here, and the body
+// is kept in bind_data.first_source_data so that the scan does not fetch it
+// again.
+static void ReadGribWideHeaders(ClientContext &context,
+                                GribBindData &bind_data,
+                                vector<Grib2MessageInfo> &infos) {
+  auto &path = bind_data.file_paths[0];
+  if (IsHttpUrl(path) && TryReadGribWideInventory(context, path, infos)) {
+    return;
+  }
+  auto data = make_shared_ptr<string>();
+  auto reader = OpenGribSource(context, path, *data);
+  idx_t message_count = grib2_message_count(reader);
+  for (idx_t i = 0; i < message_count; i++) {
+    Grib2MessageInfo info;
+    if (grib2_message_info(reader, i, &info)) {
+      infos.push_back(info);
+    }
+  }
+  grib2_close(reader);
+  if (!IsLocalPath(path)) {
+    bind_data.first_source_data = std::move(data);
+  }
+}
+
+// Wide schema: the (parameter, level) pairs of the first source, in message
+// order
+static void BindGribWideColumns(ClientContext &context,
+                                GribBindData &bind_data,
+                                vector<LogicalType> &return_types,
+                                vector<string> &names) {
+  if (bind_data.h3_resolution >= 0) {
+    names = {"h3_index", "point_count", "forecast_time", "file_index"};
+    return_types = {LogicalType::UBIGINT, LogicalType::UINTEGER,
+                    LogicalType::BIGINT, LogicalType::UINTEGER};
+  } else {
+    auto coordinate_type = bind_data.float_coordinates ? LogicalType::FLOAT
+                                                       : LogicalType::DOUBLE;
+    names = {"latitude", "longitude", "forecast_time", "file_index",
+             "grid_index"};
+    return_types = {coordinate_type, coordinate_type, LogicalType::BIGINT,
+                    LogicalType::UINTEGER, LogicalType::UINTEGER};
+  }
+  auto value_type =
+      bind_data.float_values ? LogicalType::FLOAT : LogicalType::DOUBLE;
+
+  vector<Grib2MessageInfo> infos;
+  ReadGribWideHeaders(context, bind_data, infos);
+  std::unordered_map<string, idx_t> name_counts;
+  std::unordered_set<int64_t> forecast_times;
+  idx_t first_value_column = return_types.size();
+  for (auto &info : infos) {
+    forecast_times.insert(info.forecast_time);
+    bool known = false;
+    for (auto &column : bind_data.wide_columns) {
+      known = known || column.Matches(info);
+    }
+    if (known) {
+      continue;
+    }
+
+    GribWideColumn column;
+    column.discipline = info.discipline;
+    column.parameter_category = info.parameter_category;
+    column.parameter_number = info.parameter_number;
+    column.surface_type = info.surface_type;
+    column.surface_value = info.surface_value;
+    column.match_surface_value = true;
+    bind_data.wide_columns.push_back(column);
+
+    // Codes that share an enum name get a numbered suffix
+    auto name = GribWideColumnName(info);
+    auto count = ++name_counts[name];
+    if (count > 1) {
+      name += StringUtil::Format("_%d", count);
+    }
+    names.push_back(name);
+    return_types.push_back(value_type);
+  }
+
+  if (bind_data.wide_columns.empty()) {
+    throw IOException("GRIB source has no messages: " +
+                      bind_data.file_paths[0]);
+  }
+
+  if (bind_data.series) {
+    // Every source is expected to hold the forecast times of the first, so
+    // each step list is a fixed-size array
+    idx_t steps = bind_data.file_paths.size() * forecast_times.size();
+    bind_data.series_steps = steps;
+    return_types[GRIB_WIDE_COL_FORECAST_TIME] =
+        LogicalType::ARRAY(LogicalType::BIGINT, steps);
+    return_types[GRIB_WIDE_COL_FILE_INDEX] =
+        LogicalType::ARRAY(LogicalType::UINTEGER, steps);
+    for (idx_t i = first_value_column; i < return_types.size(); i++) {
+      return_types[i] = LogicalType::ARRAY(LogicalType::FLOAT, steps);
+    }
+  }
+}
+
+// Expand a glob pattern through DuckDB's file system. Literal paths and
+// HTTP URLs (where '?' starts a query string) are kept as given. Matches are
+// sorted, so file_index follows path order, and .idx sidecars are skipped.
+static void AddGribPaths(ClientContext &context, const string &path,
+                         vector<string> &paths) {
+  auto &fs = FileSystem::GetFileSystem(context);
+  if (IsHttpUrl(path) || !FileSystem::HasGlob(path)) {
+    paths.push_back(path);
+    return;
+  }
+  vector<string> matches;
+  for (auto &file : fs.GlobFiles(path, context)) {
+    if (!StringUtil::EndsWith(file.path, ".idx")) {
+      matches.push_back(file.path);
+    }
+  }
+  if (matches.empty()) {
+    throw IOException("No GRIB files found that match the pattern \"%s\"",
+                      path);
+  }
+  std::sort(matches.begin(), matches.end());
+  paths.insert(paths.end(), matches.begin(), matches.end());
+}
+
+// The key=value directories of a path, e.g. ".../run_date=20260120/
+// run_hour=00/gfs.t00z.pgrb2.0p25.f006". Values are URL-decoded.
+static vector<std::pair<string, string>>
+ParseHivePartitions(const string &path) {
+  vector<std::pair<string, string>> partitions;
+  auto segments = StringUtil::Split(path, '/');
+  for (idx_t i = 0; i + 1 < segments.size(); i++) {
+    auto eq = segments[i].find('=');
+    if (eq == string::npos || eq == 0) {
+      continue;
+    }
+    partitions.emplace_back(
+        segments[i].substr(0, eq),
+        StringUtil::URLDecode(segments[i].substr(eq + 1)));
+  }
+  return partitions;
+}
+
+// Partition columns of hive_partitioning := true, in order of appearance. A
+// column is DATE or BIGINT when every value casts to it, else VARCHAR; files
+// without the key read NULL.
+static void BindGribPartitions(GribBindData &bind_data,
+                               vector<LogicalType> &return_types,
+                               vector<string> &names) {
+  auto &files = bind_data.file_paths;
+  vector<std::unordered_map<string, string>> file_partitions(files.size());
+  for (idx_t f = 0; f < files.size(); f++) {
+    for (auto &partition : ParseHivePartitions(files[f])) {
+      auto &column_names = bind_data.partition_names;
+      if (std::find(column_names.begin(), column_names.end(),
+                    partition.first) == column_names.end()) {
+        column_names.push_back(partition.first);
+      }
+      file_partitions[f][partition.first] = partition.second;
+    }
+  }
+
+  for (auto &name : bind_data.partition_names) {
+    for (auto &column : names) {
+      if (StringUtil::CIEquals(name, column)) {
+        throw InvalidInputException(
+            "read_grib() hive partition \"%s\" has the name of a column",
+            name);
+      }
+    }
+    LogicalType type = LogicalType::VARCHAR;
+    for (auto candidate : {LogicalTypeId::DATE, LogicalTypeId::BIGINT}) {
+      bool casts = true;
+      for (auto &partitions : file_partitions) {
+        auto it = partitions.find(name);
+        Value value(it == partitions.end() ? string() : it->second);
+        casts = casts && (it == partitions.end() ||
+                          value.DefaultTryCastAs(candidate, true));
+      }
+      if (casts) {
+        type = candidate;
+        break;
+      }
+    }
+    bind_data.partition_types.push_back(type);
+  }
+
+  bind_data.partition_values.resize(files.size());
+  for (idx_t f = 0; f < files.size(); f++) {
+    for (idx_t k = 0; k < bind_data.partition_names.size(); k++) {
+      auto &type = bind_data.partition_types[k];
+      auto it = file_partitions[f].find(bind_data.partition_names[k]);
+      bind_data.partition_values[f].push_back(
+          it == file_partitions[f].end()
+              ? Value(type)
+              : Value(it->second).DefaultCastAs(type));
+    }
+  }
+
+  bind_data.partition_column_start = names.size();
+  names.insert(names.end(), bind_data.partition_names.begin(),
+               bind_data.partition_names.end());
+  return_types.insert(return_types.end(), bind_data.partition_types.begin(),
+                      bind_data.partition_types.end());
+}
+
+// Position in the full schema of a bound column id: coords := 'index' drops
+// the coordinate columns, and a virtual grid_index is left out in between
+static column_t GribSchemaColumn(const GribBindData &bind_data,
+                                 column_t column_id) {
+  if (bind_data.virtual_grid_index &&
+      column_id == GRIB_VIRTUAL_COL_GRID_INDEX) {
+    return GRIB_COL_GRID_INDEX;
+  }
+  if (IsVirtualColumn(column_id)) {
+    return column_id;
+  }
+  if (bind_data.index_coordinates) {
+    return column_id + GRIB_COORDINATE_COLUMNS;
+  }
+  if (bind_data.virtual_grid_index && column_id >= GRIB_COL_GRID_INDEX) {
+    return column_id + 1;
+  }
+  return column_id;
+}
+
+static virtual_column_map_t
+GribGetVirtualColumns(ClientContext &context,
+                      optional_ptr<FunctionData> bind_data_p) {
+  virtual_column_map_t result;
+  auto &bind_data = bind_data_p->Cast<GribBindData>();
+  if (bind_data.virtual_grid_index) {
+    result.insert(make_pair(GRIB_VIRTUAL_COL_GRID_INDEX,
+                            TableColumn("grid_index", LogicalType::UINTEGER)));
+  }
+  result.insert(make_pair(COLUMN_IDENTIFIER_ROW_ID,
+                          TableColumn("rowid", LogicalType::ROW_TYPE)));
+  return result;
+}
+
+// Bind function - accepts VARCHAR or LIST(VARCHAR)
+static unique_ptr<FunctionData> GribBind(ClientContext &context,
+                                         TableFunctionBindInput &input,
+                                         vector<LogicalType> &return_types,
+                                         vector<string> &names) {
+  auto bind_data = make_uniq<GribBindData>();
+
+  if (input.inputs.empty()) {
+    throw InvalidInputException(
+        "read_grib() requires a file path or array of paths");
+  }
+
+  auto &arg = input.inputs[0];
+  auto arg_type = arg.type().id();
+
+  bool hive_partitioning = false;
+  for (auto &kv : input.named_parameters) {
+    if (kv.first == "hive_partitioning") {
+      hive_partitioning = BooleanValue::Get(kv.second);
+    } else if (kv.first == "split_messages") {
+      bind_data->split_messages = BooleanValue::Get(kv.second);
+    } else if (kv.first == "wide") {
+      bind_data->wide = BooleanValue::Get(kv.second);
+    } else if (kv.first == "layout") {
+      auto layout = StringUtil::Lower(kv.second.ToString());
+      if (layout != "long" && layout != "wide" && layout != "series") {
+        throw InvalidInputException(
+            "read_grib() layout must be 'long', 'wide' or 'series', got '%s'",
+            layout);
+      }
+      bind_data->wide = bind_data->wide || layout != "long";
+      bind_data->series = layout == "series";
+    } else if (kv.first == "h3_resolution") {
+      auto resolution = kv.second.GetValue<int32_t>();
+      if (resolution < 0 || resolution > 15) {
+        throw InvalidInputException(
+            "read_grib() h3_resolution must be between 0 and 15, got %d",
+            resolution);
+      }
+      // Cells aggregate all parameters of a point, so this implies wide
+      bind_data->h3_cells = BindGribH3CellFunction(context, resolution);
+      bind_data->h3_resolution = resolution;
+      bind_data->wide = true;
+    } else if (kv.first == "value_type") {
+      auto value_type = StringUtil::Lower(kv.second.ToString());
+      if (value_type != "double" && value_type != "float") {
+        throw InvalidInputException(
+            "read_grib() value_type must be 'double' or 'float', got '%s'",
+            value_type);
+      }
+      bind_data->float_values = value_type == "float";
+    } else if (kv.first == "coords") {
+      auto coords = StringUtil::Lower(kv.second.ToString());
+      if (coords != "double" && coords != "float" && coords != "index") {
+        throw InvalidInputException("read_grib() coords must be 'double', "
+                                    "'float' or 'index', got '%s'",
+                                    coords);
+      }
+      bind_data->float_coordinates = coords == "float";
+      bind_data->index_coordinates = coords == "index";
+    }
+  }
+  if (bind_data->h3_resolution >= 0 &&
+      (bind_data->float_coordinates || bind_data->index_coordinates)) {
+    throw InvalidInputException(
+        "read_grib() coords does not apply with h3_resolution");
+  }
+  if (hive_partitioning && bind_data->series) {
+    // A series row spans every file, so it has no single partition
+    throw InvalidInputException(
+        "read_grib() hive_partitioning does not apply with layout := "
+        "'series'");
+  }
+
+  if (arg_type == LogicalTypeId::VARCHAR) {
+    AddGribPaths(context, arg.GetValue<string>(), bind_data->file_paths);
+  } else if (arg_type == LogicalTypeId::LIST) {
+    auto &list_children = ListValue::GetChildren(arg);
+    if (list_children.empty()) {
+      throw InvalidInputException("read_grib() array cannot be empty");
+    }
+    for (auto &child : list_children) {
+      AddGribPaths(context, child.GetValue<string>(), bind_data->file_paths);
+    }
+  } else {
+    throw InvalidInputException(
+        "read_grib() requires VARCHAR or VARCHAR[] argument");
+  }
+  for (idx_t i = 0; i < bind_data->file_paths.size(); i++) {
+    bind_data->scan_files.push_back(i);
+  }
+
+  CreateEnumTypes(*bind_data);
+
+  if (bind_data->wide) {
+    BindGribWideColumns(context, *bind_data, return_types, names);
+  } else {
+    auto coordinate_type = bind_data->float_coordinates ? LogicalType::FLOAT
+                                                        : LogicalType::DOUBLE;
+    names = {"latitude",      "longitude",  "value",         "discipline",
+             "surface",       "parameter",  "forecast_time", "surface_value",
+             "message_index", "file_index", "grid_index"};
+    return_types = {coordinate_type,
+                    coordinate_type,
+                    bind_data->float_values ? LogicalType::FLOAT
+                                            : LogicalType::DOUBLE,
+                    bind_data->discipline_type,
+                    bind_data->surface_type,
+                    bind_data->parameter_type,
+                    LogicalType::BIGINT,
+                    LogicalType::DOUBLE,
+                    LogicalType::UINTEGER,
+                    LogicalType::UINTEGER,
+                    LogicalType::UINTEGER};
+  }
+
+  if (hive_partitioning) {
+    BindGribPartitions(*bind_data, return_types, names);
+  }
+  if (!bind_data->wide && !bind_data->index_coordinates) {
+    names.erase(names.begin() + GRIB_COL_GRID_INDEX);
+    return_types.erase(return_types.begin() + GRIB_COL_GRID_INDEX);
+    bind_data->virtual_grid_index = true;
+  }
+
+  // Both layouts start with latitude and longitude; the scan keeps the
+  // column positions of the full schema
+  if (bind_data->index_coordinates) {
+    names.erase(names.begin(), names.begin() + GRIB_COORDINATE_COLUMNS);
+    return_types.erase(return_types.begin(),
+                       return_types.begin() + GRIB_COORDINATE_COLUMNS);
+  }
+  return std::move(bind_data);
+}
+
+// ============================================================================
+// Cardinality and column statistics from message headers
+// ============================================================================
+
+// Sources whose headers are read for the optimizer; the rows of any others
+// are extrapolated from them. Each remote source costs an .idx request.
+static constexpr idx_t GRIB_STATS_MAX_SOURCES = 16;
+static constexpr idx_t GRIB_STATS_MAX_REMOTE_SOURCES = 2;
+
+// Estimate when no source could be inspected: a global grid holds about a
+// million points per message
+static constexpr idx_t GRIB_REPORTED_CARDINALITY = 100000000;
+
+// Points per message of an inventory record, which has no grid: the global
+// 0.25 degree grid of GFS and most NOAA products
+static constexpr idx_t GRIB_STATS_INVENTORY_POINTS = 1038240;
+
+// Read the headers of one source. Returns false when it has neither
+// readable headers nor an inventory; the scan reports why.
+static bool InspectGribSource(ClientContext &context, const string &path,
+                              GribStatsSource &source) {
+  if (IsHttpUrl(path)) {
+    // CGI endpoints (e.g. NOMADS filter_gfs) have no inventory
+    string index_text;
+    return path.find('?') == string::npos &&
+           WeatherHttpTryGet(context, path + ".idx", index_text) &&
+           TryParseGribIndex(index_text, source.records) &&
+           !source.records.empty();
+  }
+  if (!IsLocalPath(path)) {
+    // Objects in other file systems are summarized from a sidecar only
+    auto &fs = FileSystem::GetFileSystem(context);
+    string index_text;
+    if (!fs.FileExists(path + ".idx")) {
+      return false;
+    }
+    ReadVirtualFile(context, path + ".idx", index_text, nullptr);
+    return TryParseGribIndex(index_text, source.records) &&
+           !source.records.empty();
+  }
+
+  char *error = nullptr;
+  auto reader = grib2_open_with_error(path.c_str(), &error);
+  if (!reader) {
+    if (error) {
+      grib2_free_error(error);
+    }
+    return false;
+  }
+  idx_t message_count = grib2_message_count(reader);
+  for (idx_t i = 0; i < message_count; i++) {
+    GribIndexRecord record;
+    Grib2GridInfo grid = {};
+    if (!grib2_message_info(reader, i, &record.info)) {
+      continue;
+    }
+    grib2_grid_info(reader, i, &grid);
+    record.message_number = i;
+    record.parameter_known = true;
+    record.surface_known = true;
+    record.surface_value_known = true;
+    record.forecast_time_known = true;
+    source.records.push_back(record);
+    source.grids.push_back(grid);
+  }
+  grib2_close(reader);
+  return true;
+}
+
+static const GribHeaderSummary &
+GetGribHeaderSummary(ClientContext &context, const GribBindData &bind_data) {
+  if (bind_data.header_summary) {
+    return *bind_data.header_summary;
+  }
+  auto summary = make_shared_ptr<GribHeaderSummary>();
+  idx_t remote_sources = 0;
+  for (auto file_idx : bind_data.scan_files) {
+    auto &path = bind_data.file_paths[file_idx];
+    if (summary->sources.size() >= GRIB_STATS_MAX_SOURCES) {
+      summary->complete = false;
+      break;
+    }
+    bool remote = !IsLocalPath(path);
+    if (remote && remote_sources++ >= GRIB_STATS_MAX_REMOTE_SOURCES) {
+      summary->complete = false;
+      continue;
+    }
+    GribStatsSource source;
+    if (!InspectGribSource(context, path, source)) {
+      summary->complete = false;
+      continue;
+    }
+    // Inventories give the messages but not their grids
+    summary->complete = summary->complete && !remote;
+    summary->sources.push_back(std::move(source));
+  }
+  bind_data.header_summary = summary;
+  return *summary;
+}
+
+// Share of the globe inside the bounding box
+static double GribBoxFraction(const GribBindData &bind_data) {
+  if (!bind_data.has_bbox) {
+    return 1.0;
+  }
+  double lat_span = MaxValue(0.0, bind_data.lat_max - bind_data.lat_min);
+  double lon_span = MaxValue(0.0, bind_data.lon_max - bind_data.lon_min);
+  return MinValue(1.0, lat_span / 180.0) * MinValue(1.0, lon_span / 360.0);
+}
+
+// H3 cells covering the bounding box: 2 + 120 * 7^r cover the globe
+static idx_t GribH3CellEstimate(const GribBindData &bind_data) {
+  double cells = 2.0 + 120.0 * std::pow(7.0, bind_data.h3_resolution);
+  auto in_box = static_cast<idx_t>(cells * GribBoxFraction(bind_data));
+  return MaxValue<idx_t>(1, in_box);
+}
+
+// Rows and columns of a regular grid inside the bounding box and the
+// coordinates they span. The decoder keeps a row or column exactly when its
+// coordinate, computed the same way, lies inside the box.
+struct GribGridExtent {
+  idx_t rows = 0;
+  idx_t columns = 0;
+  double lat_min = INFINITY;
+  double lat_max = -INFINITY;
+  double lon_min = INFINITY;
+  double lon_max = -INFINITY;
+};
+
+static GribGridExtent ComputeGribGridExtent(const GribBindData &bind_data,
+                                            const Grib2GridInfo &grid) {
+  GribGridExtent extent;
+  for (uint32_t j = 0; j < grid.nj; j++) {
+    double lat = grid.lat1 + j * grid.dj;
+    if (bind_data.has_bbox &&
+        (lat < bind_data.lat_min || lat > bind_data.lat_max)) {
+      continue;
+    }
+    extent.rows++;
+    extent.lat_min = MinValue(extent.lat_min, lat);
+    extent.lat_max = MaxValue(extent.lat_max, lat);
+  }
+  for (uint32_t i = 0; i < grid.ni; i++) {
+    double lon = grid.lon1 + i * grid.di;
+    if (lon > 180.0) {
+      lon -= 360.0;
+    }
+    if (bind_data.has_bbox &&
+        (lon < bind_data.lon_min || lon > bind_data.lon_max)) {
+      continue;
+    }
+    extent.columns++;
+    extent.lon_min = MinValue(extent.lon_min, lon);
+    extent.lon_max = MaxValue(extent.lon_max, lon);
+  }
+  return extent;
+}
+
+// Messages of a file nearly always share one grid, so the extent of the
+// previous grid is reused
+struct GribExtentCache {
+  bool valid = false;
+  Grib2GridInfo grid = {};
+  GribGridExtent extent;
+
+  const GribGridExtent &Get(const GribBindData &bind_data,
+                            const Grib2GridInfo &grid_p) {
+    if (!valid || grid.ni != grid_p.ni || grid.nj != grid_p.nj ||
+        grid.lat1 != grid_p.lat1 || grid.lon1 != grid_p.lon1 ||
+        grid.di != grid_p.di || grid.dj != grid_p.dj) {
+      valid = true;
+      grid = grid_p;
+      extent = ComputeGribGridExtent(bind_data, grid);
+    }
+    return extent;
+  }
+};
+
+static bool GribRecordMatches(const GribBindData &bind_data,
+                              const GribStatsSource &source, idx_t k) {
+  auto &record = source.records[k];
+  if (source.grids.empty()) {
+    return IndexRecordMatchesFilters(bind_data.message_filters, record);
+  }
+  return MessageMatchesFilters(bind_data.message_filters, record.info);
+}
+
+// Points message k emits. Exact for decoded regular grids and for any grid
+// without a bounding box; other grids and inventory records are estimated.
+static idx_t GribMessagePoints(const GribBindData &bind_data,
+                               const GribStatsSource &source, idx_t k,
+                               GribExtentCache &cache, bool &exact) {
+  if (source.grids.empty()) {
+    exact = false;
+    return static_cast<idx_t>(GRIB_STATS_INVENTORY_POINTS *
+                              GribBoxFraction(bind_data));
+  }
+  auto &grid = source.grids[k];
+  if (!bind_data.has_bbox) {
+    return source.records[k].info.num_points;
+  }
+  if (!grid.regular) {
+    exact = false;
+    return static_cast<idx_t>(source.records[k].info.num_points *
+                              GribBoxFraction(bind_data));
+  }
+  auto &extent = cache.Get(bind_data, grid);
+  return extent.rows * extent.columns;
+}
+
+// Rows one source produces under the pushed-down filters. Wide rows come
+// from one group of points per forecast time, series rows from one group
+// over all of them.
+static idx_t GribSourceRows(const GribBindData &bind_data,
+                            const GribStatsSource &source,
+                            GribExtentCache &cache, bool &exact) {
+  idx_t cells = 0;
+  if (bind_data.h3_resolution >= 0) {
+    cells = GribH3CellEstimate(bind_data);
+    exact = false;
+  }
+  vector<int64_t> group_times;
+  idx_t rows = 0;
+  for (idx_t k = 0; k < source.records.size(); k++) {
+    if (!GribRecordMatches(bind_data, source, k)) {
+      continue;
+    }
+    auto &record = source.records[k];
+    if (bind_data.wide) {
+      // Groups only hold messages of the bound columns
+      bool in_column = source.grids.empty();
+      for (auto &column : bind_data.wide_columns) {
+        in_column = in_column || column.Matches(record.info);
+      }
+      int64_t time =
+          record.forecast_time_known ? record.info.forecast_time : 0;
+      if (!in_column || std::find(group_times.begin(), group_times.end(),
+                                  time) != group_times.end()) {
+        continue;
+      }
+      group_times.push_back(time);
+    }
+    auto points = GribMessagePoints(bind_data, source, k, cache, exact);
+    if (cells > 0) {
+      points = MinValue(points, cells);
+    }
+    rows = bind_data.series ? MaxValue(rows, points) : rows + points;
+  }
+  return rows;
+}
+
+static unique_ptr<NodeStatistics>
+GribCardinality(ClientContext &context, const FunctionData *bind_data_p) {
+  auto &bind_data = bind_data_p->Cast<GribBindData>();
+  if (bind_data.scan_files.empty()) {
+    // Every file was pruned
+    return make_uniq<NodeStatistics>(0, 0);
+  }
+  auto &summary = GetGribHeaderSummary(context, bind_data);
+  if (summary.sources.empty()) {
+    return make_uniq<NodeStatistics>(GRIB_REPORTED_CARDINALITY);
+  }
+
+  bool exact = summary.sources.size() == bind_data.scan_files.size();
+  GribExtentCache cache;
+  idx_t rows = 0;
+  for (auto &source : summary.sources) {
+    auto source_rows = GribSourceRows(bind_data, source, cache, exact);
+    rows = bind_data.series ? MaxValue(rows, source_rows) : rows + source_rows;
+  }
+  if (!bind_data.series) {
+    // Sources not inspected are assumed to look like the inspected ones
+    rows = static_cast<idx_t>(static_cast<double>(rows) *
+                              bind_data.scan_files.size() /
+                              summary.sources.size());
+  }
+
+  if (bind_data.max_rows > 0) {
+    rows = MinValue(rows, bind_data.max_rows);
+    if (!exact) {
+      return make_uniq<NodeStatistics>(rows, bind_data.max_rows);
+    }
+  }
+  if (exact) {
+    return make_uniq<NodeStatistics>(rows, rows);
+  }
+  return make_uniq<NodeStatistics>(rows);
+}
+
+// Position in the long layout of a bound column with statistics, or
+// INVALID_INDEX. Series steps and values are lists without any.
+static idx_t GribStatsColumn(const GribBindData &bind_data, idx_t column) {
+  if (!bind_data.wide) {
+    return column <= GRIB_COL_GRID_INDEX ? column : DConstants::INVALID_INDEX;
+  }
+  bool cells = bind_data.h3_resolution >= 0;
+  switch (column) {
+  case GRIB_COL_LATITUDE:
+  case GRIB_COL_LONGITUDE:
+    return cells ? DConstants::INVALID_INDEX : column;
+  case GRIB_WIDE_COL_FORECAST_TIME:
+    return bind_data.series ? DConstants::INVALID_INDEX
+                            : GRIB_COL_FORECAST_TIME;
+  case GRIB_WIDE_COL_FILE_INDEX:
+    return bind_data.series ? DConstants::INVALID_INDEX : GRIB_COL_FILE_INDEX;
+  case GRIB_WIDE_COL_GRID_INDEX:
+    return cells ? DConstants::INVALID_INDEX : GRIB_COL_GRID_INDEX;
+  default:
+    return DConstants::INVALID_INDEX;
+  }
+}
+
+static unique_ptr<BaseStatistics> GribRangeStatistics(const LogicalType &type,
+                                                      const Value &min,
+                                                      const Value &max,
+                                                      idx_t distinct_count) {
+  auto stats = BaseStatistics::CreateUnknown(type);
+  NumericStats::SetMin(stats, min.DefaultCastAs(type));
+  NumericStats::SetMax(stats, max.DefaultCastAs(type));
+  stats.SetDistinctCount(distinct_count);
+  return stats.ToUnique();
+}
+
+// Distinct enum values among the matching messages. Inventory records count
+// with the fields they identify, so this is an estimate for remote sources.
+static unique_ptr<BaseStatistics>
+GribEnumStatistics(const GribBindData &bind_data,
+                   const GribHeaderSummary &summary, idx_t column,
+                   const LogicalType &type) {
+  vector<double> values;
+  for (auto &source : summary.sources) {
+    for (idx_t k = 0; k < source.records.size(); k++) {
+      auto &record = source.records[k];
+      bool known = column == GRIB_COL_SURFACE ? record.surface_known
+                                              : record.parameter_known;
+      if (known && GribRecordMatches(bind_data, source, k)) {
+        values.push_back(MessageColumnValue(column, record.info));
+      }
+    }
+  }
+  if (values.empty()) {
+    return nullptr;
+  }
+  std::sort(values.begin(), values.end());
+  auto stats = BaseStatistics::CreateUnknown(type);
+  stats.SetDistinctCount(static_cast<idx_t>(
+      std::unique(values.begin(), values.end()) - values.begin()));
+  return stats.ToUnique();
+}
+
+// Range of a column that is constant per message (or, for grid_index,
+// bounded by the message's grid) over the matching messages
+static unique_ptr<BaseStatistics>
+GribMessageStatistics(const GribBindData &bind_data,
+                      const GribHeaderSummary &summary, idx_t column) {
+  vector<double> values;
+  for (auto &source : summary.sources) {
+    for (idx_t k = 0; k < source.records.size(); k++) {
+      auto &info = source.records[k].info;
+      if (!GribRecordMatches(bind_data, source, k)) {
+        continue;
+      }
+      if (column != GRIB_COL_GRID_INDEX) {
+        values.push_back(MessageColumnValue(column, info));
+      } else if (info.num_points > 0) {
+        values.push_back(static_cast<double>(info.num_points - 1));
+      }
+    }
+  }
+  if (values.empty()) {
+    return nullptr;
+  }
+  std::sort(values.begin(), values.end());
+  auto distinct_count = static_cast<idx_t>(
+      std::unique(values.begin(), values.end()) - values.begin());
+  if (column == GRIB_COL_GRID_INDEX) {
+    return GribRangeStatistics(LogicalType::UINTEGER, Value::UINTEGER(0),
+                               Value::DOUBLE(values.back()),
+                               static_cast<idx_t>(values.back()) + 1);
+  }
+  auto type = column == GRIB_COL_FORECAST_TIME ? LogicalType::BIGINT
+                                               : LogicalType::UINTEGER;
+  return GribRangeStatistics(type, Value::DOUBLE(values.front()),
+                             Value::DOUBLE(values.back()), distinct_count);
+}
+
+// Coordinate range of the points the matching messages emit; only regular
+// grids have one without decoding
+static unique_ptr<BaseStatistics>
+GribCoordinateStatistics(const GribBindData &bind_data,
+                         const GribHeaderSummary &summary, idx_t column) {
+  bool latitude = column == GRIB_COL_LATITUDE;
+  double min = INFINITY;
+  double max = -INFINITY;
+  idx_t distinct_count = 0;
+  GribExtentCache cache;
+  for (auto &source : summary.sources) {
+    for (idx_t k = 0; k < source.records.size(); k++) {
+      if (!GribRecordMatches(bind_data, source, k)) {
+        continue;
+      }
+      if (!source.grids[k].regular) {
+        return nullptr;
+      }
+      auto &extent = cache.Get(bind_data, source.grids[k]);
+      if (extent.rows == 0 || extent.columns == 0) {
+        continue;
+      }
+      min = MinValue(min, latitude ? extent.lat_min : extent.lon_min);
+      max = MaxValue(max, latitude ? extent.lat_max : extent.lon_max);
+      distinct_count = MaxValue(distinct_count,
+                                latitude ? extent.rows : extent.columns);
+    }
+  }
+  if (distinct_count == 0) {
+    return nullptr;
+  }
+  auto type = bind_data.float_coordinates ? LogicalType::FLOAT
+                                          : LogicalType::DOUBLE;
+  return GribRangeStatistics(type, Value::DOUBLE(min), Value::DOUBLE(max),
+                             distinct_count);
+}
+
+// Ranges (used to prune filters) need every source decoded; distinct counts
+// for join ordering are also taken from inventories
+static unique_ptr<BaseStatistics>
+GribStatistics(ClientContext &context, const FunctionData *bind_data_p,
+               column_t column_index) {
+  auto &bind_data = bind_data_p->Cast<GribBindData>();
+  column_index = GribSchemaColumn(bind_data, column_index);
+  if (IsVirtualColumn(column_index)) {
+    return nullptr;
+  }
+  auto column = GribStatsColumn(bind_data, column_index);
+  if (column == GRIB_COL_FILE_INDEX) {
+    idx_t file_count = bind_data.file_paths.size();
+    return GribRangeStatistics(LogicalType::UINTEGER, Value::UINTEGER(0),
+                               Value::UBIGINT(file_count - 1), file_count);
+  }
+
+  auto &summary = GetGribHeaderSummary(context, bind_data);
+  switch (column) {
+  case GRIB_COL_DISCIPLINE:
+    return GribEnumStatistics(bind_data, summary, column,
+                              bind_data.discipline_type);
+  case GRIB_COL_SURFACE:
+    return GribEnumStatistics(bind_data, summary, column,
+                              bind_data.surface_type);
+  case GRIB_COL_PARAMETER:
+    return GribEnumStatistics(bind_data, summary, column,
+                              bind_data.parameter_type);
+  default:
+    break;
+  }
+  if (!summary.complete) {
+    return nullptr;
+  }
+  switch (column) {
+  case GRIB_COL_LATITUDE:
+  case GRIB_COL_LONGITUDE:
+    return GribCoordinateStatistics(bind_data, summary, column);
+  case GRIB_COL_FORECAST_TIME:
+  case GRIB_COL_MESSAGE_INDEX:
+  case GRIB_COL_GRID_INDEX:
+    return GribMessageStatistics(bind_data, summary, column);
+  default:
+    return nullptr;
+  }
+}
+
+// Split the files left after pruning into scan tasks. With at least as many
+// files as threads, each file is one task; otherwise large local files are
+// split by submessage so that every thread gets work.
+static void PlanGribScanTasks(ClientContext &context,
+                              const GribBindData &bind_data,
+                              GribGlobalState &state) {
+  auto &paths = bind_data.file_paths;
+  auto &files = bind_data.scan_files;
+  idx_t threads = MaxValue<idx_t>(
+      1, NumericCast<idx_t>(
+             TaskScheduler::GetScheduler(context).NumberOfThreads()));
+
+  // Wide rows zip messages of the whole file, so files are never split
+  idx_t chunks_per_file = 1;
+  if (!files.empty() && files.size() < threads && !bind_data.wide) {
+    chunks_per_file = (threads + files.size() - 1) / files.size();
+  }
+
+  for (auto file_idx : files) {
+    GribScanTask task;
+    task.file_idx = file_idx;
+
+    idx_t message_count = 0;
+    if (chunks_per_file > 1 && IsLocalPath(paths[file_idx])) {
+      char *error = nullptr;
+      message_count = grib2_count_messages(paths[file_idx].c_str(), &error);
+      if (error) {
+        string error_msg = error;
+        grib2_free_error(error);
+        throw IOException("Failed to open GRIB source: " + error_msg);
+      }
+    }
+
+    if (message_count <= 1) {
+      state.tasks.push_back(task);
+      continue;
+    }
+
+    idx_t step = (message_count + chunks_per_file - 1) / chunks_per_file;
+    for (idx_t begin = 0; begin < message_count; begin += step) {
+      task.message_begin = begin;
+      task.message_end = MinValue(begin + step, message_count);
+      state.tasks.push_back(task);
+    }
+  }
+
+  state.max_threads = MaxValue<idx_t>(1, state.tasks.size());
+}
+
+static unique_ptr<GlobalTableFunctionState>
+GribInitGlobal(ClientContext &context, TableFunctionInitInput &input) {
+  auto state = make_uniq<GribGlobalState>();
+  auto &bind_data = input.bind_data->Cast<GribBindData>();
+  state->metrics = RegisterWeatherScan(context, "read_grib");
+
+  state->column_ids = input.column_ids;
+  for (auto &column_id : state->column_ids) {
+    column_id = GribSchemaColumn(bind_data, column_id);
+  }
+  // Cells are looked up by grid index
+  state->needs_coordinates = bind_data.h3_resolution < 0 &&
+                             NeedsCoordinates(state->column_ids);
+
+  if (bind_data.wide) {
+    auto &columns = bind_data.wide_columns;
+    idx_t first_value = bind_data.h3_resolution >= 0
+                            ? GRIB_H3_COL_FIRST_VALUE
+                            : GRIB_WIDE_COL_FIRST_VALUE;
+    for (auto column_id : state->column_ids) {
+      idx_t slot = DConstants::INVALID_INDEX;
+      if (column_id >= first_value &&
+          column_id < first_value + columns.size()) {
+        slot = state->wide_columns.size();
+        state->wide_columns.push_back(columns[column_id - first_value]);
+      }
+      state->wide_slots.push_back(slot);
+    }
+    // Without projected values the first column still defines the rows
+    if (state->wide_columns.empty()) {
+      state->wide_columns.push_back(columns[0]);
+    }
+  }
+  if (bind_data.series) {
+    state->series = make_uniq<GribSeriesBuffer>(state->wide_columns.size());
+  }
+
+  PlanGribScanTasks(context, bind_data, *state);
+
+  return std::move(state);
+}
+
+static unique_ptr<LocalTableFunctionState>
+GribInitLocal(ExecutionContext &context, TableFunctionInitInput &input,
+              GlobalTableFunctionState *global_state) {
+  auto state = make_uniq<GribLocalState>();
+  state->context_ptr = &context.client;
+  state->metrics = global_state->Cast<GribGlobalState>().metrics.get();
+  // A single run per chunk stops each chunk at the end of a message
+  if (input.bind_data->Cast<GribBindData>().split_messages) {
+    state->runs.resize(1);
+  }
+  return std::move(state);
+}
+
+// Fill the projected columns of wide rows [offset, offset + count) of the
+// current group
+static void WriteGribWideRows(const GribWideReader &wide, idx_t offset,
+                              idx_t count, const GribGlobalState &gstate,
+                              idx_t file_index, DataChunk &output) {
+  for (idx_t i = 0; i < gstate.column_ids.size(); i++) {
+    auto &vec = output.data[i];
+    switch (gstate.column_ids[i]) {
+    case GRIB_COL_LATITUDE:
+      wide.CopyLatitudes(offset, count, vec);
+      break;
+    case GRIB_COL_LONGITUDE:
+      wide.CopyLongitudes(offset, count, vec);
+      break;
+    case GRIB_WIDE_COL_FORECAST_TIME:
+      vec.SetVectorType(VectorType::CONSTANT_VECTOR);
+      ConstantVector::GetData<int64_t>(vec)[0] = wide.ForecastTime();
+      break;
+    case GRIB_WIDE_COL_FILE_INDEX:
+      vec.SetVectorType(VectorType::CONSTANT_VECTOR);
+      ConstantVector::GetData<uint32_t>(vec)[0] =
+          static_cast<uint32_t>(file_index);
+      break;
+    case GRIB_WIDE_COL_GRID_INDEX:
+      wide.CopyGridIndices(offset, count, vec);
+      break;
+    default:
+      if (gstate.wide_slots[i] == DConstants::INVALID_INDEX) {
+        // Row id or other virtual column
+        vec.SetVectorType(VectorType::CONSTANT_VECTOR);
+        ConstantVector::SetNull(vec, true);
+      } else {
+        wide.CopyValues(gstate.wide_slots[i], offset, count, vec);
+      }
+      break;
+    }
+  }
+  output.SetCardinality(count);
+}
+
+// Fill the projected columns of per-cell rows [offset, offset + count) of
+// the current group
+static void WriteGribH3Rows(const GribWideReader &wide,
+                            const GribH3Aggregate &cells, idx_t offset,
+                            idx_t count, const GribGlobalState &gstate,
+                            idx_t file_index, DataChunk &output) {
+  for (idx_t i = 0; i < gstate.column_ids.size(); i++) {
+    auto &vec = output.data[i];
+    switch (gstate.column_ids[i]) {
+    case GRIB_H3_COL_INDEX:
+      cells.CopyCells(offset, count, vec);
+      break;
+    case GRIB_H3_COL_POINT_COUNT:
+      cells.CopyPointCounts(offset, count, vec);
+      break;
+    case GRIB_WIDE_COL_FORECAST_TIME:
+      vec.SetVectorType(VectorType::CONSTANT_VECTOR);
+      ConstantVector::GetData<int64_t>(vec)[0] = wide.ForecastTime();
+      break;
+    case GRIB_WIDE_COL_FILE_INDEX:
+      vec.SetVectorType(VectorType::CONSTANT_VECTOR);
+      ConstantVector::GetData<uint32_t>(vec)[0] =
+          static_cast<uint32_t>(file_index);
+      break;
+    default:
+      if (gstate.wide_slots[i] == DConstants::INVALID_INDEX) {
+        // Row id or other virtual column
+        vec.SetVectorType(VectorType::CONSTANT_VECTOR);
+        ConstantVector::SetNull(vec, true);
+      } else {
+        cells.CopyValues(gstate.wide_slots[i], offset, count, vec);
+      }
+      break;
+    }
+  }
+  output.SetCardinality(count);
+}
+
+// Fill the projected columns of series rows [offset, offset + count), one
+// list element per step
+static void WriteGribSeriesRows(const GribSeriesBuffer &series, idx_t offset,
+                                idx_t count, const GribGlobalState &gstate,
+                                bool h3, DataChunk &output) {
+  for (idx_t i = 0; i < gstate.column_ids.size(); i++) {
+    auto &vec = output.data[i];
+    switch (gstate.column_ids[i]) {
+    case GRIB_COL_LATITUDE:
+      if (h3) {
+        series.CopyCells(offset, count, vec);
+      } else {
+        series.CopyLatitudes(offset, count, vec);
+      }
+      break;
+    case GRIB_COL_LONGITUDE:
+      if (h3) {
+        series.CopyPointCounts(offset, count, vec);
+      } else {
+        series.CopyLongitudes(offset, count, vec);
+      }
+      break;
+    case GRIB_WIDE_COL_FORECAST_TIME:
+      series.CopyForecastTimes(count, vec);
+      break;
+    case GRIB_WIDE_COL_FILE_INDEX:
+      series.CopyFileIndices(count, vec);
+      break;
+    default:
+      if (!h3 && gstate.column_ids[i] == GRIB_WIDE_COL_GRID_INDEX) {
+        series.CopyGridIndices(offset, count, vec);
+      } else if (gstate.wide_slots[i] == DConstants::INVALID_INDEX) {
+        // Row id or other virtual column
+        vec.SetVectorType(VectorType::CONSTANT_VECTOR);
+        ConstantVector::SetNull(vec, true);
+      } else {
+        series.CopyValues(gstate.wide_slots[i], offset, count, vec);
+      }
+      break;
+    }
+  }
+  output.SetCardinality(count);
+}
+
+// Fill the projected partition columns, constant over a file
+static void WriteGribPartitionColumns(const GribBindData &bind_data,
+                                      const GribGlobalState &gstate,
+                                      idx_t file_index, DataChunk &output) {
+  if (bind_data.partition_names.empty()) {
+    return;
+  }
+  auto &values = bind_data.partition_values[file_index];
+  for (idx_t i = 0; i < gstate.column_ids.size(); i++) {
+    auto column = gstate.column_ids[i];
+    if (!IsVirtualColumn(column) &&
+        column >= bind_data.partition_column_start) {
+      output.data[i].Reference(
+          values[column - bind_data.partition_column_start]);
+    }
+  }
+}
+
+// Add every group of the open task as a series step and close it. The
+// thread that finishes the last task orders the steps and writes all rows,
+// after the batches of every other task.
+static void AddGribSeriesSteps(GribGlobalState &gstate,
+                               GribLocalState &lstate,
+                               const GribBindData &bind_data) {
+  auto &wide = *lstate.wide_reader;
+  bool h3 = bind_data.h3_resolution >= 0;
+  while (wide.NextGroup()) {
+    if (h3) {
+      lstate.h3_aggregate.Aggregate(*lstate.context_ptr, wide,
+                                    *bind_data.h3_cells);
+    }
+    gstate.series->AddStep(wide.ForecastTime(), lstate.file_idx, wide,
+                           h3 ? &lstate.h3_aggregate : nullptr);
+  }
+  lstate.CloseFile();
+  gstate.completed_tasks++;
+  if (++gstate.series_tasks == gstate.tasks.size()) {
+    gstate.series->Finalize();
+    if (gstate.series->StepCount() != bind_data.series_steps) {
+      throw InvalidInputException(
+          "read_grib(layout := 'series') expected %d steps (the forecast "
+          "times of the first file in every file), got %d",
+          bind_data.series_steps, gstate.series->StepCount());
+    }
+    lstate.series_emitter = true;
+    lstate.batch_index = gstate.tasks.size();
+  }
+}
+
+static void GribWideScan(GribGlobalState &gstate, GribLocalState &lstate,
+                         const GribBindData &bind_data, idx_t batch_size,
+                         DataChunk &output) {
+  bool h3 = bind_data.h3_resolution >= 0;
+  while (true) {
+    if (lstate.series_emitter) {
+      auto &series = *gstate.series;
+      idx_t count = MinValue(batch_size, series.Size() - gstate.series_offset);
+      WriteGribSeriesRows(series, gstate.series_offset, count, gstate, h3,
+                          output);
+      gstate.series_offset += count;
+      lstate.task_rows += count;
+      gstate.rows_returned += count;
+      return;
+    }
+    if (!lstate.reader && !lstate.OpenNextTask(gstate, bind_data)) {
+      output.SetCardinality(0);
+      return;
+    }
+    if (gstate.series) {
+      AddGribSeriesSteps(gstate, lstate, bind_data);
+      continue;
+    }
+    auto &wide = *lstate.wide_reader;
+    idx_t size = h3 ? lstate.h3_aggregate.Size() : wide.Size();
+    if (lstate.wide_offset >= size) {
+      lstate.wide_offset = 0;
+      if (!wide.NextGroup()) {
+        lstate.CloseFile();
+        gstate.completed_tasks++;
+        continue;
+      }
+      if (h3) {
+        lstate.h3_aggregate.Aggregate(*lstate.context_ptr, wide,
+                                      *bind_data.h3_cells);
+      }
+      continue;
+    }
+
+    idx_t count = MinValue(batch_size, size - lstate.wide_offset);
+    if (h3) {
+      WriteGribH3Rows(wide, lstate.h3_aggregate, lstate.wide_offset, count,
+                      gstate, lstate.file_idx, output);
+    } else {
+      WriteGribWideRows(wide, lstate.wide_offset, count, gstate,
+                        lstate.file_idx, output);
+    }
+    WriteGribPartitionColumns(bind_data, gstate, lstate.file_idx, output);
+    lstate.wide_offset += count;
+    lstate.task_rows += count;
+    gstate.rows_returned += count;
+    return;
+  }
+}
+
+static void GribScan(ClientContext &context, TableFunctionInput &data,
+                     DataChunk &output) {
+  auto &gstate = data.global_state->Cast<GribGlobalState>();
+  auto &lstate = data.local_state->Cast<GribLocalState>();
+  auto &bind_data = data.bind_data->Cast<GribBindData>();
+
+  if (lstate.reader && lstate.RowBudget(bind_data) == 0) {
+    lstate.CloseFile();
+    gstate.completed_tasks++;
+  }
+  idx_t batch_size = lstate.RowBudget(bind_data);
+
+  if (bind_data.wide) {
+    GribWideScan(gstate, lstate, bind_data, batch_size, output);
+    return;
+  }
+
+  Grib2ColumnarBatch batch = {0, 0, false, nullptr};
+  while (batch.count == 0) {
+    if (!lstate.reader) {
+      if (!lstate.OpenNextTask(gstate, bind_data)) {
+        output.SetCardinality(0);
+        return;
+      }
+    }
+
+    batch = ReadCountedGribColumns(lstate.reader, output, gstate.column_ids,
+                                   lstate.runs, batch_size, *gstate.metrics,
+                                   lstate.last_message);
+    if (batch.count == 0) {
+      lstate.CloseFile();
+      gstate.completed_tasks++;
+    }
+  }
+
+  WriteGribRuns(batch, lstate.runs.data(), output, gstate.column_ids,
+                lstate.file_idx);
+  WriteGribPartitionColumns(bind_data, gstate, lstate.file_idx, output);
+  lstate.task_rows += batch.count;
+  gstate.rows_returned += batch.count;
+}
+
+static OperatorPartitionData
+GribGetPartitionData(ClientContext &context,
+                     TableFunctionGetPartitionInput &input) {
+  if (input.partition_info.RequiresPartitionColumns()) {
+    throw InternalException("read_grib does not support partition columns");
+  }
+  auto &lstate = input.local_state->Cast<GribLocalState>();
+  return OperatorPartitionData(lstate.batch_index);
+}
+
+static double GribProgress(ClientContext &context,
+                           const FunctionData *bind_data_p,
+                           const GlobalTableFunctionState *gstate_p) {
+  auto &state = gstate_p->Cast<GribGlobalState>();
+
+  if (state.tasks.empty())
+    return -1.0;
+  double task_progress = static_cast<double>(state.completed_tasks.load()) /
+                         static_cast<double>(state.tasks.size());
+  return task_progress * 100.0;
+}
+
+// ============================================================================
+// In-out table function (for LATERAL joins)
+// ============================================================================
+
+struct GribInOutGlobalState : public GlobalTableFunctionState {
+  // In-out functions have no projection pushdown: all columns, in order
+  vector<column_t> column_ids;
+  shared_ptr<WeatherScanMetrics> metrics;
+
+  idx_t MaxThreads() const override {
+    return GlobalTableFunctionState::MAX_THREADS;
+  }
+};
+
+struct GribInOutLocalState : public LocalTableFunctionState {
+  Grib2Reader *reader = nullptr;
+  string http_data;
+  ClientContext *context_ptr = nullptr;
+  shared_ptr<WeatherScanMetrics> metrics;
+  uint32_t last_message = GRIB_NO_MESSAGE;
+  vector<Grib2MessageRun> runs =
+      vector<Grib2MessageRun>(STANDARD_VECTOR_SIZE);
+
+  // Sources of the current input: local files, and a remote path that has
+  // no other to download alongside, are opened in row order on this thread.
+  // Other remote paths are downloaded by the pool and decoded as they
+  // arrive. The LATERAL form starts the sources of each input chunk, the
+  // table form collects the whole input first
+  bool chunk_started = false;
+  vector<string> direct_paths;
+  vector<string> remote_paths; // Pool URLs, by url_idx
+  idx_t next_direct = 0;
+  unique_ptr<WeatherFetchPool> pool;
+  // Path of the open source, for the path column of the table form
+  string source_path;
+
+  ~GribInOutLocalState() { CloseSource(); }
+
+  void CloseSource() {
+    last_message = GRIB_NO_MESSAGE;
+    if (reader) {
+      grib2_close(reader);
+      reader = nullptr;
+    }
+    metrics->ReleaseBuffered(http_data.size());
+    http_data.clear();
+  }
+
+  void Reset() {
+    CloseSource();
+    chunk_started = false;
+    direct_paths.clear();
+    remote_paths.clear();
+    next_direct = 0;
+    pool.reset();
+  }
+
+  // Collect the paths of an input chunk
+  void AddPaths(DataChunk &input) {
+    for (idx_t i = 0; i < input.size(); i++) {
+      auto value = input.GetValue(0, i);
+      if (value.IsNull()) {
+        continue;
+      }
+      auto path = value.ToString();
+      if (IsHttpUrl(path)) {
+        remote_paths.push_back(std::move(path));
+      } else {
+        direct_paths.push_back(std::move(path));
+      }
+    }
+  }
+
+  // Start the downloads of the collected remote paths. The LATERAL form
+  // passes one row per call, whose path is fetched on this thread instead
+  // of starting pool threads for it.
+  void StartSources() {
+    chunk_started = true;
+    if (remote_paths.size() == 1) {
+      direct_paths.push_back(std::move(remote_paths[0]));
+    } else if (!remote_paths.empty()) {
+      pool = make_uniq<WeatherFetchPool>(
+          *context_ptr, remote_paths, GetGfsMaxDownloads(*context_ptr),
+          HTTPHeaders(), WeatherCachePolicy::IMMUTABLE, metrics);
+      return;
+    }
+    remote_paths.clear();
+  }
+
+  // Open the next collected source; false when all have been read
+  bool OpenNextSource() {
+    CloseSource();
+    try {
+      if (next_direct < direct_paths.size()) {
+        source_path = direct_paths[next_direct++];
+        reader = OpenGribSource(*context_ptr, source_path, http_data, 0, 0,
+                                nullptr, metrics.get());
+        metrics->AddBuffered(http_data.size());
+        return true;
+      }
+      WeatherFetchResult result;
+      if (!pool || !pool->Next(result)) {
+        return false;
+      }
+      if (!result.error.empty()) {
+        throw IOException(result.error);
+      }
+      source_path = remote_paths[result.url_idx];
+      http_data = std::move(result.body);
+      reader = OpenGribBuffer(http_data);
+      return true;
+    } catch (Exception &e) {
+      throw IOException("Failed to open GRIB source in LATERAL: " +
+                        string(e.what()));
+    }
+  }
+};
 
 static unique_ptr<FunctionData> GribInOutBind(ClientContext &context,
                                               TableFunctionBindInput &input,
                                               vector<LogicalType> &return_types,
                                               vector<string> &names) {
+  auto &input_types = input.input_table_types;
+  if (input_types.empty() || input_types[0].id() != LogicalTypeId::VARCHAR) {
+    throw InvalidInputException(
+        "read_grib_lateral() input must start with a VARCHAR path column");
+  }
+
   auto bind_data = make_uniq<GribBindData>();
   CreateEnumTypes(*bind_data);
 
@@ -659,9 +3063,25 @@ static unique_ptr<FunctionData> GribInOutBind(ClientContext &context,
   return std::move(bind_data);
 }
 
+// The table form interleaves the rows of many sources, so it adds the path
+// each row was read from
+static unique_ptr<FunctionData>
+GribInOutTableBind(ClientContext &context, TableFunctionBindInput &input,
+                   vector<LogicalType> &return_types, vector<string> &names) {
+  auto bind_data = GribInOutBind(context, input, return_types, names);
+  names.push_back("path");
+  return_types.push_back(LogicalType::VARCHAR);
+  return bind_data;
+}
+
 static unique_ptr<GlobalTableFunctionState>
 GribInOutInitGlobal(ClientContext &context, TableFunctionInitInput &input) {
-  return make_uniq<GribInOutGlobalState>();
+  auto state = make_uniq<GribInOutGlobalState>();
+  state->metrics = RegisterWeatherScan(context, "read_grib_lateral");
+  for (column_t col = 0; col < GRIB_COL_FILE_INDEX; col++) {
+    state->column_ids.push_back(col);
+  }
+  return std::move(state);
 }
 
 static unique_ptr<LocalTableFunctionState>
@@ -669,93 +3089,838 @@ GribInOutInitLocal(ExecutionContext &context, TableFunctionInitInput &input,
                    GlobalTableFunctionState *global_state) {
   auto state = make_uniq<GribInOutLocalState>();
   state->context_ptr = &context.client;
+  state->metrics = global_state->Cast<GribInOutGlobalState>().metrics;
   return std::move(state);
 }
 
+// Fill output with rows of the next collected source; false once every
+// source has been read. Each output chunk holds rows of a single source
+static bool ReadNextGribInOutChunk(GribInOutGlobalState &gstate,
+                                   GribInOutLocalState &lstate,
+                                   DataChunk &output) {
+  while (true) {
+    if (!lstate.reader && !lstate.OpenNextSource()) {
+      lstate.Reset();
+      output.SetCardinality(0);
+      return false;
+    }
+
+    auto batch = ReadCountedGribColumns(
+        lstate.reader, output, gstate.column_ids, lstate.runs,
+        STANDARD_VECTOR_SIZE, *gstate.metrics, lstate.last_message);
+    if (batch.count == 0) {
+      lstate.CloseSource();
+      continue;
+    }
+
+    WriteGribRuns(batch, lstate.runs.data(), output, gstate.column_ids, 0);
+    if (output.ColumnCount() > gstate.column_ids.size()) {
+      auto &path = output.data[gstate.column_ids.size()];
+      path.SetVectorType(VectorType::CONSTANT_VECTOR);
+      ConstantVector::GetData<string_t>(path)[0] =
+          StringVector::AddString(path, lstate.source_path);
+    }
+    if (!batch.has_more) {
+      lstate.CloseSource();
+    }
+    return true;
+  }
+}
+
+// LATERAL form: the sources of each input chunk, which DuckDB passes one
+// correlated row at a time
 static OperatorResultType GribInOutFunction(ExecutionContext &context,
                                             TableFunctionInput &data,
                                             DataChunk &input,
                                             DataChunk &output) {
-  auto &bind_data = data.bind_data->Cast<GribBindData>();
+  auto &gstate = data.global_state->Cast<GribInOutGlobalState>();
+  auto &lstate = data.local_state->Cast<GribInOutLocalState>();
+
+  if (!lstate.chunk_started) {
+    lstate.AddPaths(input);
+    lstate.StartSources();
+  }
+  if (ReadNextGribInOutChunk(gstate, lstate, output)) {
+    return OperatorResultType::HAVE_MORE_OUTPUT;
+  }
+  return OperatorResultType::NEED_MORE_INPUT;
+}
+
+// Table form: collect the paths of every input chunk; rows come out in the
+// final phase, with the whole input downloaded through one pool
+static OperatorResultType GribInOutTableFunction(ExecutionContext &context,
+                                                 TableFunctionInput &data,
+                                                 DataChunk &input,
+                                                 DataChunk &output) {
+  auto &lstate = data.local_state->Cast<GribInOutLocalState>();
+  lstate.AddPaths(input);
+  output.SetCardinality(0);
+  return OperatorResultType::NEED_MORE_INPUT;
+}
+
+static OperatorFinalizeResultType
+GribInOutTableFinal(ExecutionContext &context, TableFunctionInput &data,
+                    DataChunk &output) {
+  auto &gstate = data.global_state->Cast<GribInOutGlobalState>();
   auto &lstate = data.local_state->Cast<GribInOutLocalState>();
 
-  // Initialize reader from input if not done
-  if (!lstate.initialized) {
-    // Get URL/path from input (first column)
-    auto &input_vector = input.data[0];
-    if (input.size() == 0) {
-      return OperatorResultType::NEED_MORE_INPUT;
+  if (!lstate.chunk_started) {
+    lstate.StartSources();
+  }
+  if (ReadNextGribInOutChunk(gstate, lstate, output)) {
+    return OperatorFinalizeResultType::HAVE_MORE_OUTPUT;
+  }
+  return OperatorFinalizeResultType::FINISHED;
+}
+
+// ============================================================================
+// Point sampling: grib_sample(path, points)
+// ============================================================================
+
+struct GribSampleBindData : public TableFunctionData {
+  string path;
+  bool bilinear = false;
+  LogicalType discipline_type;
+  LogicalType surface_type;
+  LogicalType parameter_type;
+  // Types of the point columns after latitude and longitude, passed through
+  vector<LogicalType> extra_types;
+};
+
+// Points of every thread are pooled here as threads finish their input. The
+// thread that finishes last samples the pool, so the source is read and each
+// message unpacked once per query. A local state created after that finds
+// the input exhausted and sampled set, and emits nothing.
+struct GribSampleGlobalState : public GlobalTableFunctionState {
+  vector<column_t> column_ids;
+
+  std::mutex lock;
+  vector<double> latitudes;
+  vector<double> longitudes;
+  // The passed-through columns, one row per pooled point
+  unique_ptr<ColumnDataCollection> extras;
+  idx_t active_threads = 0;
+  bool sampled = false;
+
+  idx_t MaxThreads() const override {
+    return GlobalTableFunctionState::MAX_THREADS;
+  }
+};
+
+struct GribSampleLocalState : public LocalTableFunctionState {
+  ClientContext *context_ptr = nullptr;
+  vector<double> latitudes;
+  vector<double> longitudes;
+  unique_ptr<ColumnDataCollection> extras;
+  // The emitter scans extras once per message, a chunk per output chunk
+  ColumnDataScanState extras_scan;
+  DataChunk extras_chunk;
+  // Set once the points went to the pool; emitter when this thread samples
+  bool pooled = false;
+  bool emitter = false;
+
+  Grib2Reader *reader = nullptr;
+  string http_data;
+  idx_t message_count = 0;
+  idx_t next_message = 0;
+  Grib2MessageInfo info = {};
+  vector<double> samples; // Of the current message
+  idx_t sample_offset = 0;
+
+  ~GribSampleLocalState() {
+    if (reader) {
+      grib2_close(reader);
+    }
+  }
+};
+
+static unique_ptr<FunctionData>
+GribSampleBind(ClientContext &context, TableFunctionBindInput &input,
+               vector<LogicalType> &return_types, vector<string> &names) {
+  auto bind_data = make_uniq<GribSampleBindData>();
+  if (input.inputs[0].IsNull()) {
+    throw InvalidInputException("grib_sample() requires a file path or URL");
+  }
+  bind_data->path = input.inputs[0].GetValue<string>();
+
+  auto &input_types = input.input_table_types;
+  if (input_types.size() < 2 || !input_types[0].IsNumeric() ||
+      !input_types[1].IsNumeric()) {
+    throw InvalidInputException(
+        "grib_sample() points must start with numeric latitude and "
+        "longitude columns");
+  }
+
+  for (auto &kv : input.named_parameters) {
+    if (kv.first == "method") {
+      auto method = StringUtil::Lower(kv.second.ToString());
+      if (method == "bilinear") {
+        bind_data->bilinear = true;
+      } else if (method != "nearest") {
+        throw InvalidInputException(
+            "grib_sample() method must be 'nearest' or 'bilinear', got '%s'",
+            method);
+      }
+    }
+  }
+
+  GribBindData types;
+  CreateEnumTypes(types);
+  bind_data->discipline_type = types.discipline_type;
+  bind_data->surface_type = types.surface_type;
+  bind_data->parameter_type = types.parameter_type;
+
+  // Same columns as read_grib_lateral(), latitude/longitude are the points
+  names = {"latitude",      "longitude",     "value",
+           "discipline",    "surface",       "parameter",
+           "forecast_time", "surface_value", "message_index"};
+  return_types = {LogicalType::DOUBLE,     LogicalType::DOUBLE,
+                  LogicalType::DOUBLE,     types.discipline_type,
+                  types.surface_type,      types.parameter_type,
+                  LogicalType::BIGINT,     LogicalType::DOUBLE,
+                  LogicalType::UINTEGER};
+  // Followed by the other point columns, such as a station id to join on.
+  // Names taken by the columns above get an input_ prefix.
+  case_insensitive_set_t taken(names.begin(), names.end());
+  for (idx_t col = 2; col < input_types.size(); col++) {
+    auto name = input.input_table_names[col];
+    while (taken.count(name)) {
+      name = "input_" + name;
+    }
+    taken.insert(name);
+    names.push_back(name);
+    return_types.push_back(input_types[col]);
+    bind_data->extra_types.push_back(input_types[col]);
+  }
+  return std::move(bind_data);
+}
+
+static unique_ptr<GlobalTableFunctionState>
+GribSampleInitGlobal(ClientContext &context, TableFunctionInitInput &input) {
+  auto &bind_data = input.bind_data->Cast<GribSampleBindData>();
+  auto state = make_uniq<GribSampleGlobalState>();
+  for (column_t col = 0; col < GRIB_COL_FILE_INDEX; col++) {
+    state->column_ids.push_back(col);
+  }
+  if (!bind_data.extra_types.empty()) {
+    state->extras =
+        make_uniq<ColumnDataCollection>(context, bind_data.extra_types);
+  }
+  return std::move(state);
+}
+
+static unique_ptr<LocalTableFunctionState>
+GribSampleInitLocal(ExecutionContext &context, TableFunctionInitInput &input,
+                    GlobalTableFunctionState *global_state) {
+  auto &gstate = global_state->Cast<GribSampleGlobalState>();
+  {
+    std::lock_guard<std::mutex> guard(gstate.lock);
+    gstate.active_threads++;
+  }
+  auto &bind_data = input.bind_data->Cast<GribSampleBindData>();
+  auto state = make_uniq<GribSampleLocalState>();
+  state->context_ptr = &context.client;
+  if (!bind_data.extra_types.empty()) {
+    state->extras = make_uniq<ColumnDataCollection>(context.client,
+                                                    bind_data.extra_types);
+  }
+  return std::move(state);
+}
+
+// Collect the points of an input chunk; rows come out in the final phase
+static OperatorResultType GribSampleFunction(ExecutionContext &context,
+                                             TableFunctionInput &data,
+                                             DataChunk &input,
+                                             DataChunk &output) {
+  auto &lstate = data.local_state->Cast<GribSampleLocalState>();
+  SelectionVector points(STANDARD_VECTOR_SIZE);
+  idx_t point_count = 0;
+  for (idx_t i = 0; i < input.size(); i++) {
+    auto lat = input.GetValue(0, i);
+    auto lon = input.GetValue(1, i);
+    if (lat.IsNull() || lon.IsNull()) {
+      continue;
+    }
+    lstate.latitudes.push_back(lat.GetValue<double>());
+    lstate.longitudes.push_back(lon.GetValue<double>());
+    points.set_index(point_count++, i);
+  }
+  if (lstate.extras && point_count > 0) {
+    DataChunk extras;
+    extras.InitializeEmpty(lstate.extras->Types());
+    for (idx_t col = 0; col < extras.ColumnCount(); col++) {
+      extras.data[col].Slice(input.data[2 + col], points, point_count);
+    }
+    extras.SetCardinality(point_count);
+    lstate.extras->Append(extras);
+  }
+  output.SetCardinality(0);
+  return OperatorResultType::NEED_MORE_INPUT;
+}
+
+// Emit one message's samples per call until every message has been sampled
+static OperatorFinalizeResultType
+GribSampleFinal(ExecutionContext &context, TableFunctionInput &data,
+                DataChunk &output) {
+  auto &gstate = data.global_state->Cast<GribSampleGlobalState>();
+  auto &lstate = data.local_state->Cast<GribSampleLocalState>();
+  auto &bind_data = data.bind_data->Cast<GribSampleBindData>();
+  if (!lstate.pooled) {
+    // A thread only gets here once the shared input is exhausted, so when
+    // no other thread is still collecting the pool is complete
+    std::lock_guard<std::mutex> guard(gstate.lock);
+    lstate.pooled = true;
+    gstate.latitudes.insert(gstate.latitudes.end(), lstate.latitudes.begin(),
+                            lstate.latitudes.end());
+    gstate.longitudes.insert(gstate.longitudes.end(),
+                             lstate.longitudes.begin(),
+                             lstate.longitudes.end());
+    lstate.latitudes.clear();
+    lstate.longitudes.clear();
+    if (lstate.extras) {
+      gstate.extras->Combine(*lstate.extras);
+      lstate.extras.reset();
+    }
+    if (--gstate.active_threads == 0 && !gstate.sampled) {
+      gstate.sampled = true;
+      lstate.emitter = true;
+      lstate.latitudes = std::move(gstate.latitudes);
+      lstate.longitudes = std::move(gstate.longitudes);
+      lstate.extras = std::move(gstate.extras);
+      if (lstate.extras) {
+        lstate.extras->InitializeScanChunk(lstate.extras_chunk);
+      }
     }
+  }
+  idx_t point_count = lstate.latitudes.size();
+  if (!lstate.emitter || point_count == 0) {
+    output.SetCardinality(0);
+    return OperatorFinalizeResultType::FINISHED;
+  }
 
-    // Handle NULL input
-    if (FlatVector::IsNull(input_vector, 0)) {
-      lstate.initialized = true;
+  if (!lstate.reader) {
+    lstate.reader =
+        OpenGribSource(*lstate.context_ptr, bind_data.path, lstate.http_data);
+    lstate.message_count = grib2_message_count(lstate.reader);
+    lstate.sample_offset = point_count;
+  }
+
+  if (lstate.sample_offset >= point_count) {
+    if (lstate.next_message >= lstate.message_count) {
+      output.SetCardinality(0);
+      return OperatorFinalizeResultType::FINISHED;
+    }
+    idx_t message = lstate.next_message++;
+    if (!grib2_message_info(lstate.reader, message, &lstate.info)) {
       output.SetCardinality(0);
-      return OperatorResultType::NEED_MORE_INPUT;
+      return OperatorFinalizeResultType::HAVE_MORE_OUTPUT;
+    }
+    lstate.samples.resize(point_count);
+    char *error = nullptr;
+    if (!grib2_sample_message(lstate.reader, message, lstate.latitudes.data(),
+                              lstate.longitudes.data(), point_count,
+                              bind_data.bilinear, lstate.samples.data(),
+                              &error)) {
+      string error_msg = error ? error : "Unknown error";
+      if (error)
+        grib2_free_error(error);
+      throw IOException("grib_sample() failed: " + error_msg);
+    }
+    lstate.sample_offset = 0;
+    if (lstate.extras) {
+      lstate.extras->InitializeScan(lstate.extras_scan);
+    }
+  }
+
+  // The passed-through columns come in the chunks of the collection, which
+  // then set the size of the output chunk
+  idx_t offset = lstate.sample_offset;
+  idx_t count = MinValue<idx_t>(STANDARD_VECTOR_SIZE, point_count - offset);
+  if (lstate.extras) {
+    if (!lstate.extras->Scan(lstate.extras_scan, lstate.extras_chunk)) {
+      throw InternalException("grib_sample() has fewer extra rows than points");
+    }
+    count = lstate.extras_chunk.size();
+    for (idx_t col = 0; col < lstate.extras_chunk.ColumnCount(); col++) {
+      output.data[gstate.column_ids.size() + col].Reference(
+          lstate.extras_chunk.data[col]);
+    }
+  }
+  memcpy(FlatVector::GetData<double>(output.data[GRIB_COL_LATITUDE]),
+         lstate.latitudes.data() + offset, count * sizeof(double));
+  memcpy(FlatVector::GetData<double>(output.data[GRIB_COL_LONGITUDE]),
+         lstate.longitudes.data() + offset, count * sizeof(double));
+  // Points outside the grid or next to missing values are NULL
+  auto values = FlatVector::GetData<double>(output.data[GRIB_COL_VALUE]);
+  auto &validity = FlatVector::Validity(output.data[GRIB_COL_VALUE]);
+  for (idx_t i = 0; i < count; i++) {
+    values[i] = lstate.samples[offset + i];
+    if (std::isnan(values[i])) {
+      validity.SetInvalid(i);
     }
+  }
 
-    auto path = FlatVector::GetData<string_t>(input_vector)[0].GetString();
+  Grib2MessageRun run = {0,
+                         count,
+                         lstate.info.forecast_time,
+                         lstate.info.surface_value,
+                         lstate.info.message_index,
+                         lstate.info.discipline,
+                         lstate.info.parameter_category,
+                         lstate.info.parameter_number,
+                         lstate.info.surface_type};
+  Grib2ColumnarBatch batch = {count, 1, false, nullptr};
+  WriteGribRuns(batch, &run, output, gstate.column_ids, 0);
+  lstate.sample_offset += count;
+  return OperatorFinalizeResultType::HAVE_MORE_OUTPUT;
+}
 
-    try {
-      lstate.reader =
-          OpenGribSource(*lstate.context_ptr, path, lstate.http_data);
-    } catch (Exception &e) {
-      throw IOException("Failed to open GRIB source in LATERAL: " +
-                        string(e.what()));
+// ============================================================================
+// GRIB to Parquet export
+// ============================================================================
+
+struct GribToParquetBindData : public TableFunctionData {
+  string source;
+  string target;
+  bool keep_coordinates = false;
+};
+
+struct GribToParquetGlobalState : public GlobalTableFunctionState {
+  bool finished = false;
+};
+
+static unique_ptr<FunctionData>
+GribToParquetBind(ClientContext &context, TableFunctionBindInput &input,
+                  vector<LogicalType> &return_types, vector<string> &names) {
+  auto bind_data = make_uniq<GribToParquetBindData>();
+  if (input.inputs[0].IsNull() || input.inputs[1].IsNull()) {
+    throw InvalidInputException(
+        "grib_to_parquet() requires a source and a target path");
+  }
+  bind_data->source = input.inputs[0].GetValue<string>();
+  bind_data->target = input.inputs[1].GetValue<string>();
+  for (auto &kv : input.named_parameters) {
+    if (kv.first == "keep_coordinates") {
+      bind_data->keep_coordinates = BooleanValue::Get(kv.second);
     }
-    lstate.initialized = true;
   }
 
-  // Read batch
-  Grib2Batch batch = grib2_read_batch(lstate.reader, STANDARD_VECTOR_SIZE);
+  names = {"target", "rows", "row_group_size", "grid"};
+  return_types = {LogicalType::VARCHAR, LogicalType::BIGINT,
+                  LogicalType::UBIGINT, LogicalType::VARCHAR};
+  return std::move(bind_data);
+}
 
-  if (batch.error) {
-    string error_msg = batch.error;
-    grib2_free_batch(batch);
-    throw IOException("Error reading GRIB data: " + error_msg);
+static unique_ptr<GlobalTableFunctionState>
+GribToParquetInitGlobal(ClientContext &context, TableFunctionInitInput &input) {
+  return make_uniq<GribToParquetGlobalState>();
+}
+
+// JSON description of a message's grid, stored in the Parquet footer so
+// that grid_index can be mapped back to coordinates
+static string GribGridDefinition(const Grib2GridInfo &grid,
+                                 idx_t num_points) {
+  if (!grid.regular) {
+    return StringUtil::Format("{\"template\": %d, \"points\": %d}",
+                              grid.template_number, num_points);
+  }
+  return StringUtil::Format(
+      "{\"template\": %d, \"points\": %d, \"ni\": %d, \"nj\": %d, "
+      "\"lat1\": %s, \"lon1\": %s, \"di\": %s, \"dj\": %s}",
+      grid.template_number, num_points, grid.ni, grid.nj,
+      Value::DOUBLE(grid.lat1).ToString(), Value::DOUBLE(grid.lon1).ToString(),
+      Value::DOUBLE(grid.di).ToString(), Value::DOUBLE(grid.dj).ToString());
+}
+
+// DuckDB's Parquet writer, bound to the export columns. Driven through its
+// batch interface in the caller's context, so that each prepared batch
+// becomes exactly one row group.
+struct GribParquetWriter {
+  CopyFunction function;
+  unique_ptr<FunctionData> bind_data;
+  unique_ptr<GlobalFunctionData> global_state;
+};
+
+static GribParquetWriter OpenGribParquetWriter(
+    ClientContext &context, const string &target, const string &source,
+    const string &grid_definition, idx_t num_points,
+    const vector<string> &names, const vector<LogicalType> &types) {
+  auto entry = Catalog::GetEntry<CopyFunctionCatalogEntry>(
+      context, INVALID_CATALOG, DEFAULT_SCHEMA, "parquet",
+      OnEntryNotFound::RETURN_NULL);
+  if (!entry) {
+    ExtensionHelper::TryAutoLoadExtension(context, "parquet");
+    entry = Catalog::GetEntry<CopyFunctionCatalogEntry>(
+        context, INVALID_CATALOG, DEFAULT_SCHEMA, "parquet",
+        OnEntryNotFound::RETURN_NULL);
+  }
+  if (!entry || !entry->function.copy_to_bind ||
+      !entry->function.prepare_batch || !entry->function.flush_batch) {
+    throw InvalidInputException(
+        "grib_to_parquet() requires the parquet extension");
+  }
+
+  GribParquetWriter writer;
+  writer.function = entry->function;
+  CopyInfo info;
+  info.format = "parquet";
+  info.file_path = target;
+  info.options["row_group_size"] = {Value::UBIGINT(num_points)};
+  info.options["kv_metadata"] = {Value::STRUCT(
+      {{"grib_grid", Value(grid_definition)}, {"grib_source", Value(source)}})};
+  CopyFunctionBindInput input(info);
+  writer.bind_data =
+      writer.function.copy_to_bind(context, input, names, types);
+  writer.global_state = writer.function.copy_to_initialize_global(
+      context, *writer.bind_data, target);
+  return writer;
+}
+
+// Closes a reader on every way out of a scope
+struct GribReaderGuard {
+  Grib2Reader *reader;
+  ~GribReaderGuard() {
+    if (reader) {
+      grib2_close(reader);
+    }
   }
+};
 
-  if (batch.count == 0) {
-    grib2_free_batch(batch);
-    lstate.Reset();
+// Export one GRIB source to Parquet with one row group per message. Points
+// are stored by grid_index; the grid definition shared by the messages goes
+// into the file metadata. Grids other than regular lat/lon keep coordinates.
+// The file is written next to the target and moved into place once
+// complete, so a failed export leaves no truncated file behind.
+static void GribToParquetScan(ClientContext &context, TableFunctionInput &data,
+                              DataChunk &output) {
+  auto &gstate = data.global_state->Cast<GribToParquetGlobalState>();
+  auto &bind_data = data.bind_data->Cast<GribToParquetBindData>();
+  if (gstate.finished) {
     output.SetCardinality(0);
-    return OperatorResultType::NEED_MORE_INPUT;
+    return;
+  }
+  gstate.finished = true;
+
+  // grid_index maps to coordinates through one grid definition, so every
+  // message must share the grid. The source is read once; remote bodies
+  // stay in http_data until the reader is closed.
+  string http_data;
+  GribReaderGuard guard = {
+      OpenGribSource(context, bind_data.source, http_data)};
+  auto reader = guard.reader;
+  Grib2MessageInfo info;
+  Grib2GridInfo grid;
+  idx_t message_count = grib2_message_count(reader);
+  bool found = grib2_message_info(reader, 0, &info) &&
+               grib2_grid_info(reader, 0, &grid);
+  for (idx_t i = 1; found && i < message_count; i++) {
+    Grib2MessageInfo other_info;
+    Grib2GridInfo other = {};
+    if (!grib2_message_info(reader, i, &other_info) ||
+        !grib2_grid_info(reader, i, &other)) {
+      continue;
+    }
+    if (!GribSameGrid(grid, info.num_points, other, other_info.num_points)) {
+      throw InvalidInputException(
+          "grib_to_parquet() needs every message on one grid, but message "
+          "%d of %s has %d points on a different grid than message 0 (%d "
+          "points); export it with COPY (SELECT ... FROM read_grib(...)) "
+          "instead",
+          i, bind_data.source, other_info.num_points, info.num_points);
+    }
+  }
+  if (!found || info.num_points == 0) {
+    throw IOException("GRIB source has no messages: " + bind_data.source);
+  }
+  auto grid_definition = GribGridDefinition(grid, info.num_points);
+
+  GribBindData types;
+  CreateEnumTypes(types);
+  vector<string> names = {"parameter",     "surface",    "surface_value",
+                          "forecast_time", "discipline", "message_index",
+                          "grid_index",    "value"};
+  vector<LogicalType> column_types = {
+      types.parameter_type,  types.surface_type,    LogicalType::DOUBLE,
+      LogicalType::BIGINT,   types.discipline_type, LogicalType::UINTEGER,
+      LogicalType::UINTEGER, LogicalType::DOUBLE};
+  vector<column_t> column_ids = {
+      GRIB_COL_PARAMETER,     GRIB_COL_SURFACE,       GRIB_COL_SURFACE_VALUE,
+      GRIB_COL_FORECAST_TIME, GRIB_COL_DISCIPLINE,    GRIB_COL_MESSAGE_INDEX,
+      GRIB_COL_GRID_INDEX,    GRIB_COL_VALUE};
+  bool coordinates = bind_data.keep_coordinates || !grid.regular;
+  if (coordinates) {
+    names.insert(names.end(), {"latitude", "longitude"});
+    column_types.insert(column_types.end(),
+                        {LogicalType::DOUBLE, LogicalType::DOUBLE});
+    column_ids.insert(column_ids.end(),
+                      {GRIB_COL_LATITUDE, GRIB_COL_LONGITUDE});
+  }
+  grib2_set_decode_coordinates(reader, coordinates);
+
+  auto &fs = FileSystem::GetFileSystem(context);
+  auto tmp_path = bind_data.target + ".tmp";
+  idx_t rows = 0;
+  try {
+    auto writer =
+        OpenGribParquetWriter(context, tmp_path, bind_data.source,
+                              grid_definition, info.num_points, names,
+                              column_types);
+    vector<double> values(info.num_points);
+    vector<uint32_t> grid_indices(info.num_points);
+    vector<double> latitudes(coordinates ? info.num_points : 0);
+    vector<double> longitudes(coordinates ? info.num_points : 0);
+    Grib2ColumnBuffers buffers = {
+        coordinates ? latitudes.data() : nullptr,
+        coordinates ? longitudes.data() : nullptr,
+        values.data(),
+        grid_indices.data(),
+        nullptr,
+        0,
+        nullptr,
+        nullptr,
+        nullptr};
+    DataChunk chunk;
+    chunk.Initialize(context, column_types);
+    for (idx_t message = 0; message < message_count; message++) {
+      if (!grib2_message_info(reader, message, &info)) {
+        continue;
+      }
+      auto batch =
+          grib2_read_message(reader, message, &buffers, values.size());
+      if (batch.error) {
+        string error_msg = batch.error;
+        grib2_free_error(batch.error);
+        throw IOException("Error reading GRIB data: " + error_msg);
+      }
+
+      // Every message is prepared and flushed as a batch of its own, which
+      // the writer turns into one row group
+      auto collection =
+          make_uniq<ColumnDataCollection>(context, column_types);
+      for (idx_t offset = 0; offset < batch.count;
+           offset += STANDARD_VECTOR_SIZE) {
+        idx_t count =
+            MinValue<idx_t>(STANDARD_VECTOR_SIZE, batch.count - offset);
+        chunk.Reset();
+        Grib2MessageRun run = {0,
+                               count,
+                               info.forecast_time,
+                               info.surface_value,
+                               info.message_index,
+                               info.discipline,
+                               info.parameter_category,
+                               info.parameter_number,
+                               info.surface_type};
+        Grib2ColumnarBatch chunk_batch = {count, 1, false, nullptr};
+        WriteGribRuns(chunk_batch, &run, chunk, column_ids, 0);
+        memcpy(FlatVector::GetData<uint32_t>(chunk.data[6]),
+               grid_indices.data() + offset, count * sizeof(uint32_t));
+        memcpy(FlatVector::GetData<double>(chunk.data[7]),
+               values.data() + offset, count * sizeof(double));
+        if (coordinates) {
+          memcpy(FlatVector::GetData<double>(chunk.data[8]),
+                 latitudes.data() + offset, count * sizeof(double));
+          memcpy(FlatVector::GetData<double>(chunk.data[9]),
+                 longitudes.data() + offset, count * sizeof(double));
+        }
+        collection->Append(chunk);
+      }
+      if (collection->Count() == 0) {
+        continue;
+      }
+      rows += collection->Count();
+      auto prepared = writer.function.prepare_batch(
+          context, *writer.bind_data, *writer.global_state,
+          std::move(collection));
+      writer.function.flush_batch(context, *writer.bind_data,
+                                  *writer.global_state, *prepared);
+    }
+    writer.function.copy_to_finalize(context, *writer.bind_data,
+                                     *writer.global_state);
+    writer.global_state.reset();
+    fs.MoveFile(tmp_path, bind_data.target);
+  } catch (...) {
+    // The writer and its file handle were destroyed leaving the try block
+    if (fs.FileExists(tmp_path)) {
+      fs.RemoveFile(tmp_path);
+    }
+    throw;
+  }
+
+  output.SetValue(0, 0, Value(bind_data.target));
+  output.SetValue(1, 0, Value::BIGINT(NumericCast<int64_t>(rows)));
+  output.SetValue(2, 0, Value::UBIGINT(info.num_points));
+  output.SetValue(3, 0, Value(grid_definition));
+  output.SetCardinality(1);
+}
+
+// ============================================================================
+// Message inventory: grib_inventory(path, write_index := false)
+// ============================================================================
+
+struct GribInventoryBindData : public TableFunctionData {
+  string path;
+  bool write_index = false;
+  LogicalType discipline_type;
+  LogicalType surface_type;
+  LogicalType parameter_type;
+};
+
+struct GribInventoryGlobalState : public GlobalTableFunctionState {
+  bool loaded = false;
+  vector<Grib2MessageLocation> locations; // Per GRIB message
+  vector<Grib2MessageInfo> messages;      // Per submessage
+  idx_t offset = 0;
+};
+
+static unique_ptr<FunctionData>
+GribInventoryBind(ClientContext &context, TableFunctionBindInput &input,
+                  vector<LogicalType> &return_types, vector<string> &names) {
+  auto bind_data = make_uniq<GribInventoryBindData>();
+  if (input.inputs[0].IsNull()) {
+    throw InvalidInputException("grib_inventory() requires a file path");
+  }
+  bind_data->path = input.inputs[0].GetValue<string>();
+  if (!IsLocalPath(bind_data->path)) {
+    throw InvalidInputException(
+        "grib_inventory() reads local files; remote files publish their "
+        "inventory as <url>.idx");
+  }
+  for (auto &kv : input.named_parameters) {
+    if (kv.first == "write_index") {
+      bind_data->write_index = BooleanValue::Get(kv.second);
+    }
   }
 
-  // Fill output
-  for (idx_t i = 0; i < batch.count; i++) {
-    auto &point = batch.data[i];
-    output.SetValue(0, i, Value::DOUBLE(point.latitude));
-    output.SetValue(1, i, Value::DOUBLE(point.longitude));
-    output.SetValue(2, i, Value::DOUBLE(point.value));
+  GribBindData types;
+  CreateEnumTypes(types);
+  bind_data->discipline_type = types.discipline_type;
+  bind_data->surface_type = types.surface_type;
+  bind_data->parameter_type = types.parameter_type;
+
+  names = {"message_index",  "offset",        "length",
+           "reference_time", "discipline",    "surface",
+           "parameter",      "forecast_time", "surface_value",
+           "num_points"};
+  return_types = {LogicalType::UINTEGER,  LogicalType::UBIGINT,
+                  LogicalType::UBIGINT,   LogicalType::TIMESTAMP,
+                  types.discipline_type,  types.surface_type,
+                  types.parameter_type,   LogicalType::BIGINT,
+                  LogicalType::DOUBLE,    LogicalType::UBIGINT};
+  return std::move(bind_data);
+}
+
+static unique_ptr<GlobalTableFunctionState>
+GribInventoryInitGlobal(ClientContext &context, TableFunctionInitInput &input) {
+  return make_uniq<GribInventoryGlobalState>();
+}
 
-    auto disc_idx = DisciplineToEnumIndex(point.discipline);
-    output.SetValue(3, i,
-                    Value(DISCIPLINE_VALUES[disc_idx])
-                        .DefaultCastAs(bind_data.discipline_type));
+// Message offsets come from the section 0 scan; the parameter columns from
+// the headers, so no data section is unpacked either way
+static void LoadGribInventory(ClientContext &context,
+                              const GribInventoryBindData &bind_data,
+                              GribInventoryGlobalState &gstate) {
+  char *error = nullptr;
+  auto path = bind_data.path.c_str();
+  idx_t count = grib2_scan_messages(path, nullptr, 0, &error);
+  if (!error) {
+    gstate.locations.resize(count);
+    count = grib2_scan_messages(path, gstate.locations.data(), count, &error);
+  }
+  if (error) {
+    string error_msg = error;
+    grib2_free_error(error);
+    throw IOException("Failed to open GRIB source: " + error_msg);
+  }
 
-    auto surf_idx = SurfaceToEnumIndex(point.surface_type);
-    output.SetValue(
-        4, i,
-        Value(SURFACE_VALUES[surf_idx]).DefaultCastAs(bind_data.surface_type));
+  string http_data;
+  auto reader = OpenGribSource(context, bind_data.path, http_data);
+  idx_t message_count = grib2_message_count(reader);
+  for (idx_t i = 0; i < message_count; i++) {
+    Grib2MessageInfo info;
+    if (grib2_message_info(reader, i, &info) &&
+        info.message_index / 1000 < gstate.locations.size()) {
+      gstate.messages.push_back(info);
+    }
+  }
+  grib2_close(reader);
+}
 
-    auto param_idx = ParameterToEnumIndex(
-        point.discipline, point.parameter_category, point.parameter_number);
-    output.SetValue(5, i,
-                    Value(PARAMETER_VALUES[param_idx])
-                        .DefaultCastAs(bind_data.parameter_type));
+static string GribReferenceDate(const Grib2MessageLocation &location) {
+  return StringUtil::Format("%04d%02d%02d%02d", location.year, location.month,
+                            location.day, location.hour);
+}
 
-    output.SetValue(6, i, Value::BIGINT(point.forecast_time));
-    output.SetValue(7, i, Value::DOUBLE(point.surface_value));
-    output.SetValue(8, i, Value::UINTEGER(point.message_index));
+// Write "<path>.idx" in the wgrib2 layout so that later filtered reads of the
+// file only read the messages they need
+static void WriteGribIndex(ClientContext &context,
+                           const GribInventoryBindData &bind_data,
+                           const GribInventoryGlobalState &gstate) {
+  vector<idx_t> submessages(gstate.locations.size(), 0);
+  for (auto &info : gstate.messages) {
+    submessages[info.message_index / 1000]++;
+  }
+  string text;
+  for (auto &info : gstate.messages) {
+    auto message = info.message_index / 1000;
+    auto &location = gstate.locations[message];
+    text += FormatGribIndexLine(info, location.offset, submessages[message] > 1,
+                                GribReferenceDate(location));
+    text += "\n";
   }
 
-  output.SetCardinality(batch.count);
-  bool has_more = batch.has_more;
-  grib2_free_batch(batch);
+  auto &fs = FileSystem::GetFileSystem(context);
+  auto handle = fs.OpenFile(bind_data.path + ".idx",
+                            FileFlags::FILE_FLAGS_WRITE |
+                                FileFlags::FILE_FLAGS_FILE_CREATE_NEW);
+  handle->Write(const_cast<char *>(text.data()), text.size());
+  handle->Sync();
+}
+
+static void GribInventoryScan(ClientContext &context, TableFunctionInput &data,
+                              DataChunk &output) {
+  auto &gstate = data.global_state->Cast<GribInventoryGlobalState>();
+  auto &bind_data = data.bind_data->Cast<GribInventoryBindData>();
+  if (!gstate.loaded) {
+    gstate.loaded = true;
+    LoadGribInventory(context, bind_data, gstate);
+    if (bind_data.write_index) {
+      WriteGribIndex(context, bind_data, gstate);
+    }
+  }
 
-  return has_more ? OperatorResultType::HAVE_MORE_OUTPUT
-                  : OperatorResultType::NEED_MORE_INPUT;
+  idx_t count = MinValue<idx_t>(STANDARD_VECTOR_SIZE,
+                                gstate.messages.size() - gstate.offset);
+  for (idx_t i = 0; i < count; i++) {
+    auto &info = gstate.messages[gstate.offset + i];
+    auto &location = gstate.locations[info.message_index / 1000];
+    Value reference_time(LogicalType::TIMESTAMP);
+    if (location.year != 0) {
+      reference_time = Value::TIMESTAMP(
+          Timestamp::FromDatetime(Date::FromDate(location.year, location.month,
+                                                 location.day),
+                                  Time::FromTime(location.hour, location.minute,
+                                                 location.second, 0)));
+    }
+    output.SetValue(0, i, Value::UINTEGER(info.message_index));
+    output.SetValue(1, i, Value::UBIGINT(location.offset));
+    output.SetValue(2, i, Value::UBIGINT(location.length));
+    output.SetValue(3, i, reference_time);
+    output.SetValue(4, i, Value::ENUM(DisciplineToEnumIndex(info.discipline),
+                                      bind_data.discipline_type));
+    output.SetValue(5, i, Value::ENUM(SurfaceToEnumIndex(info.surface_type),
+                                      bind_data.surface_type));
+    output.SetValue(6, i,
+                    Value::ENUM(ParameterToEnumIndex(info.discipline,
+                                                     info.parameter_category,
+                                                     info.parameter_number),
+                                bind_data.parameter_type));
+    output.SetValue(7, i, Value::BIGINT(info.forecast_time));
+    output.SetValue(8, i, Value::DOUBLE(info.surface_value));
+    output.SetValue(9, i, Value::UBIGINT(info.num_points));
+  }
+  gstate.offset += count;
+  output.SetCardinality(count);
 }
 
 // ============================================================================
@@ -767,28 +3932,90 @@ void RegisterGribFunction(ExtensionLoader &loader) {
   TableFunction grib_func("read_grib", {LogicalType::VARCHAR}, GribScan,
                           GribBind, GribInitGlobal);
   grib_func.init_local = GribInitLocal;
+  grib_func.projection_pushdown = true;
+  grib_func.pushdown_complex_filter = GribPushdownFilter;
   grib_func.cardinality = GribCardinality;
+  grib_func.statistics = GribStatistics;
   grib_func.table_scan_progress = GribProgress;
+  grib_func.get_partition_data = GribGetPartitionData;
+  grib_func.get_virtual_columns = GribGetVirtualColumns;
+  grib_func.dynamic_to_string = WeatherScanDynamicToString<GribGlobalState>;
+  grib_func.named_parameters["split_messages"] = LogicalType::BOOLEAN;
+  grib_func.named_parameters["wide"] = LogicalType::BOOLEAN;
+  grib_func.named_parameters["layout"] = LogicalType::VARCHAR;
+  grib_func.named_parameters["h3_resolution"] = LogicalType::INTEGER;
+  grib_func.named_parameters["value_type"] = LogicalType::VARCHAR;
+  grib_func.named_parameters["coords"] = LogicalType::VARCHAR;
+  grib_func.named_parameters["hive_partitioning"] = LogicalType::BOOLEAN;
 
   // Standard table function with LIST(VARCHAR)
   TableFunction grib_func_array("read_grib",
                                 {LogicalType::LIST(LogicalType::VARCHAR)},
                                 GribScan, GribBind, GribInitGlobal);
   grib_func_array.init_local = GribInitLocal;
+  grib_func_array.projection_pushdown = true;
+  grib_func_array.pushdown_complex_filter = GribPushdownFilter;
   grib_func_array.cardinality = GribCardinality;
+  grib_func_array.statistics = GribStatistics;
   grib_func_array.table_scan_progress = GribProgress;
-
-  // In-out function for LATERAL joins: read_grib_lateral(path)
-  // Use when path comes from another table: SELECT * FROM urls, LATERAL
-  // read_grib_lateral(urls.path)
-  TableFunction grib_inout("read_grib_lateral", {LogicalType::VARCHAR}, nullptr,
-                           GribInOutBind, GribInOutInitGlobal,
-                           GribInOutInitLocal);
-  grib_inout.in_out_function = GribInOutFunction;
+  grib_func_array.get_partition_data = GribGetPartitionData;
+  grib_func_array.get_virtual_columns = GribGetVirtualColumns;
+  grib_func_array.dynamic_to_string =
+      WeatherScanDynamicToString<GribGlobalState>;
+  grib_func_array.named_parameters["split_messages"] = LogicalType::BOOLEAN;
+  grib_func_array.named_parameters["wide"] = LogicalType::BOOLEAN;
+  grib_func_array.named_parameters["layout"] = LogicalType::VARCHAR;
+  grib_func_array.named_parameters["h3_resolution"] = LogicalType::INTEGER;
+  grib_func_array.named_parameters["value_type"] = LogicalType::VARCHAR;
+  grib_func_array.named_parameters["coords"] = LogicalType::VARCHAR;
+  grib_func_array.named_parameters["hive_partitioning"] = LogicalType::BOOLEAN;
+
+  // In-out function for paths from another table. The table form,
+  // read_grib_lateral((SELECT path FROM urls)), collects every path first
+  // and downloads them in the background, adding a path column. The LATERAL
+  // form (SELECT * FROM urls, LATERAL read_grib_lateral(urls.path)) gets one
+  // path per call and reads it on the calling thread, without prefetch.
+  TableFunctionSet grib_inout("read_grib_lateral");
+  TableFunction grib_inout_lateral("read_grib_lateral", {LogicalType::VARCHAR},
+                                   nullptr, GribInOutBind, GribInOutInitGlobal,
+                                   GribInOutInitLocal);
+  grib_inout_lateral.in_out_function = GribInOutFunction;
+  grib_inout.AddFunction(grib_inout_lateral);
+
+  TableFunction grib_inout_table("read_grib_lateral", {LogicalType::TABLE},
+                                 nullptr, GribInOutTableBind,
+                                 GribInOutInitGlobal, GribInOutInitLocal);
+  grib_inout_table.in_out_function = GribInOutTableFunction;
+  grib_inout_table.in_out_function_final = GribInOutTableFinal;
+  grib_inout.AddFunction(grib_inout_table);
+
+  // grib_sample(path, (SELECT lat, lon ...)): values at given points
+  TableFunction sample("grib_sample",
+                       {LogicalType::VARCHAR, LogicalType::TABLE}, nullptr,
+                       GribSampleBind, GribSampleInitGlobal,
+                       GribSampleInitLocal);
+  sample.in_out_function = GribSampleFunction;
+  sample.in_out_function_final = GribSampleFinal;
+  sample.named_parameters["method"] = LogicalType::VARCHAR;
+
+  // grib_to_parquet(source, target): one row group per message
+  TableFunction to_parquet("grib_to_parquet",
+                           {LogicalType::VARCHAR, LogicalType::VARCHAR},
+                           GribToParquetScan, GribToParquetBind,
+                           GribToParquetInitGlobal);
+  to_parquet.named_parameters["keep_coordinates"] = LogicalType::BOOLEAN;
 
   loader.RegisterFunction(grib_func);
   loader.RegisterFunction(grib_func_array);
   loader.RegisterFunction(grib_inout);
+  loader.RegisterFunction(sample);
+  loader.RegisterFunction(to_parquet);
+
+  TableFunction inventory("grib_inventory", {LogicalType::VARCHAR},
+                          GribInventoryScan, GribInventoryBind,
+                          GribInventoryInitGlobal);
+  inventory.named_parameters["write_index"] = LogicalType::BOOLEAN;
+  loader.RegisterFunction(inventory);
 }
 
 void RegisterGribEnumTypes(DatabaseInstance &db) {
@@ -0,0 +1,294 @@
+#include "grib_h3.hpp"
+#include "duckdb/common/exception.hpp"
+#include "duckdb/catalog/catalog.hpp"
+#include "duckdb/catalog/catalog_entry/scalar_function_catalog_entry.hpp"
+#include "duckdb/execution/expression_executor.hpp"
+#include "duckdb/function/function_binder.hpp"
+#include "duckdb/main/client_context.hpp"
+#include "duckdb/main/database.hpp"
+#include "duckdb/planner/expression/bound_cast_expression.hpp"
+#include "duckdb/planner/expression/bound_constant_expression.hpp"
+#include "duckdb/planner/expression/bound_reference_expression.hpp"
+#include <algorithm>
+#include <cmath>
+#include <mutex>
+
+namespace duckdb {
+
+// ============================================================================
+// Grid to cell mapping
+// ============================================================================
+
+// Global GFS grids at a few resolutions fit comfortably; older entries are
+// dropped first
+static constexpr idx_t GRIB_H3_CACHE_ENTRIES = 8;
+
+// Filled by the first scan that needs it; later scans of the same grid wait
+// on its lock rather than on the whole cache
+struct GribH3CacheSlot {
+  std::mutex lock;
+  shared_ptr<const GribH3Grid> cells;
+};
+
+// Entries belong to one database, whose h3 extension computed them, and go
+// away with it
+struct GribH3CacheEntry {
+  weak_ptr<DatabaseInstance> db;
+  Grib2GridInfo grid;
+  int32_t resolution;
+  shared_ptr<GribH3CacheSlot> slot;
+};
+
+static bool SameGrid(const Grib2GridInfo &a, const Grib2GridInfo &b) {
+  return a.ni == b.ni && a.nj == b.nj && a.lat1 == b.lat1 &&
+         a.lon1 == b.lon1 && a.di == b.di && a.dj == b.dj;
+}
+
+// Cell of every grid index, from h3_latlng_to_cell() over the coordinates
+// of the grid definition a vector at a time
+static shared_ptr<const GribH3Grid>
+ComputeGribH3Grid(ClientContext &context, const Grib2GridInfo &grid,
+                  const GribH3CellFunction &function) {
+  idx_t point_count = static_cast<idx_t>(grid.ni) * grid.nj;
+  ExpressionExecutor executor(context, *function.expression);
+  DataChunk input;
+  input.Initialize(Allocator::Get(context),
+                   {LogicalType::DOUBLE, LogicalType::DOUBLE});
+
+  vector<uint64_t> cell_of_point(point_count);
+  for (idx_t offset = 0; offset < point_count;
+       offset += STANDARD_VECTOR_SIZE) {
+    idx_t count = MinValue<idx_t>(STANDARD_VECTOR_SIZE, point_count - offset);
+    input.Reset();
+    auto latitudes = FlatVector::GetData<double>(input.data[0]);
+    auto longitudes = FlatVector::GetData<double>(input.data[1]);
+    for (idx_t i = 0; i < count; i++) {
+      idx_t n = offset + i;
+      latitudes[i] = grid.lat1 + static_cast<double>(n / grid.ni) * grid.dj;
+      // Longitudes are wrapped into [-180, 180) before the lookup
+      double lon = grid.lon1 + static_cast<double>(n % grid.ni) * grid.di;
+      longitudes[i] = lon - 360.0 * std::floor((lon + 180.0) / 360.0);
+    }
+    input.SetCardinality(count);
+
+    Vector result(LogicalType::UBIGINT);
+    executor.ExecuteExpression(input, result);
+    UnifiedVectorFormat format;
+    result.ToUnifiedFormat(count, format);
+    auto data = UnifiedVectorFormat::GetData<uint64_t>(format);
+    for (idx_t i = 0; i < count; i++) {
+      auto idx = format.sel->get_index(i);
+      if (!format.validity.RowIsValid(idx)) {
+        throw InvalidInputException("h3 cell lookup failed for grid index %d",
+                                    offset + i);
+      }
+      cell_of_point[offset + i] = data[idx];
+    }
+  }
+
+  auto cells = make_shared_ptr<GribH3Grid>();
+  cells->cells = cell_of_point;
+  std::sort(cells->cells.begin(), cells->cells.end());
+  cells->cells.erase(std::unique(cells->cells.begin(), cells->cells.end()),
+                     cells->cells.end());
+  cells->cell_of_point.resize(point_count);
+  for (idx_t i = 0; i < point_count; i++) {
+    auto it = std::lower_bound(cells->cells.begin(), cells->cells.end(),
+                               cell_of_point[i]);
+    cells->cell_of_point[i] = static_cast<uint32_t>(it - cells->cells.begin());
+  }
+  return std::move(cells);
+}
+
+shared_ptr<const GribH3CellFunction>
+BindGribH3CellFunction(ClientContext &context, int32_t resolution) {
+  auto entry = Catalog::GetEntry<ScalarFunctionCatalogEntry>(
+      context, SYSTEM_CATALOG, DEFAULT_SCHEMA, "h3_latlng_to_cell",
+      OnEntryNotFound::RETURN_NULL);
+  if (!entry) {
+    throw InvalidInputException("h3_resolution requires the h3 extension "
+                                "(INSTALL h3 FROM community; LOAD h3)");
+  }
+
+  vector<unique_ptr<Expression>> children;
+  children.push_back(
+      make_uniq<BoundReferenceExpression>(LogicalType::DOUBLE, 0));
+  children.push_back(
+      make_uniq<BoundReferenceExpression>(LogicalType::DOUBLE, 1));
+  children.push_back(
+      make_uniq<BoundConstantExpression>(Value::INTEGER(resolution)));
+  ErrorData error;
+  FunctionBinder binder(context);
+  auto expression =
+      binder.BindScalarFunction(*entry, std::move(children), error);
+  if (!expression) {
+    throw InvalidInputException("h3_latlng_to_cell cannot be bound: %s",
+                                error.Message());
+  }
+
+  auto function = make_shared_ptr<GribH3CellFunction>();
+  function->resolution = resolution;
+  function->expression = BoundCastExpression::AddCastToType(
+      context, std::move(expression), LogicalType::UBIGINT);
+  return std::move(function);
+}
+
+shared_ptr<const GribH3Grid> GetGribH3Grid(ClientContext &context,
+                                           const Grib2GridInfo &grid,
+                                           const GribH3CellFunction &function) {
+  static std::mutex cache_lock;
+  static vector<GribH3CacheEntry> cache;
+
+  shared_ptr<GribH3CacheSlot> slot;
+  {
+    std::lock_guard<std::mutex> guard(cache_lock);
+    cache.erase(std::remove_if(cache.begin(), cache.end(),
+                               [](const GribH3CacheEntry &entry) {
+                                 return entry.db.expired();
+                               }),
+                cache.end());
+    for (auto &entry : cache) {
+      if (entry.db.lock().get() == context.db.get() &&
+          entry.resolution == function.resolution &&
+          SameGrid(entry.grid, grid)) {
+        slot = entry.slot;
+        break;
+      }
+    }
+    if (!slot) {
+      GribH3CacheEntry entry;
+      entry.db = weak_ptr<DatabaseInstance>(context.db);
+      entry.grid = grid;
+      entry.resolution = function.resolution;
+      entry.slot = make_shared_ptr<GribH3CacheSlot>();
+      if (cache.size() >= GRIB_H3_CACHE_ENTRIES) {
+        cache.erase(cache.begin());
+      }
+      cache.push_back(entry);
+      slot = entry.slot;
+    }
+  }
+
+  // Scans of the same grid wait for the first one instead of repeating it;
+  // when that one fails, the next waiter tries again
+  std::lock_guard<std::mutex> guard(slot->lock);
+  if (!slot->cells) {
+    slot->cells = ComputeGribH3Grid(context, grid, function);
+  }
+  return slot->cells;
+}
+
+// ============================================================================
+// Per-cell aggregation
+// ============================================================================
+
+void GribH3Aggregate::Aggregate(ClientContext &context,
+                                const GribWideReader &wide,
+                                const GribH3CellFunction &function) {
+  rows.clear();
+  if (wide.Size() == 0) {
+    return;
+  }
+
+  Grib2GridInfo info;
+  if (!wide.GridInfo(info) || !info.regular) {
+    throw InvalidInputException(
+        "h3_resolution requires a regular lat/lon grid (template 3.0)");
+  }
+  grid = GetGribH3Grid(context, info, function);
+  auto &cell_of_point = grid->cell_of_point;
+  idx_t cell_count = grid->cells.size();
+
+  // Every point has a grid index inside the grid definition of its message
+  auto grid_indices = wide.GridIndices();
+  point_counts.assign(cell_count, 0);
+  for (idx_t p = 0; p < wide.Size(); p++) {
+    if (grid_indices[p] >= cell_of_point.size()) {
+      throw InvalidInputException(
+          "GRIB grid index %d is outside the grid definition",
+          grid_indices[p]);
+    }
+    point_counts[cell_of_point[grid_indices[p]]]++;
+  }
+
+  idx_t column_count = wide.ColumnCount();
+  sums.resize(column_count);
+  counts.resize(column_count);
+  present.assign(column_count, false);
+  for (idx_t k = 0; k < column_count; k++) {
+    auto values = wide.Values(k);
+    if (!values) {
+      continue;
+    }
+    present[k] = true;
+    auto &sum = sums[k];
+    auto &count = counts[k];
+    sum.assign(cell_count, 0);
+    count.assign(cell_count, 0);
+    for (idx_t p = 0; p < wide.Size(); p++) {
+      if (std::isnan(values[p])) {
+        continue;
+      }
+      auto cell = cell_of_point[grid_indices[p]];
+      sum[cell] += values[p];
+      count[cell]++;
+    }
+  }
+
+  for (idx_t cell = 0; cell < cell_count; cell++) {
+    if (point_counts[cell] > 0) {
+      rows.push_back(static_cast<uint32_t>(cell));
+    }
+  }
+}
+
+void GribH3Aggregate::CopyCells(idx_t offset, idx_t count, Vector &out) const {
+  auto data = FlatVector::GetData<uint64_t>(out);
+  for (idx_t i = 0; i < count; i++) {
+    data[i] = grid->cells[rows[offset + i]];
+  }
+}
+
+void GribH3Aggregate::CopyPointCounts(idx_t offset, idx_t count,
+                                      Vector &out) const {
+  auto data = FlatVector::GetData<uint32_t>(out);
+  for (idx_t i = 0; i < count; i++) {
+    data[i] = point_counts[rows[offset + i]];
+  }
+}
+
+double GribH3Aggregate::Mean(idx_t column, idx_t row) const {
+  auto cell = rows[row];
+  if (!present[column] || counts[column][cell] == 0) {
+    return NAN;
+  }
+  return sums[column][cell] / counts[column][cell];
+}
+
+void GribH3Aggregate::CopyValues(idx_t column, idx_t offset, idx_t count,
+                                 Vector &out) const {
+  if (!present[column]) {
+    out.SetVectorType(VectorType::CONSTANT_VECTOR);
+    ConstantVector::SetNull(out, true);
+    return;
+  }
+  auto &validity = FlatVector::Validity(out);
+  auto &sum = sums[column];
+  auto &value_count = counts[column];
+  bool is_float = out.GetType().id() == LogicalTypeId::FLOAT;
+  for (idx_t i = 0; i < count; i++) {
+    auto cell = rows[offset + i];
+    if (value_count[cell] == 0) {
+      validity.SetInvalid(i);
+      continue;
+    }
+    double mean = sum[cell] / value_count[cell];
+    if (is_float) {
+      FlatVector::GetData<float>(out)[i] = static_cast<float>(mean);
+    } else {
+      FlatVector::GetData<double>(out)[i] = mean;
+    }
+  }
+}
+
+} // namespace duckdb
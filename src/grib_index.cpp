@@ -0,0 +1,258 @@
+#include "grib_index.hpp"
+#include "duckdb/common/string_util.hpp"
+#include <cmath>
+#include <cstdlib>
+#include <unordered_map>
+
+namespace duckdb {
+
+// ============================================================
+// Field parsing
+// ============================================================
+
+struct GribParameterCode {
+  uint8_t discipline;
+  uint8_t category;
+  uint8_t number;
+};
+
+// wgrib2 abbreviations of WMO (non-local) parameters found in GFS/GEFS
+// inventories. Unlisted abbreviations never prune a message.
+static const std::unordered_map<string, GribParameterCode> INDEX_PARAMETERS = {
+    {"TMP", {0, 0, 0}},   {"TMAX", {0, 0, 4}},  {"TMIN", {0, 0, 5}},
+    {"DPT", {0, 0, 6}},   {"SPFH", {0, 1, 0}},  {"RH", {0, 1, 1}},
+    {"PWAT", {0, 1, 3}},  {"PRATE", {0, 1, 7}}, {"APCP", {0, 1, 8}},
+    {"SNOD", {0, 1, 11}}, {"WEASD", {0, 1, 13}}, {"UGRD", {0, 2, 2}},
+    {"VGRD", {0, 2, 3}},  {"VVEL", {0, 2, 8}},  {"GUST", {0, 2, 22}},
+    {"PRES", {0, 3, 0}},  {"PRMSL", {0, 3, 1}}, {"HGT", {0, 3, 5}},
+    {"TCDC", {0, 6, 1}},  {"CAPE", {0, 7, 6}},  {"CIN", {0, 7, 7}},
+    {"VIS", {0, 19, 0}},  {"LAND", {2, 0, 0}},  {"ICEC", {10, 2, 0}},
+};
+
+static bool ParseUnsigned(const string &text, idx_t &result) {
+  if (text.empty()) {
+    return false;
+  }
+  char *end = nullptr;
+  auto value = std::strtoull(text.c_str(), &end, 10);
+  if (*end != '\0') {
+    return false;
+  }
+  result = static_cast<idx_t>(value);
+  return true;
+}
+
+// Integer prefix of "<n><suffix>", e.g. "2 m above ground"
+static bool ParseLevelValue(const string &level, const string &suffix,
+                            idx_t &value) {
+  return StringUtil::EndsWith(level, suffix) &&
+         ParseUnsigned(level.substr(0, level.size() - suffix.size()), value);
+}
+
+// Levels without a value (surface, mean sea level, entire atmosphere)
+// decode as NaN from the message header. Their value is left unknown, so
+// the inventory never prunes a message its header would keep.
+static void ParseIndexLevel(const string &level, GribIndexRecord &record) {
+  idx_t value = 0;
+  record.info.surface_value = NAN;
+  if (level == "surface") {
+    record.info.surface_type = 1;
+  } else if (level == "mean sea level") {
+    record.info.surface_type = 101;
+  } else if (level == "entire atmosphere") {
+    record.info.surface_type = 10;
+  } else if (level == "entire atmosphere (considered as a single layer)") {
+    // PWAT, CWAT: the whole column as one layer, not level type 10
+    record.info.surface_type = 200;
+  } else if (ParseLevelValue(level, " m above ground", value)) {
+    record.info.surface_type = 103;
+    record.info.surface_value = static_cast<double>(value);
+    record.surface_value_known = true;
+  } else if (ParseLevelValue(level, " mb", value)) {
+    // Isobaric levels are encoded in Pa
+    record.info.surface_type = 100;
+    record.info.surface_value = static_cast<double>(value) * 100.0;
+    record.surface_value_known = true;
+  } else {
+    return;
+  }
+  record.surface_known = true;
+}
+
+// "anl", "6 hour fcst" and "0-6 hour acc fcst" (the header stores the start
+// of the interval). Other units are left unknown.
+static void ParseIndexForecast(const string &forecast,
+                               GribIndexRecord &record) {
+  if (forecast == "anl") {
+    record.info.forecast_time = 0;
+    record.forecast_time_known = true;
+    return;
+  }
+  auto parts = StringUtil::Split(forecast, ' ');
+  if (parts.size() < 3 || parts[1] != "hour" || parts.back() != "fcst") {
+    return;
+  }
+  idx_t start;
+  if (!ParseUnsigned(parts[0].substr(0, parts[0].find('-')), start)) {
+    return;
+  }
+  record.info.forecast_time = static_cast<int64_t>(start);
+  record.forecast_time_known = true;
+}
+
+// ============================================================
+// Inventory
+// ============================================================
+
+bool TryParseGribIndex(const string &text, vector<GribIndexRecord> &records) {
+  records.clear();
+  for (auto &line : StringUtil::Split(text, '\n')) {
+    if (!line.empty() && line.back() == '\r') {
+      line.pop_back();
+    }
+    if (line.empty()) {
+      continue;
+    }
+    auto fields = StringUtil::Split(line, ':');
+    if (fields.size() < 3) {
+      return false;
+    }
+
+    // Record number "5" or "5.2" (second submessage of message 5)
+    GribIndexRecord record;
+    auto dot = fields[0].find('.');
+    idx_t message = 0;
+    idx_t submessage = 1;
+    if (!ParseUnsigned(fields[0].substr(0, dot), message) || message == 0 ||
+        (dot != string::npos &&
+         (!ParseUnsigned(fields[0].substr(dot + 1), submessage) ||
+          submessage == 0)) ||
+        !ParseUnsigned(fields[1], record.offset)) {
+      return false;
+    }
+    record.message_number = message - 1;
+    record.info.message_index =
+        static_cast<uint32_t>(record.message_number * 1000 + submessage - 1);
+
+    if (fields.size() > 3) {
+      auto it = INDEX_PARAMETERS.find(fields[3]);
+      if (it != INDEX_PARAMETERS.end()) {
+        record.info.discipline = it->second.discipline;
+        record.info.parameter_category = it->second.category;
+        record.info.parameter_number = it->second.number;
+        record.parameter_known = true;
+      }
+    }
+    if (fields.size() > 4) {
+      ParseIndexLevel(fields[4], record);
+    }
+    if (fields.size() > 5) {
+      ParseIndexForecast(fields[5], record);
+    }
+    records.push_back(std::move(record));
+  }
+  return true;
+}
+
+vector<GribByteRange> CoalesceGribRanges(const vector<GribIndexRecord> &records,
+                                         const vector<bool> &selected,
+                                         idx_t max_gap) {
+  // Collapse submessage records into messages in file order
+  struct IndexedMessage {
+    idx_t number;
+    idx_t begin;
+    bool selected;
+  };
+  vector<IndexedMessage> messages;
+  for (idx_t i = 0; i < records.size(); i++) {
+    auto &record = records[i];
+    if (messages.empty() || messages.back().number != record.message_number) {
+      messages.push_back({record.message_number, record.offset, false});
+    }
+    messages.back().selected = messages.back().selected || selected[i];
+  }
+
+  vector<GribByteRange> ranges;
+  vector<uint32_t> gap_messages; // Unselected since the last range
+  for (idx_t m = 0; m < messages.size(); m++) {
+    auto &message = messages[m];
+    idx_t end = m + 1 < messages.size() ? messages[m + 1].begin : 0;
+    auto number = static_cast<uint32_t>(message.number);
+    if (!message.selected) {
+      gap_messages.push_back(number);
+      continue;
+    }
+    if (!ranges.empty() && message.begin - ranges.back().end <= max_gap) {
+      auto &range = ranges.back();
+      range.message_numbers.insert(range.message_numbers.end(),
+                                   gap_messages.begin(), gap_messages.end());
+      range.message_numbers.push_back(number);
+      range.end = end;
+    } else {
+      GribByteRange range;
+      range.begin = message.begin;
+      range.end = end;
+      range.message_numbers.push_back(number);
+      ranges.push_back(std::move(range));
+    }
+    gap_messages.clear();
+  }
+  return ranges;
+}
+
+// ============================================================
+// Writing
+// ============================================================
+
+// Levels the parser recognizes are written the same way; other surfaces
+// get a description that never prunes a message
+static string FormatIndexLevel(const Grib2MessageInfo &info) {
+  auto value = std::isnan(info.surface_value)
+                   ? int64_t(0)
+                   : static_cast<int64_t>(info.surface_value);
+  switch (info.surface_type) {
+  case 1:
+    return "surface";
+  case 10:
+    return "entire atmosphere";
+  case 200:
+    return "entire atmosphere (considered as a single layer)";
+  case 101:
+    return "mean sea level";
+  case 100:
+    return StringUtil::Format("%d mb", value / 100);
+  case 103:
+    return StringUtil::Format("%d m above ground", value);
+  default:
+    return StringUtil::Format("level %d %d", info.surface_type, value);
+  }
+}
+
+string FormatGribIndexLine(const Grib2MessageInfo &info, idx_t offset,
+                           bool numbered_submessage, const string &reference) {
+  idx_t message = info.message_index / 1000 + 1;
+  idx_t submessage = info.message_index % 1000 + 1;
+  auto number = numbered_submessage
+                    ? StringUtil::Format("%d.%d", message, submessage)
+                    : std::to_string(message);
+
+  auto variable = StringUtil::Format("var%d_%d_%d", info.discipline,
+                                     info.parameter_category,
+                                     info.parameter_number);
+  for (auto &entry : INDEX_PARAMETERS) {
+    if (entry.second.discipline == info.discipline &&
+        entry.second.category == info.parameter_category &&
+        entry.second.number == info.parameter_number) {
+      variable = entry.first;
+      break;
+    }
+  }
+
+  auto forecast = info.forecast_time == 0
+                      ? string("anl")
+                      : StringUtil::Format("%d hour fcst", info.forecast_time);
+  return StringUtil::Format("%s:%d:d=%s:%s:%s:%s:", number, offset, reference,
+                            variable, FormatIndexLevel(info), forecast);
+}
+
+} // namespace duckdb
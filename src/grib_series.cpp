@@ -0,0 +1,219 @@
+#include "grib_series.hpp"
+#include "duckdb/common/exception.hpp"
+#include <algorithm>
+#include <cstring>
+
+namespace duckdb {
+
+GribSeriesBuffer::GribSeriesBuffer(idx_t column_count_p)
+    : column_count(column_count_p) {
+}
+
+// ============================================================================
+// Collecting steps
+// ============================================================================
+
+void GribSeriesBuffer::SetKeys(const GribWideReader &wide,
+                               const GribH3Aggregate *cells_p) {
+  has_keys = true;
+  if (cells_p) {
+    size = cells_p->Size();
+    cells.resize(size);
+    point_counts.resize(size);
+    for (idx_t r = 0; r < size; r++) {
+      cells[r] = cells_p->Cell(r);
+      point_counts[r] = cells_p->PointCount(r);
+    }
+    return;
+  }
+  size = wide.Size();
+  auto grid_index = wide.GridIndices();
+  grid_indices.assign(grid_index, grid_index + size);
+  // Coordinates are copied once; the decoder's arrays die with its reader
+  if (wide.Latitudes() && wide.Longitudes()) {
+    latitudes.assign(wide.Latitudes(), wide.Latitudes() + size);
+    longitudes.assign(wide.Longitudes(), wide.Longitudes() + size);
+  }
+}
+
+void GribSeriesBuffer::AddStep(int64_t forecast_time, idx_t file_index,
+                               const GribWideReader &wide,
+                               const GribH3Aggregate *cells_p) {
+  Step step;
+  step.forecast_time = forecast_time;
+  step.file_index = file_index;
+  step.values.resize(column_count);
+  idx_t step_size = cells_p ? cells_p->Size() : wide.Size();
+  for (idx_t k = 0; k < column_count; k++) {
+    auto source = wide.Values(k);
+    if (!source) {
+      continue;
+    }
+    auto &values = step.values[k];
+    values.resize(step_size);
+    for (idx_t r = 0; r < step_size; r++) {
+      values[r] = static_cast<float>(cells_p ? cells_p->Mean(k, r)
+                                             : source[r]);
+    }
+  }
+
+  std::lock_guard<std::mutex> guard(lock);
+  if (!has_keys) {
+    SetKeys(wide, cells_p);
+  } else if (step_size != size) {
+    throw InvalidInputException(
+        "layout := 'series' requires every forecast step on the same grid: "
+        "forecast time %d has %d points, expected %d",
+        forecast_time, step_size, size);
+  }
+  steps.push_back(std::move(step));
+}
+
+void GribSeriesBuffer::AddEmptyStep(int64_t forecast_time, idx_t file_index) {
+  Step step;
+  step.forecast_time = forecast_time;
+  step.file_index = file_index;
+  step.values.resize(column_count);
+  std::lock_guard<std::mutex> guard(lock);
+  steps.push_back(std::move(step));
+}
+
+void GribSeriesBuffer::Finalize() {
+  std::lock_guard<std::mutex> guard(lock);
+  std::stable_sort(steps.begin(), steps.end(),
+                   [](const Step &a, const Step &b) {
+                     return a.forecast_time != b.forecast_time
+                                ? a.forecast_time < b.forecast_time
+                                : a.file_index < b.file_index;
+                   });
+}
+
+// ============================================================================
+// Reading rows
+// ============================================================================
+
+// FLOAT output columns are narrowed while copying
+template <class T>
+static void CopyKeys(const vector<T> &source, idx_t offset, idx_t count,
+                     Vector &out) {
+  if (source.empty()) {
+    out.SetVectorType(VectorType::CONSTANT_VECTOR);
+    ConstantVector::SetNull(out, true);
+    return;
+  }
+  if (out.GetType().id() == LogicalTypeId::FLOAT) {
+    auto data = FlatVector::GetData<float>(out);
+    for (idx_t i = 0; i < count; i++) {
+      data[i] = static_cast<float>(source[offset + i]);
+    }
+    return;
+  }
+  memcpy(FlatVector::GetData<T>(out), source.data() + offset,
+         count * sizeof(T));
+}
+
+void GribSeriesBuffer::CopyLatitudes(idx_t offset, idx_t count,
+                                     Vector &out) const {
+  CopyKeys(latitudes, offset, count, out);
+}
+
+void GribSeriesBuffer::CopyLongitudes(idx_t offset, idx_t count,
+                                      Vector &out) const {
+  CopyKeys(longitudes, offset, count, out);
+}
+
+void GribSeriesBuffer::CopyGridIndices(idx_t offset, idx_t count,
+                                       Vector &out) const {
+  CopyKeys(grid_indices, offset, count, out);
+}
+
+void GribSeriesBuffer::CopyCells(idx_t offset, idx_t count,
+                                 Vector &out) const {
+  CopyKeys(cells, offset, count, out);
+}
+
+void GribSeriesBuffer::CopyPointCounts(idx_t offset, idx_t count,
+                                       Vector &out) const {
+  CopyKeys(point_counts, offset, count, out);
+}
+
+// Element vector for count rows of step_count elements each. LIST entries
+// are written here; ARRAY children are sized by the type.
+static Vector &PrepareListChild(Vector &out, idx_t count, idx_t step_count) {
+  if (out.GetType().id() == LogicalTypeId::ARRAY) {
+    if (ArrayType::GetSize(out.GetType()) != step_count) {
+      throw InternalException("series array holds %d steps, expected %d",
+                              ArrayType::GetSize(out.GetType()), step_count);
+    }
+    return ArrayVector::GetEntry(out);
+  }
+  ListVector::Reserve(out, count * step_count);
+  auto entries = FlatVector::GetData<list_entry_t>(out);
+  for (idx_t i = 0; i < count; i++) {
+    entries[i] = list_entry_t(i * step_count, step_count);
+  }
+  ListVector::SetListSize(out, count * step_count);
+  return ListVector::GetEntry(out);
+}
+
+void GribSeriesBuffer::CopyForecastTimes(idx_t count, Vector &out) const {
+  idx_t step_count = steps.size();
+  auto &child = PrepareListChild(out, count, step_count);
+  bool is_integer = child.GetType().id() == LogicalTypeId::INTEGER;
+  for (idx_t i = 0; i < count; i++) {
+    for (idx_t s = 0; s < step_count; s++) {
+      auto time = steps[s].forecast_time;
+      if (is_integer) {
+        FlatVector::GetData<int32_t>(child)[i * step_count + s] =
+            static_cast<int32_t>(time);
+      } else {
+        FlatVector::GetData<int64_t>(child)[i * step_count + s] = time;
+      }
+    }
+  }
+}
+
+void GribSeriesBuffer::CopyFileIndices(idx_t count, Vector &out) const {
+  idx_t step_count = steps.size();
+  auto data = FlatVector::GetData<uint32_t>(
+      PrepareListChild(out, count, step_count));
+  for (idx_t i = 0; i < count; i++) {
+    for (idx_t s = 0; s < step_count; s++) {
+      data[i * step_count + s] = static_cast<uint32_t>(steps[s].file_index);
+    }
+  }
+}
+
+void GribSeriesBuffer::CopyValidTimes(timestamp_t base, int64_t unit_micros,
+                                      idx_t count, Vector &out) const {
+  idx_t step_count = steps.size();
+  auto data = FlatVector::GetData<timestamp_tz_t>(
+      PrepareListChild(out, count, step_count));
+  for (idx_t i = 0; i < count; i++) {
+    for (idx_t s = 0; s < step_count; s++) {
+      data[i * step_count + s] = timestamp_tz_t(
+          base.value + steps[s].forecast_time * unit_micros);
+    }
+  }
+}
+
+void GribSeriesBuffer::CopyValues(idx_t column, idx_t offset, idx_t count,
+                                  Vector &out) const {
+  idx_t step_count = steps.size();
+  auto &child = PrepareListChild(out, count, step_count);
+  auto data = FlatVector::GetData<float>(child);
+  auto &validity = FlatVector::Validity(child);
+  for (idx_t s = 0; s < step_count; s++) {
+    auto &values = steps[s].values[column];
+    for (idx_t i = 0; i < count; i++) {
+      idx_t element = i * step_count + s;
+      if (values.empty()) {
+        validity.SetInvalid(element);
+      } else {
+        data[element] = values[offset + i];
+      }
+    }
+  }
+}
+
+} // namespace duckdb
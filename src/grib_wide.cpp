@@ -0,0 +1,191 @@
+#include "grib_wide.hpp"
+#include "duckdb/common/exception.hpp"
+#include <cmath>
+#include <cstring>
+#include <unordered_map>
+
+namespace duckdb {
+
+bool GribWideColumn::Matches(const Grib2MessageInfo &info) const {
+  if (info.discipline != discipline ||
+      info.parameter_category != parameter_category ||
+      info.parameter_number != parameter_number ||
+      info.surface_type != surface_type) {
+    return false;
+  }
+  if (!match_surface_value) {
+    return true;
+  }
+  // Missing levels decode as NaN
+  return info.surface_value == surface_value ||
+         (std::isnan(info.surface_value) && std::isnan(surface_value));
+}
+
+bool GribSameGrid(const Grib2GridInfo &a, idx_t a_points,
+                  const Grib2GridInfo &b, idx_t b_points) {
+  return a_points == b_points && a.template_number == b.template_number &&
+         a.regular == b.regular && a.ni == b.ni && a.nj == b.nj &&
+         a.lat1 == b.lat1 && a.lon1 == b.lon1 && a.di == b.di &&
+         a.dj == b.dj;
+}
+
+GribWideReader::GribWideReader(Grib2Reader *reader_p,
+                               vector<GribWideColumn> columns_p,
+                               bool group_by_forecast_time,
+                               WeatherScanMetrics *metrics_p)
+    : reader(reader_p), columns(std::move(columns_p)), metrics(metrics_p),
+      values(columns.size()), present(columns.size(), false) {
+  std::unordered_map<int64_t, idx_t> group_of_time;
+  idx_t message_count = grib2_message_count(reader);
+  for (idx_t i = 0; i < message_count; i++) {
+    Grib2MessageInfo info;
+    if (!grib2_message_info(reader, i, &info)) {
+      continue;
+    }
+    for (idx_t k = 0; k < columns.size(); k++) {
+      if (!columns[k].Matches(info)) {
+        continue;
+      }
+      int64_t key = group_by_forecast_time ? info.forecast_time : 0;
+      auto it = group_of_time.find(key);
+      if (it == group_of_time.end()) {
+        it = group_of_time.emplace(key, groups.size()).first;
+        Group group;
+        group.forecast_time = info.forecast_time;
+        group.messages.resize(columns.size(), DConstants::INVALID_INDEX);
+        groups.push_back(std::move(group));
+      }
+      auto &message = groups[it->second].messages[k];
+      if (message == DConstants::INVALID_INDEX) {
+        message = i;
+      }
+    }
+  }
+}
+
+bool GribWideReader::NextGroup() {
+  WeatherScanTimer timer(metrics ? &metrics->decode_nanos : nullptr);
+  while (next_group < groups.size()) {
+    auto &group = groups[next_group++];
+    bool first = true;
+    Grib2GridInfo group_grid = {};
+    idx_t group_points = 0;
+    uint32_t group_message_index = 0;
+    size = 0;
+    for (idx_t k = 0; k < columns.size(); k++) {
+      present[k] = false;
+      auto message = group.messages[k];
+      Grib2MessageInfo info;
+      if (message == DConstants::INVALID_INDEX ||
+          !grib2_message_info(reader, message, &info)) {
+        continue;
+      }
+
+      // Rows zip the messages point by point, so every message of the
+      // group must lie on the grid of the first
+      Grib2GridInfo grid = {};
+      grib2_grid_info(reader, message, &grid);
+      if (first) {
+        if (!grib2_grid_points(reader, message, &points)) {
+          throw IOException("Error reading GRIB grid of message %d",
+                            info.message_index);
+        }
+        grid_message = message;
+        group_grid = grid;
+        group_points = info.num_points;
+        group_message_index = info.message_index;
+      } else if (!GribSameGrid(group_grid, group_points, grid,
+                               info.num_points)) {
+        throw InvalidInputException(
+            "wide output requires messages on the same grid: message %d is "
+            "on a different grid than message %d",
+            info.message_index, group_message_index);
+      }
+
+      idx_t capacity = info.num_points;
+      values[k].resize(capacity);
+      Grib2ColumnBuffers buffers = {nullptr, nullptr, values[k].data(),
+                                    nullptr, nullptr, 0};
+      auto batch = grib2_read_message(reader, message, &buffers, capacity);
+      if (batch.error) {
+        string error_msg = batch.error;
+        grib2_free_error(batch.error);
+        throw IOException("Error reading GRIB data: " + error_msg);
+      }
+      if (metrics) {
+        metrics->messages_decoded++;
+        metrics->points_decoded += batch.count;
+      }
+      if (first) {
+        size = batch.count;
+        first = false;
+      } else if (batch.count != size) {
+        throw InvalidInputException(
+            "wide output requires messages on the same grid: message %d has "
+            "%d points, expected %d",
+            info.message_index, batch.count, size);
+      }
+      present[k] = true;
+    }
+    if (size > 0) {
+      return true;
+    }
+  }
+  size = 0;
+  return false;
+}
+
+int64_t GribWideReader::ForecastTime() const {
+  return next_group > 0 ? groups[next_group - 1].forecast_time : 0;
+}
+
+bool GribWideReader::GridInfo(Grib2GridInfo &out) const {
+  return size > 0 && grib2_grid_info(reader, grid_message, &out);
+}
+
+// FLOAT output columns are narrowed while copying
+template <class T>
+static void CopySlice(const T *source, idx_t offset, idx_t count,
+                      Vector &out) {
+  if (!source) {
+    // Coordinates were not decoded
+    out.SetVectorType(VectorType::CONSTANT_VECTOR);
+    ConstantVector::SetNull(out, true);
+    return;
+  }
+  if (out.GetType().id() == LogicalTypeId::FLOAT) {
+    auto data = FlatVector::GetData<float>(out);
+    for (idx_t i = 0; i < count; i++) {
+      data[i] = static_cast<float>(source[offset + i]);
+    }
+    return;
+  }
+  memcpy(FlatVector::GetData<T>(out), source + offset, count * sizeof(T));
+}
+
+void GribWideReader::CopyValues(idx_t column, idx_t offset, idx_t count,
+                                Vector &out) const {
+  if (!present[column]) {
+    out.SetVectorType(VectorType::CONSTANT_VECTOR);
+    ConstantVector::SetNull(out, true);
+    return;
+  }
+  CopySlice(values[column].data(), offset, count, out);
+}
+
+void GribWideReader::CopyLatitudes(idx_t offset, idx_t count,
+                                   Vector &out) const {
+  CopySlice(points.latitude, offset, count, out);
+}
+
+void GribWideReader::CopyLongitudes(idx_t offset, idx_t count,
+                                    Vector &out) const {
+  CopySlice(points.longitude, offset, count, out);
+}
+
+void GribWideReader::CopyGridIndices(idx_t offset, idx_t count,
+                                     Vector &out) const {
+  CopySlice(points.grid_index, offset, count, out);
+}
+
+} // namespace duckdb
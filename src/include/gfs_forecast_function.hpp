@@ -1,11 +1,13 @@
 #pragma once
 
 #include "duckdb.hpp"
-#include "duckdb/planner/logical_operator.hpp"
 
 namespace duckdb {
 
 void RegisterGfsForecastFunction(ExtensionLoader &loader);
-void OptimizeGfsForecastLimitPushdown(unique_ptr<LogicalOperator> &op);
+
+// gfs_max_concurrent_downloads, which also bounds the downloads of
+// read_grib_lateral()
+idx_t GetGfsMaxDownloads(ClientContext &context);
 
 } // namespace duckdb
@@ -30,6 +30,90 @@ typedef struct {
   char *error;
 } Grib2Batch;
 
+// Per-message metadata for a run of consecutive points in a columnar batch
+typedef struct {
+  size_t offset;
+  size_t count;
+  int64_t forecast_time;
+  double surface_value;
+  uint32_t message_index;
+  uint8_t discipline;
+  uint8_t parameter_category;
+  uint8_t parameter_number;
+  uint8_t surface_type;
+} Grib2MessageRun;
+
+// Caller-provided output buffers for columnar reads
+// latitude/longitude/value/grid_index may be NULL to skip that column; the
+// *_float buffers receive the same column as FLOAT
+typedef struct {
+  double *latitude;
+  double *longitude;
+  double *value;
+  uint32_t *grid_index;
+  Grib2MessageRun *runs;
+  size_t max_runs;
+  float *latitude_float;
+  float *longitude_float;
+  float *value_float;
+} Grib2ColumnBuffers;
+
+// Result of a columnar read (points live in the caller's buffers)
+typedef struct {
+  size_t count;
+  size_t run_count;
+  bool has_more;
+  char *error;
+} Grib2ColumnarBatch;
+
+// Header metadata of one message, available before decoding
+typedef struct {
+  int64_t forecast_time;
+  double surface_value;
+  size_t num_points;
+  uint32_t message_index;
+  uint8_t discipline;
+  uint8_t parameter_category;
+  uint8_t parameter_number;
+  uint8_t surface_type;
+} Grib2MessageInfo;
+
+// Grid definition of one message. For regular lat/lon grids point n lies at
+// latitude lat1 + (n / ni) * dj, longitude lon1 + (n % ni) * di.
+typedef struct {
+  uint32_t ni;
+  uint32_t nj;
+  double lat1;
+  double lon1;
+  double di;
+  double dj;
+  uint16_t template_number;
+  bool regular;
+} Grib2GridInfo;
+
+// Points of one message's grid, shared by every message on the same grid
+// and owned by the reader until it is closed. latitude/longitude are NULL
+// when coordinate decoding is disabled.
+typedef struct {
+  const double *latitude;
+  const double *longitude;
+  const uint32_t *grid_index;
+  size_t count;
+} Grib2GridPoints;
+
+// Byte range and reference time of one GRIB message, from its section 0
+// and section 1 headers only
+typedef struct {
+  uint64_t offset;
+  uint64_t length;
+  uint16_t year;
+  uint8_t month;
+  uint8_t day;
+  uint8_t hour;
+  uint8_t minute;
+  uint8_t second;
+} Grib2MessageLocation;
+
 // Opaque reader handle
 typedef struct Grib2Reader Grib2Reader;
 
@@ -37,13 +121,68 @@ typedef struct Grib2Reader Grib2Reader;
 Grib2Reader *grib2_open(const char *path);
 Grib2Reader *grib2_open_with_error(const char *path, char **error);
 
+// Streaming API - file path, decoding only submessages [begin, end)
+Grib2Reader *grib2_open_range_with_error(const char *path, size_t begin,
+                                         size_t end, char **error);
+
+// Count submessages in a file without decoding data (0 + error on failure)
+size_t grib2_count_messages(const char *path, char **error);
+
+// Locate the messages of a file by their section 0 lengths without parsing
+// them. Writes up to capacity locations and returns the number of messages
+// (0 + error on failure).
+size_t grib2_scan_messages(const char *path, Grib2MessageLocation *locations,
+                           size_t capacity, char **error);
+
 // Streaming API - in-memory bytes (for HTTP fetched data)
 Grib2Reader *grib2_open_from_bytes(const uint8_t *data, size_t len,
                                    char **error);
 
 // Reading and cleanup
 Grib2Batch grib2_read_batch(Grib2Reader *reader, size_t max_count);
+Grib2ColumnarBatch grib2_read_batch_columnar(Grib2Reader *reader,
+                                             size_t max_count,
+                                             const Grib2ColumnBuffers *buffers);
 size_t grib2_total_points(Grib2Reader *reader);
+
+// Unpack every point of selected message idx into buffers of `capacity`
+// points, independent of the batch cursor (runs are not written)
+Grib2ColumnarBatch grib2_read_message(Grib2Reader *reader, size_t idx,
+                                      const Grib2ColumnBuffers *buffers,
+                                      size_t capacity);
+
+// Skip latitude/longitude generation when coordinates are not needed
+void grib2_set_decode_coordinates(Grib2Reader *reader, bool enabled);
+
+// Emit only points inside an inclusive lat/lon window (lon in -180..180).
+// Regular lat/lon grids skip rows and columns outside it by index.
+void grib2_set_bbox(Grib2Reader *reader, double lat_min, double lat_max,
+                    double lon_min, double lon_max);
+
+// Message selection (call before reading) - skipped messages are not decoded
+size_t grib2_message_count(Grib2Reader *reader);
+bool grib2_message_info(Grib2Reader *reader, size_t idx,
+                        Grib2MessageInfo *info);
+bool grib2_grid_info(Grib2Reader *reader, size_t idx, Grib2GridInfo *info);
+// Coordinates and grid indices of selected message idx without unpacking it.
+// Regenerated only once per grid, bounding box and coordinate setting in
+// the process.
+bool grib2_grid_points(Grib2Reader *reader, size_t idx,
+                       Grib2GridPoints *points);
+
+// Sample message idx of a regular lat/lon grid at count coordinates. Writes
+// NaN outside the grid; bilinear interpolates between the four neighbors.
+bool grib2_sample_message(Grib2Reader *reader, size_t idx,
+                          const double *latitudes, const double *longitudes,
+                          size_t count, bool bilinear, double *values,
+                          char **error);
+void grib2_select_messages(Grib2Reader *reader, const uint8_t *keep,
+                           size_t count);
+
+// Map message k of the source to message numbers[k] of the original file
+// (for readers opened from selected byte ranges)
+void grib2_renumber_messages(Grib2Reader *reader, const uint32_t *numbers,
+                             size_t count);
 void grib2_close(Grib2Reader *reader);
 void grib2_free_batch(Grib2Batch batch);
 void grib2_free_error(char *error);
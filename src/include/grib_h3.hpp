@@ -0,0 +1,68 @@
+#pragma once
+
+#include "duckdb.hpp"
+#include "grib2_ffi.h"
+#include "grib_wide.hpp"
+
+namespace duckdb {
+
+// The H3 cells covering a regular grid at one resolution: the distinct cells
+// and, for every grid index, its position among them
+struct GribH3Grid {
+  vector<uint64_t> cells; // Ascending
+  vector<uint32_t> cell_of_point;
+};
+
+// h3_latlng_to_cell(latitude, longitude, resolution) of the h3 extension,
+// bound once at bind time and executed in the scan without a query of its own
+struct GribH3CellFunction {
+  int32_t resolution;
+  // Reads latitude and longitude (DOUBLE) from columns 0 and 1; UBIGINT
+  unique_ptr<Expression> expression;
+};
+
+// Throws InvalidInputException unless the h3 extension is loaded, so that
+// h3_resolution fails at bind rather than in the middle of a scan
+shared_ptr<const GribH3CellFunction> BindGribH3CellFunction(
+    ClientContext &context, int32_t resolution);
+
+// Cells of a grid definition, computed once per database and shared by
+// every scan of the same grid and resolution
+shared_ptr<const GribH3Grid> GetGribH3Grid(ClientContext &context,
+                                           const Grib2GridInfo &grid,
+                                           const GribH3CellFunction &function);
+
+// Per-cell means of the current group of a wide reader: one row per H3 cell
+// that holds at least one of the group's points. The cell of each point is a
+// lookup by grid index, so no H3 math and no hashing happens per point.
+class GribH3Aggregate {
+public:
+  // Aggregate the current group of wide, replacing the previous rows
+  void Aggregate(ClientContext &context, const GribWideReader &wide,
+                 const GribH3CellFunction &function);
+
+  idx_t Size() const { return rows.size(); }
+  void Clear() { rows.clear(); }
+
+  // Copy rows [offset, offset + count). A cell without any non-missing
+  // value of a column is NULL in that column.
+  void CopyCells(idx_t offset, idx_t count, Vector &out) const;
+  void CopyPointCounts(idx_t offset, idx_t count, Vector &out) const;
+  void CopyValues(idx_t column, idx_t offset, idx_t count, Vector &out) const;
+
+  // Single rows, for consumers that keep the aggregates. Mean is NaN when
+  // the cell has no non-missing value of the column.
+  uint64_t Cell(idx_t row) const { return grid->cells[rows[row]]; }
+  uint32_t PointCount(idx_t row) const { return point_counts[rows[row]]; }
+  double Mean(idx_t column, idx_t row) const;
+
+private:
+  shared_ptr<const GribH3Grid> grid;
+  vector<uint32_t> rows; // Positions in grid->cells
+  vector<uint32_t> point_counts;
+  vector<vector<double>> sums; // Per column and cell
+  vector<vector<uint32_t>> counts;
+  vector<bool> present;
+};
+
+} // namespace duckdb
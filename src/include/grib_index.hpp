@@ -0,0 +1,45 @@
+#pragma once
+
+#include "duckdb.hpp"
+#include "grib2_ffi.h"
+
+namespace duckdb {
+
+// One line of a wgrib2-style .idx inventory, e.g.
+//   5.2:130324:d=2024010100:VGRD:10 m above ground:6 hour fcst:
+// Only the fields flagged as known could be parsed from the text.
+struct GribIndexRecord {
+  idx_t message_number = 0; // 0-based GRIB message ("5.2" -> 4)
+  idx_t offset = 0;         // Byte offset of the message in the file
+  Grib2MessageInfo info = {};
+  bool parameter_known = false;
+  bool surface_known = false;
+  bool surface_value_known = false;
+  bool forecast_time_known = false;
+};
+
+// A contiguous byte range covering one or more whole messages
+struct GribByteRange {
+  idx_t begin = 0;
+  idx_t end = 0; // Exclusive, 0 = to the end of the file
+  vector<uint32_t> message_numbers; // Messages in the range, in file order
+};
+
+// Parse an inventory; false when the text is not a wgrib2 inventory
+bool TryParseGribIndex(const string &text, vector<GribIndexRecord> &records);
+
+// Byte ranges of all messages with at least one selected record. Ranges
+// separated by at most max_gap bytes are merged, the messages in between
+// are then fetched as well.
+vector<GribByteRange> CoalesceGribRanges(const vector<GribIndexRecord> &records,
+                                         const vector<bool> &selected,
+                                         idx_t max_gap);
+
+// One inventory line for a message header in the layout TryParseGribIndex
+// reads back: "<n>[.<k>]:<offset>:d=<reference>:<VAR>:<level>:<forecast>:"
+// where reference is YYYYMMDDHH. Parameters without a wgrib2 abbreviation
+// are written as var<discipline>_<category>_<number>.
+string FormatGribIndexLine(const Grib2MessageInfo &info, idx_t offset,
+                           bool numbered_submessage, const string &reference);
+
+} // namespace duckdb
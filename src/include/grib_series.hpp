@@ -0,0 +1,74 @@
+#pragma once
+
+#include "duckdb.hpp"
+#include "grib_h3.hpp"
+#include "grib_wide.hpp"
+#include <mutex>
+
+namespace duckdb {
+
+// Stitches the wide groups of many forecast steps into one row per grid
+// point (or H3 cell), with one list of values per column and the keys of
+// each row stored once. Steps may be added from any thread and in any order;
+// rows are read after Finalize, with the steps ordered by forecast time.
+// Values are kept as FLOAT, the type of the list elements.
+class GribSeriesBuffer {
+public:
+  explicit GribSeriesBuffer(idx_t column_count);
+
+  // Add the current group of wide as one step. All steps must produce the
+  // same points (or cells, when cells is set).
+  void AddStep(int64_t forecast_time, idx_t file_index,
+               const GribWideReader &wide,
+               const GribH3Aggregate *cells = nullptr);
+  // A step without any message: all of its values are NULL
+  void AddEmptyStep(int64_t forecast_time, idx_t file_index);
+  // Order the steps by forecast time (then file); call after the last step
+  void Finalize();
+
+  idx_t Size() const { return size; }
+  idx_t StepCount() const { return steps.size(); }
+
+  // Row keys of rows [offset, offset + count). Coordinates are NULL when
+  // they were not decoded.
+  void CopyLatitudes(idx_t offset, idx_t count, Vector &out) const;
+  void CopyLongitudes(idx_t offset, idx_t count, Vector &out) const;
+  void CopyGridIndices(idx_t offset, idx_t count, Vector &out) const;
+  void CopyCells(idx_t offset, idx_t count, Vector &out) const;
+  void CopyPointCounts(idx_t offset, idx_t count, Vector &out) const;
+
+  // Lists with one element per step, the same for each of count rows:
+  // forecast times (INTEGER or BIGINT elements), source files (UINTEGER),
+  // and base plus the forecast time counted in units of unit_micros
+  // (TIMESTAMP_TZ). out is a LIST or an ARRAY of StepCount() elements.
+  void CopyForecastTimes(idx_t count, Vector &out) const;
+  void CopyFileIndices(idx_t count, Vector &out) const;
+  void CopyValidTimes(timestamp_t base, int64_t unit_micros, idx_t count,
+                      Vector &out) const;
+  // Lists of column values of rows [offset, offset + count). As in the long
+  // and wide layouts, points the message leaves undefined are NaN; a step
+  // without a message for the column is a NULL element.
+  void CopyValues(idx_t column, idx_t offset, idx_t count, Vector &out) const;
+
+private:
+  struct Step {
+    int64_t forecast_time = 0;
+    idx_t file_index = 0;
+    vector<vector<float>> values; // Per column, empty when absent
+  };
+
+  void SetKeys(const GribWideReader &wide, const GribH3Aggregate *cells);
+
+  std::mutex lock;
+  idx_t column_count;
+  idx_t size = 0;
+  bool has_keys = false;
+  vector<double> latitudes;
+  vector<double> longitudes;
+  vector<uint32_t> grid_indices;
+  vector<uint64_t> cells;
+  vector<uint32_t> point_counts;
+  vector<Step> steps;
+};
+
+} // namespace duckdb
@@ -0,0 +1,88 @@
+#pragma once
+
+#include "duckdb.hpp"
+#include "grib2_ffi.h"
+#include "weather_metrics.hpp"
+
+namespace duckdb {
+
+// One value column of wide output: the message with this parameter and level
+// (an aggregate, so tables of columns can be brace-initialized)
+struct GribWideColumn {
+  uint8_t discipline;
+  uint8_t parameter_category;
+  uint8_t parameter_number;
+  uint8_t surface_type;
+  double surface_value;
+  bool match_surface_value; // false: any level of surface_type
+
+  bool Matches(const Grib2MessageInfo &info) const;
+};
+
+// Whether two messages lie on the same grid: the same template and point
+// count, and for regular grids the same first point and increments
+bool GribSameGrid(const Grib2GridInfo &a, idx_t a_points,
+                  const Grib2GridInfo &b, idx_t b_points);
+
+// Zips the messages of a reader into wide rows: every group of messages
+// becomes one row per grid point, with one value array per column. Messages
+// are grouped by forecast time, or all form a single group. Within a group
+// the first message matching a column is used, and all messages of a group
+// must produce the same points. Unpacked messages, values and decode time
+// are added to metrics when given.
+class GribWideReader {
+public:
+  GribWideReader(Grib2Reader *reader, vector<GribWideColumn> columns,
+                 bool group_by_forecast_time,
+                 WeatherScanMetrics *metrics = nullptr);
+
+  // Unpack the next group; false when every group has been read
+  bool NextGroup();
+
+  // Points of the current group
+  idx_t Size() const { return size; }
+  int64_t ForecastTime() const;
+
+  // Copy points [offset, offset + count) of the current group. A column
+  // without a message in this group is written as NULL.
+  void CopyValues(idx_t column, idx_t offset, idx_t count, Vector &out) const;
+  void CopyLatitudes(idx_t offset, idx_t count, Vector &out) const;
+  void CopyLongitudes(idx_t offset, idx_t count, Vector &out) const;
+  void CopyGridIndices(idx_t offset, idx_t count, Vector &out) const;
+
+  // Raw arrays of the current group, for consumers that aggregate points.
+  // Values are nullptr for a column without a message in this group.
+  idx_t ColumnCount() const { return columns.size(); }
+  const double *Values(idx_t column) const {
+    return present[column] ? values[column].data() : nullptr;
+  }
+  const uint32_t *GridIndices() const { return points.grid_index; }
+  // nullptr when coordinates are not decoded
+  const double *Latitudes() const { return points.latitude; }
+  const double *Longitudes() const { return points.longitude; }
+  // Grid definition of the message the group's points come from
+  bool GridInfo(Grib2GridInfo &out) const;
+
+private:
+  struct Group {
+    int64_t forecast_time = 0;
+    vector<idx_t> messages; // Per column, INVALID_INDEX when absent
+  };
+
+  Grib2Reader *reader;
+  vector<GribWideColumn> columns;
+  WeatherScanMetrics *metrics;
+  vector<Group> groups;
+  idx_t next_group = 0;
+
+  // Current group. Coordinates and grid indices are the decoder's shared
+  // arrays for the grid of its first message, so they are never copied
+  // per group.
+  idx_t size = 0;
+  idx_t grid_message = 0;
+  Grib2GridPoints points = {};
+  vector<vector<double>> values;
+  vector<bool> present;
+};
+
+} // namespace duckdb
@@ -0,0 +1,213 @@
+#pragma once
+
+#include "duckdb.hpp"
+#include "duckdb/common/http_util.hpp"
+#include "weather_metrics.hpp"
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+namespace duckdb {
+
+class DBConfig;
+class FileSystem;
+
+// Register the weather_cache_* and weather_http_* settings
+void RegisterWeatherHttpSettings(DBConfig &config);
+
+// Retry and per-host budget settings of every weather HTTP request. Read on
+// the query thread, so fetch pool workers never touch the context.
+struct WeatherHttpSettings {
+  explicit WeatherHttpSettings(ClientContext &context);
+
+  // Attempts after the first for connection errors, interrupted transfers
+  // and 408/425/429/5xx answers
+  idx_t retries;
+  // Backoff before retry n is jittered between half and all of
+  // retry_wait_ms * 2^n, capped at retry_max_wait_ms. A Retry-After header
+  // raises it (up to the cap).
+  idx_t retry_wait_ms;
+  idx_t retry_max_wait_ms;
+  // Requests in flight and started per second to one host, across every
+  // scan of the process; 0 = unlimited
+  idx_t max_host_requests;
+  double host_requests_per_second;
+};
+
+// ============================================================
+// Response Cache
+// ============================================================
+
+// A cached response body with its HTTP validators
+struct WeatherCacheEntry {
+  string body;
+  int64_t stored = 0;  // Epoch seconds when written or revalidated
+  int64_t expires = 0; // Epoch seconds from the Expires header, 0 = none
+  string etag;
+  string last_modified;
+};
+
+// Persistent cache of HTTP response bodies under weather_cache_directory.
+// Entries are keyed by a hash of the request (URL plus byte range) and are
+// evicted least recently used once weather_cache_max_size is exceeded.
+// Settings are read on construction, after that the cache can be used from
+// any thread. Disabled when the directory setting is empty.
+class WeatherCache {
+public:
+  explicit WeatherCache(ClientContext &context);
+
+  bool Enabled() const { return !directory.empty(); }
+
+  // Body of an entry younger than weather_cache_ttl_seconds. Put writes the
+  // body from the caller's buffer without copying it.
+  bool Get(const string &key, string &body);
+  void Put(const string &key, const string &body);
+
+  // Entry regardless of age, for conditional requests
+  bool GetEntry(const string &key, WeatherCacheEntry &entry);
+  void PutEntry(const string &key, const WeatherCacheEntry &entry);
+
+private:
+  void Write(const string &key, const WeatherCacheEntry &meta,
+             const string &body);
+  string EntryPath(const string &key, const char *extension) const;
+  void WriteFile(const string &path, const string &data);
+  void Evict();
+
+  FileSystem &fs;
+  string directory;
+  idx_t max_size;
+  int64_t ttl_seconds;
+};
+
+// ============================================================
+// Single Requests
+// ============================================================
+
+// Every request below is retried and budgeted per WeatherHttpSettings, and
+// a body cut off mid-transfer is resumed with a Range request for the bytes
+// still missing. Requests, retries, bytes and cache hits are added to
+// metrics when given.
+
+// GET a URL on the calling thread. Throws IOException on a non-success
+// status. Served from the cache when enabled, since GRIB files are
+// immutable once published.
+string WeatherHttpGet(ClientContext &context, const string &url,
+                      WeatherScanMetrics *metrics = nullptr);
+
+// Like WeatherHttpGet, but returns false instead of throwing when the server
+// answers with a non-success status (e.g. a missing sidecar file)
+bool WeatherHttpTryGet(ClientContext &context, const string &url,
+                       string &body, WeatherScanMetrics *metrics = nullptr);
+
+// GET byte ranges [begin, end) of a URL (end == 0 means to the end of the
+// file) and append them to body in order. The ranges share one connection.
+// Servers that ignore the Range header are handled by slicing the body.
+void WeatherHttpGetRanges(ClientContext &context, const string &url,
+                          const vector<std::pair<idx_t, idx_t>> &ranges,
+                          string &body, WeatherScanMetrics *metrics = nullptr);
+
+// GET a resource that changes over time. A cached body is reused without a
+// request until its Expires time, then revalidated with If-None-Match /
+// If-Modified-Since; a 304 answer keeps the cached body.
+string WeatherHttpGetRevalidated(ClientContext &context, const string &url,
+                                 const HTTPHeaders &headers,
+                                 WeatherScanMetrics *metrics = nullptr);
+
+// HEAD every URL, with at most max_concurrency requests in flight. An entry
+// is true when the server answered with a success status; failed requests
+// count as missing. Nothing is cached, availability changes over time.
+vector<bool> WeatherHttpProbe(ClientContext &context,
+                              const vector<string> &urls,
+                              idx_t max_concurrency,
+                              WeatherScanMetrics *metrics = nullptr);
+
+// ============================================================
+// Fetch Pool
+// ============================================================
+
+// How pooled downloads use the response cache
+enum class WeatherCachePolicy : uint8_t {
+  // Published files never change: reuse entries within the TTL
+  IMMUTABLE,
+  // Reuse until Expires, then revalidate (as WeatherHttpGetRevalidated)
+  REVALIDATE
+};
+
+// Outcome of one pooled download; error is empty on success
+struct WeatherFetchResult {
+  idx_t url_idx = 0;
+  string body;
+  string error;
+};
+
+// Downloads a fixed list of URLs on background threads. At most
+// max_concurrency downloads are in flight or waiting to be consumed, which
+// bounds both the load on the remote server and the buffered memory.
+// Next hands out finished downloads in completion order, so several scan
+// threads can decode while later URLs are still downloading; NextInOrder
+// hands them out in list order for scans that keep insertion order. A pool
+// is consumed through one of the two, not both. Each worker
+// keeps its connection open across the URLs it downloads.
+// With metrics, every finished body counts as buffered until the consumer
+// releases it.
+class WeatherFetchPool {
+public:
+  WeatherFetchPool(
+      ClientContext &context, vector<string> urls, idx_t max_concurrency,
+      HTTPHeaders headers = HTTPHeaders(),
+      WeatherCachePolicy policy = WeatherCachePolicy::IMMUTABLE,
+      shared_ptr<WeatherScanMetrics> metrics = nullptr);
+  ~WeatherFetchPool();
+
+  // Block until the next download finishes. Returns false once every URL
+  // has been handed out or the pool was cancelled.
+  bool Next(WeatherFetchResult &result);
+
+  // Claim the next URL in list order and block until its download
+  // finishes. Returns false once every URL has been claimed or the pool was
+  // cancelled.
+  bool NextInOrder(WeatherFetchResult &result);
+
+  // Stop issuing requests; downloads already in flight are aborted
+  void Cancel();
+
+  // Number of downloads finished so far (for progress reporting)
+  idx_t Completed() const { return completed.load(); }
+
+  idx_t UrlCount() const { return urls.size(); }
+
+private:
+  void Worker();
+  void Finish(WeatherFetchResult result);
+
+  HTTPUtil &http_util;
+  WeatherCache cache;
+  vector<string> urls;
+  HTTPHeaders headers; // Sent with every request
+  WeatherCachePolicy policy;
+  WeatherHttpSettings http_settings;
+  shared_ptr<WeatherScanMetrics> metrics;
+  // Initialized on the calling thread, the context is not used by workers
+  vector<unique_ptr<HTTPParams>> params;
+  idx_t max_concurrency;
+
+  std::mutex lock;
+  std::condition_variable result_ready;
+  std::condition_variable slot_free;
+  idx_t next_url = 0;
+  idx_t in_flight = 0;
+  idx_t handed_out = 0;
+  idx_t next_claimed = 0; // NextInOrder
+  bool cancelled = false;
+  std::deque<WeatherFetchResult> results;
+  // Read by transfers in flight, which stop receiving once it is set
+  std::atomic<bool> aborted{false};
+
+  std::atomic<idx_t> completed{0};
+  vector<std::thread> workers;
+};
+
+} // namespace duckdb
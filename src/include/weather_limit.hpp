@@ -0,0 +1,22 @@
+#pragma once
+
+#include "duckdb.hpp"
+#include "duckdb/function/table_function.hpp"
+#include "duckdb/planner/logical_operator.hpp"
+
+namespace duckdb {
+
+// Bind data of the table functions that stop scanning (and downloading)
+// once the rows a LIMIT needs are produced
+struct WeatherLimitBindData : public TableFunctionData {
+  // LIMIT plus OFFSET of a limit directly above the scan; 0 = unlimited
+  idx_t max_rows = 0;
+};
+
+// Set max_rows of noaa_gfs_forecast_api, read_grib and met_forecast scans
+// whose rows reach a constant LIMIT unfiltered. Runs after the built-in
+// optimizers, so filters left in the plan (not fully pushed down) and
+// ORDER BY ... LIMIT (a TOP_N, which needs every row) are not affected.
+void OptimizeWeatherLimitPushdown(unique_ptr<LogicalOperator> &op);
+
+} // namespace duckdb
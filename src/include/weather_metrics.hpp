@@ -0,0 +1,93 @@
+#pragma once
+
+#include "duckdb.hpp"
+#include "duckdb/common/insertion_order_preserving_map.hpp"
+#include "duckdb/function/table_function.hpp"
+#include <atomic>
+#include <chrono>
+
+namespace duckdb {
+
+// Counters of one table function scan, updated from scan threads and fetch
+// pool workers. Shown as operator info by EXPLAIN ANALYZE and, for the most
+// recent query that ran a weather scan, by weather_scan_stats().
+struct WeatherScanMetrics {
+  explicit WeatherScanMetrics(string function_name_p)
+      : function_name(std::move(function_name_p)) {}
+
+  string function_name;
+
+  // HTTP requests and body bytes received; time is summed over concurrent
+  // requests. Cache hits are answered without a body from the server.
+  std::atomic<idx_t> http_requests{0};
+  std::atomic<idx_t> http_retries{0};
+  std::atomic<idx_t> http_nanos{0};
+  std::atomic<idx_t> bytes_downloaded{0};
+  std::atomic<idx_t> cache_hits{0};
+
+  // GRIB messages unpacked, and messages dropped by pushed-down filters
+  // before they were downloaded or unpacked
+  std::atomic<idx_t> messages_decoded{0};
+  std::atomic<idx_t> messages_skipped{0};
+  // Values produced by the decoder (or MET time steps parsed), and the time
+  // spent producing them
+  std::atomic<idx_t> points_decoded{0};
+  std::atomic<idx_t> decode_nanos{0};
+
+  // Downloaded bodies held in memory: waiting in a fetch pool or being
+  // decoded
+  std::atomic<idx_t> buffered_bytes{0};
+  std::atomic<idx_t> peak_buffered_bytes{0};
+
+  void AddBuffered(idx_t bytes);
+  void ReleaseBuffered(idx_t bytes);
+
+  // Operator extra info for the profiler
+  InsertionOrderPreservingMap<string> ToProfilerInfo() const;
+};
+
+// Metrics for a scan of function_name starting in the current query. The
+// first scan of a query replaces the scans of the previous one in
+// weather_scan_stats().
+shared_ptr<WeatherScanMetrics> RegisterWeatherScan(ClientContext &context,
+                                                   const string &function_name);
+
+// Adds the time from construction to destruction to a nanosecond counter;
+// does nothing without one
+class WeatherScanTimer {
+public:
+  explicit WeatherScanTimer(std::atomic<idx_t> *target_p)
+      : target(target_p), start(std::chrono::steady_clock::now()) {}
+  ~WeatherScanTimer() {
+    if (target) {
+      auto elapsed = std::chrono::steady_clock::now() - start;
+      *target += static_cast<idx_t>(
+          std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed)
+              .count());
+    }
+  }
+
+private:
+  std::atomic<idx_t> *target;
+  std::chrono::steady_clock::time_point start;
+};
+
+// dynamic_to_string callback of table functions whose global state holds
+// the scan's metrics
+template <class STATE>
+InsertionOrderPreservingMap<string>
+WeatherScanDynamicToString(TableFunctionDynamicToStringInput &input) {
+  if (!input.global_state) {
+    return InsertionOrderPreservingMap<string>();
+  }
+  auto &metrics = input.global_state->Cast<STATE>().metrics;
+  if (!metrics) {
+    return InsertionOrderPreservingMap<string>();
+  }
+  return metrics->ToProfilerInfo();
+}
+
+// Register the weather_scan_stats() table function
+void RegisterWeatherScanStatsFunction(ExtensionLoader &loader);
+
+} // namespace duckdb
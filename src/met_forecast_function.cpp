@@ -6,7 +6,13 @@
 #include "duckdb/main/client_context.hpp"
 #include "duckdb/main/config.hpp"
 #include "duckdb/parser/parsed_data/create_scalar_function_info.hpp"
+#include "weather_http.hpp"
+#include "weather_limit.hpp"
+#include "weather_metrics.hpp"
 #include "yyjson.hpp"
+#include <deque>
+#include <mutex>
+#include <unordered_map>
 #include <vector>
 
 using namespace duckdb_yyjson;
@@ -21,34 +27,93 @@ static constexpr const char *MET_USER_AGENT_KEY = "met_user_agent";
 static constexpr const char *DEFAULT_USER_AGENT =
     "duckdb-weather/0.1 github.com/onnimonni/duckdb-weather";
 
+// Concurrent requests of met_forecast_lateral; api.met.no asks clients to
+// stay well below 20 requests per second
+static constexpr const char *MET_MAX_CONCURRENT_REQUESTS_KEY =
+    "met_max_concurrent_requests";
+static constexpr idx_t DEFAULT_MET_MAX_CONCURRENT_REQUESTS = 4;
+
+// Scheme and host of the API, e.g. a local mock server for benchmarks
+static constexpr const char *MET_BASE_URL_KEY = "met_base_url";
+static constexpr const char *DEFAULT_MET_BASE_URL = "https://api.met.no";
+
 // ============================================================
-// Parsed forecast data point
+// Forecast fields
 // ============================================================
 
-struct MetForecastPoint {
-  string time;
-  double air_temperature;
-  double relative_humidity;
-  double wind_speed;
-  double wind_from_direction;
-  double wind_speed_of_gust;
-  double air_pressure_at_sea_level;
-  double cloud_area_fraction;
-  double precipitation_amount;
+// Objects of a timeseries entry that carry details
+enum class MetSection : uint8_t { INSTANT, NEXT_1_HOURS };
+
+struct MetField {
+  MetSection section;
+  const char *key;    // In <section>.details
+  const char *column; // Output column name
+};
+
+// The compact endpoint fields come first; the complete endpoint adds the rest
+static const MetField MET_FIELDS[] = {
+    {MetSection::INSTANT, "air_temperature", "temperature_celsius"},
+    {MetSection::INSTANT, "relative_humidity", "humidity_percentage"},
+    {MetSection::INSTANT, "wind_speed", "wind_speed_ms"},
+    {MetSection::INSTANT, "wind_from_direction", "wind_direction_deg"},
+    {MetSection::INSTANT, "wind_speed_of_gust", "wind_gust_ms"},
+    {MetSection::INSTANT, "air_pressure_at_sea_level", "pressure_hpa"},
+    {MetSection::INSTANT, "cloud_area_fraction", "cloud_cover_percentage"},
+    {MetSection::NEXT_1_HOURS, "precipitation_amount", "precipitation_mm"},
+    {MetSection::INSTANT, "dew_point_temperature", "dew_point_celsius"},
+    {MetSection::INSTANT, "fog_area_fraction", "fog_percentage"},
+    {MetSection::INSTANT, "cloud_area_fraction_low",
+     "cloud_cover_low_percentage"},
+    {MetSection::INSTANT, "cloud_area_fraction_medium",
+     "cloud_cover_medium_percentage"},
+    {MetSection::INSTANT, "cloud_area_fraction_high",
+     "cloud_cover_high_percentage"},
+    {MetSection::INSTANT, "ultraviolet_index_clear_sky", "uv_index_clear_sky"},
+    {MetSection::NEXT_1_HOURS, "precipitation_amount_min",
+     "precipitation_min_mm"},
+    {MetSection::NEXT_1_HOURS, "precipitation_amount_max",
+     "precipitation_max_mm"},
+    {MetSection::NEXT_1_HOURS, "probability_of_precipitation",
+     "precipitation_probability_percentage"},
+    {MetSection::NEXT_1_HOURS, "probability_of_thunder",
+     "thunder_probability_percentage"},
 };
 
+static constexpr idx_t MET_COMPACT_FIELD_COUNT = 8;
+static constexpr idx_t MET_COMPLETE_FIELD_COUNT =
+    sizeof(MET_FIELDS) / sizeof(MET_FIELDS[0]);
+
+// time, latitude and longitude precede the fields
+static constexpr idx_t MET_FIRST_FIELD_COLUMN = 3;
+
+// ============================================================
+// Parsed forecast: one column per field, NaN where the field is missing
+// ============================================================
+
+struct MetForecastSeries {
+  vector<timestamp_t> times;
+  vector<vector<double>> fields;
+
+  idx_t Size() const { return times.size(); }
+};
+
+using MetForecastRef = shared_ptr<const MetForecastSeries>;
+
 // ============================================================
 // Bind Data
 // ============================================================
 
-struct MetForecastBindData : public TableFunctionData {
+struct MetForecastBindData : public WeatherLimitBindData {
   double latitude = 0.0;
   double longitude = 0.0;
   double altitude = -1.0; // Optional, -1 means not set
   string user_agent;
+  string base_url;
+  bool complete = false; // locationforecast/2.0/complete
 
-  vector<string> column_names;
-  vector<LogicalType> column_types;
+  idx_t FieldCount() const {
+    return complete ? MET_COMPLETE_FIELD_COUNT : MET_COMPACT_FIELD_COUNT;
+  }
 };
 
 // ============================================================
@@ -56,11 +121,11 @@ struct MetForecastBindData : public TableFunctionData {
 // ============================================================
 
 struct MetForecastGlobalState : public GlobalTableFunctionState {
-  vector<MetForecastPoint> data_points;
+  MetForecastRef forecast;
   idx_t current_idx = 0;
-  bool finished = false;
   double latitude = 0.0;
   double longitude = 0.0;
+  shared_ptr<WeatherScanMetrics> metrics;
 
   idx_t MaxThreads() const override { return 1; }
 };
@@ -69,27 +134,73 @@ struct MetForecastGlobalState : public GlobalTableFunctionState {
 // JSON Parser using yyjson
 // ============================================================
 
-static double GetJsonDouble(yyjson_val *obj, const char *key,
-                            double default_val = 0.0) {
-  yyjson_val *val = yyjson_obj_get(obj, key);
-  if (val && yyjson_is_num(val)) {
-    return yyjson_get_num(val);
+static bool ParseDigits(const char *text, idx_t count, int32_t &result) {
+  result = 0;
+  for (idx_t i = 0; i < count; i++) {
+    if (text[i] < '0' || text[i] > '9') {
+      return false;
+    }
+    result = result * 10 + (text[i] - '0');
   }
-  return default_val;
+  return true;
 }
 
-static string GetJsonString(yyjson_val *obj, const char *key) {
-  yyjson_val *val = yyjson_obj_get(obj, key);
-  if (val && yyjson_is_str(val)) {
-    return string(yyjson_get_str(val));
+// MET times are always "YYYY-MM-DDTHH:MM:SSZ"; anything else goes through
+// the general parser
+static bool ParseMetTime(const char *text, idx_t len, timestamp_t &result) {
+  int32_t year, month, day, hour, minute, second;
+  if (len == 20 && text[4] == '-' && text[7] == '-' && text[10] == 'T' &&
+      text[13] == ':' && text[16] == ':' && text[19] == 'Z' &&
+      ParseDigits(text, 4, year) && ParseDigits(text + 5, 2, month) &&
+      ParseDigits(text + 8, 2, day) && ParseDigits(text + 11, 2, hour) &&
+      ParseDigits(text + 14, 2, minute) && ParseDigits(text + 17, 2, second) &&
+      Date::IsValid(year, month, day) &&
+      Time::IsValidTime(hour, minute, second, 0)) {
+    result = Timestamp::FromDatetime(Date::FromDate(year, month, day),
+                                     Time::FromTime(hour, minute, second, 0));
+    return true;
+  }
+  try {
+    result = Timestamp::FromString(string(text, len), true);
+    return true;
+  } catch (ConversionException &) {
+    return false;
   }
-  return "";
 }
 
-static vector<MetForecastPoint> ParseMetJson(const string &json_data) {
-  vector<MetForecastPoint> points;
+// Write the fields of one details object into row `row` of the series.
+// Every key is matched once against the field table instead of looking up
+// each field by name.
+static void ParseMetDetails(yyjson_val *details, MetSection section,
+                            idx_t field_count, idx_t row,
+                            MetForecastSeries &series) {
+  if (!details || !yyjson_is_obj(details)) {
+    return;
+  }
+  size_t idx, max;
+  yyjson_val *key, *val;
+  yyjson_obj_foreach(details, idx, max, key, val) {
+    if (!yyjson_is_num(val)) {
+      continue;
+    }
+    for (idx_t f = 0; f < field_count; f++) {
+      if (MET_FIELDS[f].section == section &&
+          yyjson_equals_str(key, MET_FIELDS[f].key)) {
+        series.fields[f][row] = yyjson_get_num(val);
+        break;
+      }
+    }
+  }
+}
 
-  yyjson_doc *doc = yyjson_read(json_data.c_str(), json_data.size(), 0);
+// Parse a locationforecast response straight into columns. The body is
+// parsed in place (yyjson writes unescaped strings into it), so it is
+// padded and modified but never copied.
+static MetForecastRef ParseMetJson(string &body, idx_t field_count) {
+  idx_t len = body.size();
+  body.append(YYJSON_PADDING_SIZE, '\0');
+  yyjson_doc *doc =
+      yyjson_read_opts(&body[0], len, YYJSON_READ_INSITU, nullptr, nullptr);
   if (!doc) {
     throw InvalidInputException("Failed to parse MET API JSON response");
   }
@@ -107,51 +218,154 @@ static vector<MetForecastPoint> ParseMetJson(const string &json_data) {
     throw InvalidInputException("MET API response missing 'timeseries' array");
   }
 
+  auto series = make_shared_ptr<MetForecastSeries>();
+  idx_t capacity = yyjson_arr_size(timeseries);
+  series->times.reserve(capacity);
+  series->fields.assign(field_count, vector<double>(capacity, NAN));
+
   size_t idx, max;
   yyjson_val *ts;
   yyjson_arr_foreach(timeseries, idx, max, ts) {
-    MetForecastPoint point;
-
-    point.time = GetJsonString(ts, "time");
+    // Steps without a valid time cannot be placed and are skipped
+    yyjson_val *time = yyjson_obj_get(ts, "time");
+    timestamp_t time_value;
+    if (!time || !yyjson_is_str(time) ||
+        !ParseMetTime(yyjson_get_str(time), yyjson_get_len(time),
+                      time_value)) {
+      continue;
+    }
+    idx_t row = series->times.size();
+    series->times.push_back(time_value);
 
     yyjson_val *data = yyjson_obj_get(ts, "data");
     if (data) {
       yyjson_val *instant = yyjson_obj_get(data, "instant");
       if (instant) {
-        yyjson_val *details = yyjson_obj_get(instant, "details");
-        if (details) {
-          point.air_temperature =
-              GetJsonDouble(details, "air_temperature", NAN);
-          point.relative_humidity =
-              GetJsonDouble(details, "relative_humidity", NAN);
-          point.wind_speed = GetJsonDouble(details, "wind_speed", NAN);
-          point.wind_from_direction =
-              GetJsonDouble(details, "wind_from_direction", NAN);
-          point.wind_speed_of_gust =
-              GetJsonDouble(details, "wind_speed_of_gust", NAN);
-          point.air_pressure_at_sea_level =
-              GetJsonDouble(details, "air_pressure_at_sea_level", NAN);
-          point.cloud_area_fraction =
-              GetJsonDouble(details, "cloud_area_fraction", NAN);
-        }
+        ParseMetDetails(yyjson_obj_get(instant, "details"),
+                        MetSection::INSTANT, field_count, row, *series);
       }
-
-      // Get precipitation from next_1_hours if available
       yyjson_val *next_1h = yyjson_obj_get(data, "next_1_hours");
       if (next_1h) {
-        yyjson_val *n1h_details = yyjson_obj_get(next_1h, "details");
-        if (n1h_details) {
-          point.precipitation_amount =
-              GetJsonDouble(n1h_details, "precipitation_amount", NAN);
-        }
+        ParseMetDetails(yyjson_obj_get(next_1h, "details"),
+                        MetSection::NEXT_1_HOURS, field_count, row, *series);
       }
     }
-
-    points.push_back(point);
   }
 
   yyjson_doc_free(doc);
-  return points;
+  for (auto &field : series->fields) {
+    field.resize(series->times.size());
+  }
+  return std::move(series);
+}
+
+// ParseMetJson, adding the parse time and the time steps to metrics
+static MetForecastRef ParseCountedMetJson(string &body, idx_t field_count,
+                                          WeatherScanMetrics &metrics) {
+  MetForecastRef forecast;
+  {
+    WeatherScanTimer timer(&metrics.decode_nanos);
+    forecast = ParseMetJson(body, field_count);
+  }
+  metrics.points_decoded += forecast->Size();
+  return forecast;
+}
+
+// ============================================================
+// Shared helpers
+// ============================================================
+
+static string GetMetUserAgent(ClientContext &context) {
+  Value user_agent_val;
+  if (context.TryGetCurrentSetting(MET_USER_AGENT_KEY, user_agent_val)) {
+    return user_agent_val.ToString();
+  }
+  return DEFAULT_USER_AGENT;
+}
+
+static string GetMetBaseUrl(ClientContext &context) {
+  Value base_url_val;
+  string base_url = DEFAULT_MET_BASE_URL;
+  if (context.TryGetCurrentSetting(MET_BASE_URL_KEY, base_url_val) &&
+      !base_url_val.IsNull()) {
+    base_url = base_url_val.ToString();
+  }
+  while (StringUtil::EndsWith(base_url, "/")) {
+    base_url.pop_back();
+  }
+  return base_url;
+}
+
+// endpoint := 'compact' (default) or 'complete'
+static void BindMetEndpoint(MetForecastBindData &bind_data,
+                            const named_parameter_map_t &named_parameters) {
+  for (auto &kv : named_parameters) {
+    if (kv.first == "endpoint") {
+      auto endpoint = StringUtil::Lower(kv.second.ToString());
+      if (endpoint == "complete") {
+        bind_data.complete = true;
+      } else if (endpoint != "compact") {
+        throw InvalidInputException(
+            "endpoint must be 'compact' or 'complete', got '%s'", endpoint);
+      }
+    }
+  }
+}
+
+static void SetMetForecastColumns(const MetForecastBindData &bind_data,
+                                  vector<LogicalType> &return_types,
+                                  vector<string> &names) {
+  names = {"time", "latitude", "longitude"};
+  return_types = {LogicalType::TIMESTAMP_TZ, LogicalType::DOUBLE,
+                  LogicalType::DOUBLE};
+  for (idx_t f = 0; f < bind_data.FieldCount(); f++) {
+    names.push_back(MET_FIELDS[f].column);
+    return_types.push_back(LogicalType::DOUBLE);
+  }
+}
+
+// api.met.no rejects coordinates with more than 4 decimals
+static string BuildMetForecastUrl(const string &base_url, double latitude,
+                                  double longitude, double altitude,
+                                  bool complete) {
+  string url = base_url + "/weatherapi/locationforecast/2.0/";
+  url += complete ? "complete?" : "compact?";
+  url += "lat=" + StringUtil::Format("%.4f", latitude);
+  url += "&lon=" + StringUtil::Format("%.4f", longitude);
+  if (altitude >= 0) {
+    url += "&altitude=" + StringUtil::Format("%.0f", altitude);
+  }
+  return url;
+}
+
+// Copy rows [begin, begin + count) of a forecast into output rows starting
+// at out_offset. Missing fields become NULL through the validity mask.
+static void WriteMetForecastRows(DataChunk &output, idx_t out_offset,
+                                 const MetForecastSeries &series, idx_t begin,
+                                 idx_t count, double latitude,
+                                 double longitude) {
+  auto times =
+      FlatVector::GetData<timestamp_tz_t>(output.data[0]) + out_offset;
+  auto latitudes = FlatVector::GetData<double>(output.data[1]) + out_offset;
+  auto longitudes = FlatVector::GetData<double>(output.data[2]) + out_offset;
+  for (idx_t i = 0; i < count; i++) {
+    times[i] = timestamp_tz_t(series.times[begin + i]);
+    latitudes[i] = latitude;
+    longitudes[i] = longitude;
+  }
+
+  for (idx_t f = 0; f < series.fields.size(); f++) {
+    auto &vec = output.data[MET_FIRST_FIELD_COLUMN + f];
+    auto data = FlatVector::GetData<double>(vec);
+    auto &validity = FlatVector::Validity(vec);
+    auto values = series.fields[f].data() + begin;
+    memcpy(data + out_offset, values, count * sizeof(double));
+    for (idx_t i = 0; i < count; i++) {
+      if (std::isnan(values[i])) {
+        validity.SetInvalid(out_offset + i);
+      }
+    }
+  }
 }
 
 // ============================================================
@@ -176,41 +390,10 @@ MetForecastBind(ClientContext &context, TableFunctionBindInput &input,
     bind_data->altitude = input.inputs[2].GetValue<double>();
   }
 
-  // Get User-Agent from settings or use default
-  Value user_agent_val;
-  if (context.TryGetCurrentSetting(MET_USER_AGENT_KEY, user_agent_val)) {
-    bind_data->user_agent = user_agent_val.ToString();
-  } else {
-    bind_data->user_agent = DEFAULT_USER_AGENT;
-  }
-
-  // Define output columns
-  names = {"time",
-           "latitude",
-           "longitude",
-           "temperature_celsius",
-           "humidity_percentage",
-           "wind_speed_ms",
-           "wind_direction_deg",
-           "wind_gust_ms",
-           "pressure_hpa",
-           "cloud_cover_percentage",
-           "precipitation_mm"};
-
-  return_types = {LogicalType::TIMESTAMP_TZ, // time
-                  LogicalType::DOUBLE,       // latitude
-                  LogicalType::DOUBLE,       // longitude
-                  LogicalType::DOUBLE,       // temperature_celsius
-                  LogicalType::DOUBLE,       // humidity_percentage
-                  LogicalType::DOUBLE,       // wind_speed_ms
-                  LogicalType::DOUBLE,       // wind_direction_deg
-                  LogicalType::DOUBLE,       // wind_gust_ms
-                  LogicalType::DOUBLE,       // pressure_hpa
-                  LogicalType::DOUBLE,       // cloud_cover_percentage
-                  LogicalType::DOUBLE};      // precipitation_mm
-
-  bind_data->column_names = names;
-  bind_data->column_types = return_types;
+  bind_data->user_agent = GetMetUserAgent(context);
+  bind_data->base_url = GetMetBaseUrl(context);
+  BindMetEndpoint(*bind_data, input.named_parameters);
+  SetMetForecastColumns(*bind_data, return_types, names);
 
   return std::move(bind_data);
 }
@@ -223,35 +406,29 @@ static unique_ptr<GlobalTableFunctionState>
 MetForecastInitGlobal(ClientContext &context, TableFunctionInitInput &input) {
   auto &bind_data = input.bind_data->Cast<MetForecastBindData>();
   auto state = make_uniq<MetForecastGlobalState>();
+  state->metrics = RegisterWeatherScan(context, "met_forecast");
 
   state->latitude = bind_data.latitude;
   state->longitude = bind_data.longitude;
 
-  // Build URL
-  string url = "https://api.met.no/weatherapi/locationforecast/2.0/compact?";
-  url += "lat=" + StringUtil::Format("%.6f", bind_data.latitude);
-  url += "&lon=" + StringUtil::Format("%.6f", bind_data.longitude);
-  if (bind_data.altitude >= 0) {
-    url += "&altitude=" + StringUtil::Format("%.0f", bind_data.altitude);
-  }
-
-  // Make HTTP request with custom User-Agent
-  auto &http_util = HTTPUtil::Get(*context.db);
-  auto params = http_util.InitializeParameters(context, url);
+  string url =
+      BuildMetForecastUrl(bind_data.base_url, bind_data.latitude,
+                          bind_data.longitude, bind_data.altitude,
+                          bind_data.complete);
 
+  // Make HTTP request with custom User-Agent. api.met.no requires clients
+  // to honor Expires and send If-Modified-Since, which the cache does.
   HTTPHeaders headers;
   headers["User-Agent"] = bind_data.user_agent;
-  GetRequestInfo get_request(url, headers, *params, nullptr, nullptr);
-
-  auto response = http_util.Request(get_request);
-
-  if (!response->Success()) {
-    throw IOException("MET API request failed with status %d for URL: %s",
-                      static_cast<int32_t>(response->status), url);
-  }
+  auto body =
+      WeatherHttpGetRevalidated(context, url, headers, state->metrics.get());
+  idx_t body_size = body.size();
+  state->metrics->AddBuffered(body_size);
 
   // Parse JSON response
-  state->data_points = ParseMetJson(response->body);
+  state->forecast =
+      ParseCountedMetJson(body, bind_data.FieldCount(), *state->metrics);
+  state->metrics->ReleaseBuffered(body_size);
 
   return std::move(state);
 }
@@ -262,69 +439,265 @@ MetForecastInitGlobal(ClientContext &context, TableFunctionInitInput &input) {
 
 static void MetForecastScan(ClientContext &context, TableFunctionInput &data,
                             DataChunk &output) {
+  auto &bind_data = data.bind_data->Cast<MetForecastBindData>();
   auto &state = data.global_state->Cast<MetForecastGlobalState>();
+  auto &forecast = *state.forecast;
 
-  if (state.finished) {
-    output.SetCardinality(0);
-    return;
+  idx_t end = forecast.Size();
+  if (bind_data.max_rows > 0) {
+    end = MinValue(end, bind_data.max_rows);
   }
+  idx_t count = MinValue<idx_t>(STANDARD_VECTOR_SIZE,
+                                end - MinValue(end, state.current_idx));
+  WriteMetForecastRows(output, 0, forecast, state.current_idx, count,
+                       state.latitude, state.longitude);
+  state.current_idx += count;
+  output.SetCardinality(count);
+}
 
-  idx_t count = 0;
-  idx_t max_count = STANDARD_VECTOR_SIZE;
+// ============================================================
+// In-out function: met_forecast_lateral(lat, lon [, altitude])
+// ============================================================
+
+// Forecasts fetched by any thread, keyed by request URL (which carries the
+// coordinates rounded to the API precision)
+struct MetLateralGlobalState : public GlobalTableFunctionState {
+  std::mutex lock;
+  std::unordered_map<string, MetForecastRef> forecasts;
+  idx_t max_requests = DEFAULT_MET_MAX_CONCURRENT_REQUESTS;
+  shared_ptr<WeatherScanMetrics> metrics;
+
+  idx_t MaxThreads() const override {
+    return GlobalTableFunctionState::MAX_THREADS;
+  }
+
+  MetForecastRef Find(const string &url) {
+    std::lock_guard<std::mutex> guard(lock);
+    auto it = forecasts.find(url);
+    return it == forecasts.end() ? nullptr : it->second;
+  }
+};
+
+// An input row waiting to be emitted, once its forecast has arrived
+struct MetLateralRow {
+  double latitude;
+  double longitude;
+  MetForecastRef forecast;
+};
+
+// Work for the current input chunk
+struct MetLateralLocalState : public LocalTableFunctionState {
+  ClientContext *context_ptr = nullptr;
+  bool chunk_started = false;
+
+  vector<MetLateralRow> rows;
+  // Rows per distinct request URL still being fetched
+  std::unordered_map<string, vector<idx_t>> pending_rows;
+  vector<string> pool_urls;
+  // Only for chunks with more than one location to fetch
+  unique_ptr<WeatherFetchPool> pool;
+
+  // Rows with a forecast, in arrival order, and the cursor into the first
+  std::deque<idx_t> ready_rows;
+  idx_t point_idx = 0;
+
+  void Reset() {
+    chunk_started = false;
+    rows.clear();
+    pending_rows.clear();
+    pool_urls.clear();
+    pool.reset();
+    ready_rows.clear();
+    point_idx = 0;
+  }
+};
+
+static unique_ptr<FunctionData>
+MetLateralBind(ClientContext &context, TableFunctionBindInput &input,
+               vector<LogicalType> &return_types, vector<string> &names) {
+  auto bind_data = make_uniq<MetForecastBindData>();
+
+  // Table input: met_forecast_lateral((SELECT lat, lon[, altitude] ...))
+  auto &input_types = input.input_table_types;
+  if (input_types.size() < 2 || input_types.size() > 3) {
+    throw InvalidInputException("met_forecast_lateral requires latitude, "
+                                "longitude and optional altitude columns");
+  }
+  for (auto &type : input_types) {
+    if (!type.IsNumeric()) {
+      throw InvalidInputException(
+          "met_forecast_lateral input columns must be numeric, got %s",
+          type.ToString());
+    }
+  }
+
+  bind_data->user_agent = GetMetUserAgent(context);
+  bind_data->base_url = GetMetBaseUrl(context);
+  BindMetEndpoint(*bind_data, input.named_parameters);
+  SetMetForecastColumns(*bind_data, return_types, names);
+  return std::move(bind_data);
+}
+
+static unique_ptr<GlobalTableFunctionState>
+MetLateralInitGlobal(ClientContext &context, TableFunctionInitInput &input) {
+  auto state = make_uniq<MetLateralGlobalState>();
+  state->metrics = RegisterWeatherScan(context, "met_forecast_lateral");
+  Value max_requests_val;
+  if (context.TryGetCurrentSetting(MET_MAX_CONCURRENT_REQUESTS_KEY,
+                                   max_requests_val)) {
+    state->max_requests = max_requests_val.GetValue<idx_t>();
+  }
+  if (state->max_requests == 0) {
+    throw InvalidInputException("%s must be at least 1",
+                                MET_MAX_CONCURRENT_REQUESTS_KEY);
+  }
+  return std::move(state);
+}
+
+static unique_ptr<LocalTableFunctionState>
+MetLateralInitLocal(ExecutionContext &context, TableFunctionInitInput &input,
+                    GlobalTableFunctionState *global_state) {
+  auto state = make_uniq<MetLateralLocalState>();
+  state->context_ptr = &context.client;
+  return std::move(state);
+}
+
+// Collect the rows of a new input chunk. Forecasts already fetched are ready
+// immediately; each remaining distinct location is requested once.
+static void StartMetLateralChunk(MetLateralGlobalState &gstate,
+                                 MetLateralLocalState &lstate,
+                                 const MetForecastBindData &bind_data,
+                                 DataChunk &input) {
+  lstate.chunk_started = true;
+  bool has_altitude = input.ColumnCount() > 2;
+  for (idx_t i = 0; i < input.size(); i++) {
+    auto lat_val = input.GetValue(0, i);
+    auto lon_val = input.GetValue(1, i);
+    if (lat_val.IsNull() || lon_val.IsNull()) {
+      continue;
+    }
+    MetLateralRow row;
+    row.latitude = lat_val.GetValue<double>();
+    row.longitude = lon_val.GetValue<double>();
+    double altitude = -1.0;
+    if (has_altitude) {
+      auto alt_val = input.GetValue(2, i);
+      if (!alt_val.IsNull()) {
+        altitude = alt_val.GetValue<double>();
+      }
+    }
+
+    auto url = BuildMetForecastUrl(bind_data.base_url, row.latitude,
+                                   row.longitude, altitude,
+                                   bind_data.complete);
+    row.forecast = gstate.Find(url);
+    idx_t row_idx = lstate.rows.size();
+    lstate.rows.push_back(std::move(row));
+    if (lstate.rows.back().forecast) {
+      lstate.ready_rows.push_back(row_idx);
+      continue;
+    }
+    auto &waiting = lstate.pending_rows[url];
+    if (waiting.empty()) {
+      lstate.pool_urls.push_back(url);
+    }
+    waiting.push_back(row_idx);
+  }
+
+  // A single location, as a LATERAL join passes row by row, is fetched on
+  // this thread instead of starting pool threads for it
+  if (lstate.pool_urls.size() > 1) {
+    HTTPHeaders headers;
+    headers["User-Agent"] = bind_data.user_agent;
+    lstate.pool = make_uniq<WeatherFetchPool>(
+        *lstate.context_ptr, lstate.pool_urls, gstate.max_requests,
+        std::move(headers), WeatherCachePolicy::REVALIDATE, gstate.metrics);
+  }
+}
+
+// Block for the next response of the chunk and mark its rows ready
+static void ReceiveMetLateralResponse(MetLateralGlobalState &gstate,
+                                      MetLateralLocalState &lstate,
+                                      const MetForecastBindData &bind_data) {
+  WeatherFetchResult result;
+  if (!lstate.pool) {
+    HTTPHeaders headers;
+    headers["User-Agent"] = bind_data.user_agent;
+    result.body = WeatherHttpGetRevalidated(
+        *lstate.context_ptr, lstate.pool_urls[0], headers,
+        gstate.metrics.get());
+    // Buffered until parsed, as the pool counts its bodies
+    gstate.metrics->AddBuffered(result.body.size());
+  } else if (!lstate.pool->Next(result)) {
+    throw InternalException("met_forecast_lateral: fetch pool ended early");
+  }
+  // Parsing pads the body, release what was counted first
+  gstate.metrics->ReleaseBuffered(result.body.size());
+  auto &url = lstate.pool_urls[result.url_idx];
+  if (!result.error.empty()) {
+    throw IOException("MET API request failed: %s", result.error);
+  }
 
-  while (count < max_count && state.current_idx < state.data_points.size()) {
-    auto &point = state.data_points[state.current_idx];
+  auto forecast = ParseCountedMetJson(result.body, bind_data.FieldCount(),
+                                      *gstate.metrics);
+  {
+    std::lock_guard<std::mutex> guard(gstate.lock);
+    gstate.forecasts[url] = forecast;
+  }
+  for (auto row_idx : lstate.pending_rows[url]) {
+    lstate.rows[row_idx].forecast = forecast;
+    lstate.ready_rows.push_back(row_idx);
+  }
+  lstate.pending_rows.erase(url);
+}
 
-    // Parse timestamp (ISO 8601 format: 2026-01-20T12:00:00Z)
-    timestamp_t ts;
-    if (!point.time.empty()) {
-      ts = Timestamp::FromString(point.time, true); // true = use_offset for TZ
+static OperatorResultType MetLateralFunction(ExecutionContext &context,
+                                             TableFunctionInput &data,
+                                             DataChunk &input,
+                                             DataChunk &output) {
+  auto &gstate = data.global_state->Cast<MetLateralGlobalState>();
+  auto &lstate = data.local_state->Cast<MetLateralLocalState>();
+  auto &bind_data = data.bind_data->Cast<MetForecastBindData>();
+
+  if (!lstate.chunk_started) {
+    StartMetLateralChunk(gstate, lstate, bind_data, input);
+  }
+
+  idx_t count = 0;
+  while (count < STANDARD_VECTOR_SIZE) {
+    if (lstate.ready_rows.empty()) {
+      if (lstate.pending_rows.empty()) {
+        break;
+      }
+      // Hand out what we have before waiting on the network
+      if (count > 0) {
+        output.SetCardinality(count);
+        return OperatorResultType::HAVE_MORE_OUTPUT;
+      }
+      ReceiveMetLateralResponse(gstate, lstate, bind_data);
+      continue;
     }
 
-    output.SetValue(0, count, Value::TIMESTAMPTZ(timestamp_tz_t(ts)));
-    output.SetValue(1, count, Value(state.latitude));
-    output.SetValue(2, count, Value(state.longitude));
-    output.SetValue(3, count,
-                    std::isnan(point.air_temperature)
-                        ? Value()
-                        : Value(point.air_temperature));
-    output.SetValue(4, count,
-                    std::isnan(point.relative_humidity)
-                        ? Value()
-                        : Value(point.relative_humidity));
-    output.SetValue(5, count,
-                    std::isnan(point.wind_speed) ? Value()
-                                                 : Value(point.wind_speed));
-    output.SetValue(6, count,
-                    std::isnan(point.wind_from_direction)
-                        ? Value()
-                        : Value(point.wind_from_direction));
-    output.SetValue(7, count,
-                    std::isnan(point.wind_speed_of_gust)
-                        ? Value()
-                        : Value(point.wind_speed_of_gust));
-    output.SetValue(8, count,
-                    std::isnan(point.air_pressure_at_sea_level)
-                        ? Value()
-                        : Value(point.air_pressure_at_sea_level));
-    output.SetValue(9, count,
-                    std::isnan(point.cloud_area_fraction)
-                        ? Value()
-                        : Value(point.cloud_area_fraction));
-    output.SetValue(10, count,
-                    std::isnan(point.precipitation_amount)
-                        ? Value()
-                        : Value(point.precipitation_amount));
-
-    state.current_idx++;
-    count++;
-  }
-
-  if (state.current_idx >= state.data_points.size()) {
-    state.finished = true;
+    auto &row = lstate.rows[lstate.ready_rows.front()];
+    auto &forecast = *row.forecast;
+    idx_t rows = MinValue<idx_t>(STANDARD_VECTOR_SIZE - count,
+                                 forecast.Size() - lstate.point_idx);
+    WriteMetForecastRows(output, count, forecast, lstate.point_idx, rows,
+                         row.latitude, row.longitude);
+    lstate.point_idx += rows;
+    count += rows;
+    if (lstate.point_idx >= forecast.Size()) {
+      lstate.ready_rows.pop_front();
+      lstate.point_idx = 0;
+    }
   }
 
   output.SetCardinality(count);
+  if (lstate.ready_rows.empty() && lstate.pending_rows.empty()) {
+    lstate.Reset();
+    return OperatorResultType::NEED_MORE_INPUT;
+  }
+  return OperatorResultType::HAVE_MORE_OUTPUT;
 }
 
 // ============================================================
@@ -340,6 +713,10 @@ void RegisterMetForecastFunction(ExtensionLoader &loader) {
       MET_USER_AGENT_KEY,
       "User-Agent header for MET Norway API requests (api.met.no)",
       LogicalType::VARCHAR, Value(DEFAULT_USER_AGENT));
+  config.AddExtensionOption(
+      MET_BASE_URL_KEY,
+      "Base URL of the MET Norway API (scheme and host, e.g. a local mock)",
+      LogicalType::VARCHAR, Value(DEFAULT_MET_BASE_URL));
 
   // Create table function
   TableFunction func("met_forecast",
@@ -348,8 +725,36 @@ void RegisterMetForecastFunction(ExtensionLoader &loader) {
 
   // Add optional altitude parameter
   func.named_parameters["altitude"] = LogicalType::DOUBLE;
+  func.named_parameters["endpoint"] = LogicalType::VARCHAR;
+  func.dynamic_to_string = WeatherScanDynamicToString<MetForecastGlobalState>;
 
   loader.RegisterFunction(func);
+
+  config.AddExtensionOption(
+      MET_MAX_CONCURRENT_REQUESTS_KEY,
+      "Maximum number of concurrent MET Norway API requests per "
+      "met_forecast_lateral thread",
+      LogicalType::UBIGINT,
+      Value::UBIGINT(DEFAULT_MET_MAX_CONCURRENT_REQUESTS));
+
+  // In-out function for many locations, either over a whole table, with
+  // requests in flight concurrently, or per row in a LATERAL join, one
+  // request after the other:
+  //   SELECT * FROM met_forecast_lateral((SELECT lat, lon FROM sites))
+  //   SELECT * FROM sites, LATERAL met_forecast_lateral(sites.lat, sites.lon)
+  TableFunctionSet lateral_set("met_forecast_lateral");
+  for (auto &arguments : vector<vector<LogicalType>>{
+           {LogicalType::DOUBLE, LogicalType::DOUBLE},
+           {LogicalType::DOUBLE, LogicalType::DOUBLE, LogicalType::DOUBLE},
+           {LogicalType::TABLE}}) {
+    TableFunction lateral("met_forecast_lateral", arguments, nullptr,
+                          MetLateralBind, MetLateralInitGlobal,
+                          MetLateralInitLocal);
+    lateral.in_out_function = MetLateralFunction;
+    lateral.named_parameters["endpoint"] = LogicalType::VARCHAR;
+    lateral_set.AddFunction(lateral);
+  }
+  loader.RegisterFunction(lateral_set);
 }
 
 } // namespace duckdb
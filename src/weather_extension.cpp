@@ -10,17 +10,24 @@
 #include "grib_function.hpp"
 #include "met_forecast_function.hpp"
 #include "weather_function.hpp"
+#include "weather_http.hpp"
+#include "weather_limit.hpp"
+#include "weather_metrics.hpp"
 
 namespace duckdb {
 
 // Optimizer for LIMIT pushdown
 static void WeatherOptimizer(OptimizerExtensionInput &input,
                              unique_ptr<LogicalOperator> &plan) {
-  OptimizeGfsForecastLimitPushdown(plan);
+  OptimizeWeatherLimitPushdown(plan);
 }
 
 static void LoadInternal(ExtensionLoader &loader) {
   auto &db = loader.GetDatabaseInstance();
+  auto &config = DBConfig::GetConfig(db);
+
+  // Register download cache settings shared by all functions
+  RegisterWeatherHttpSettings(config);
 
   // Register GRIB2 ENUM types first
   RegisterGribEnumTypes(db);
@@ -37,8 +44,10 @@ static void LoadInternal(ExtensionLoader &loader) {
   // Register weather utility macros (kelvin_to_celsius, wind_speed, etc.)
   RegisterWeatherFunction(loader);
 
+  // Register weather_scan_stats() for the counters of the last scans
+  RegisterWeatherScanStatsFunction(loader);
+
   // Register optimizer extension for LIMIT pushdown
-  auto &config = DBConfig::GetConfig(db);
   OptimizerExtension optimizer;
   optimizer.optimize_function = WeatherOptimizer;
   config.optimizer_extensions.push_back(std::move(optimizer));
@@ -1,6 +1,7 @@
 #include "weather_function.hpp"
 #include "duckdb/common/exception.hpp"
 #include "duckdb/common/types/value.hpp"
+#include "duckdb/common/vector_operations/unary_executor.hpp"
 #include "duckdb/function/scalar_function.hpp"
 #include "duckdb/main/client_context.hpp"
 #include "duckdb/main/connection.hpp"
@@ -8,6 +9,251 @@
 
 namespace duckdb {
 
+// ============ Native Weather Functions ============
+//
+// The numeric formulas are scalar functions over DOUBLE vectors. Inputs
+// without NULLs take a tight loop over the raw arrays; otherwise each row
+// follows the NULL rules of the CASE expressions these functions replaced.
+
+// Shared by heat_index() and feels_like(); valid for temp_c >= 27
+static inline double HeatIndexFormula(double t, double rh) {
+  return -8.785 + 1.611 * t + 2.339 * rh - 0.146 * t * rh - 0.013 * t * t -
+         0.016 * rh * rh + 0.002 * t * t * rh + 0.001 * t * rh * rh -
+         0.000002 * t * t * rh * rh;
+}
+
+// Shared by wind_chill() and feels_like(); valid for temp_c <= 10
+static inline double WindChillFormula(double t, double wind_kmh) {
+  double w = std::pow(wind_kmh, 0.16);
+  return 13.12 + 0.6215 * t - 11.37 * w + 0.3965 * t * w;
+}
+
+// Default rules: NULL in any argument gives NULL, every value is defined
+struct WeatherOperatorBase {
+  static constexpr bool HAS_NULL_RESULTS = false;
+  static inline bool ResultIsNull(double, double) { return false; }
+  static inline bool ResultIsValid(bool a_valid, bool b_valid, double) {
+    return a_valid && b_valid;
+  }
+};
+
+struct WindSpeedOperator : public WeatherOperatorBase {
+  static inline double Operation(double u, double v) {
+    return std::sqrt(u * u + v * v);
+  }
+};
+
+static constexpr double RADIANS_TO_DEGREES = 57.295779513082320876;
+
+// Meteorological direction the wind blows from, NULL when calm
+struct WindDirectionOperator : public WeatherOperatorBase {
+  static constexpr bool HAS_NULL_RESULTS = true;
+  static inline bool ResultIsNull(double u, double v) {
+    return u == 0 && v == 0;
+  }
+  static inline double Operation(double u, double v) {
+    return std::fmod(std::atan2(-u, -v) * RADIANS_TO_DEGREES + 360.0, 360.0);
+  }
+};
+
+// Magnus formula approximation; NULL for non-positive humidity
+struct DewPointOperator : public WeatherOperatorBase {
+  static constexpr bool HAS_NULL_RESULTS = true;
+  static inline bool ResultIsNull(double, double rh) { return !(rh > 0); }
+  static inline double Operation(double t, double rh) {
+    double gamma = std::log(rh / 100.0) + (17.625 * t) / (243.04 + t);
+    return 243.04 * gamma / (17.625 - gamma);
+  }
+};
+
+// Simplified Rothfusz regression, temp_c below 27 is returned as is
+struct HeatIndexOperator : public WeatherOperatorBase {
+  static inline bool ResultIsValid(bool t_valid, bool rh_valid, double t) {
+    return t_valid && (t < 27 || rh_valid);
+  }
+  static inline double Operation(double t, double rh) {
+    return t < 27 ? t : HeatIndexFormula(t, rh);
+  }
+};
+
+// Environment Canada formula, applies at <= 10 C and >= 4.8 km/h
+struct WindChillOperator : public WeatherOperatorBase {
+  static inline bool ResultIsValid(bool t_valid, bool w_valid, double t) {
+    return t_valid && (t > 10 || w_valid);
+  }
+  static inline double Operation(double t, double wind_kmh) {
+    return t > 10 || wind_kmh < 4.8 ? t : WindChillFormula(t, wind_kmh);
+  }
+};
+
+template <class OP>
+static void WeatherBinaryFunction(DataChunk &args, ExpressionState &state,
+                                  Vector &result) {
+  idx_t count = args.size();
+  auto &left = args.data[0];
+  auto &right = args.data[1];
+
+  UnifiedVectorFormat ldata, rdata;
+  left.ToUnifiedFormat(count, ldata);
+  right.ToUnifiedFormat(count, rdata);
+  auto lvalues = UnifiedVectorFormat::GetData<double>(ldata);
+  auto rvalues = UnifiedVectorFormat::GetData<double>(rdata);
+
+  bool constant = left.GetVectorType() == VectorType::CONSTANT_VECTOR &&
+                  right.GetVectorType() == VectorType::CONSTANT_VECTOR;
+  if (constant) {
+    result.SetVectorType(VectorType::CONSTANT_VECTOR);
+    count = 1;
+  } else {
+    result.SetVectorType(VectorType::FLAT_VECTOR);
+  }
+  auto out = FlatVector::GetData<double>(result);
+  auto &mask = FlatVector::Validity(result);
+
+  bool flat = left.GetVectorType() == VectorType::FLAT_VECTOR &&
+              right.GetVectorType() == VectorType::FLAT_VECTOR;
+  if (flat && ldata.validity.AllValid() && rdata.validity.AllValid()) {
+    // No NULLs: straight loop the compiler can vectorize
+    for (idx_t i = 0; i < count; i++) {
+      out[i] = OP::Operation(lvalues[i], rvalues[i]);
+    }
+    if (OP::HAS_NULL_RESULTS) {
+      for (idx_t i = 0; i < count; i++) {
+        if (OP::ResultIsNull(lvalues[i], rvalues[i])) {
+          mask.SetInvalid(i);
+        }
+      }
+    }
+    return;
+  }
+
+  for (idx_t i = 0; i < count; i++) {
+    auto lidx = ldata.sel->get_index(i);
+    auto ridx = rdata.sel->get_index(i);
+    bool lvalid = ldata.validity.RowIsValid(lidx);
+    bool rvalid = rdata.validity.RowIsValid(ridx);
+    // A NULL argument is only read by branches ResultIsValid rules out
+    double l = lvalid ? lvalues[lidx] : NAN;
+    double r = rvalid ? rvalues[ridx] : NAN;
+    if (!OP::ResultIsValid(lvalid, rvalid, l) ||
+        (lvalid && rvalid && OP::ResultIsNull(l, r))) {
+      if (constant) {
+        ConstantVector::SetNull(result, true);
+      } else {
+        mask.SetInvalid(i);
+      }
+      continue;
+    }
+    out[i] = OP::Operation(l, r);
+  }
+}
+
+// Heat index when hot and humid, wind chill when cold and windy, otherwise
+// the temperature itself
+static inline double FeelsLike(double t, double rh, double wind_kmh) {
+  if (t >= 27 && rh >= 40) {
+    return HeatIndexFormula(t, rh);
+  }
+  if (t <= 10 && wind_kmh >= 4.8) {
+    return WindChillFormula(t, wind_kmh);
+  }
+  return t;
+}
+
+// Only a NULL temperature gives NULL; a NULL humidity or wind skips that
+// branch (NaN fails both comparisons)
+static void FeelsLikeFunction(DataChunk &args, ExpressionState &state,
+                              Vector &result) {
+  idx_t count = args.size();
+  UnifiedVectorFormat tdata, rhdata, wdata;
+  args.data[0].ToUnifiedFormat(count, tdata);
+  args.data[1].ToUnifiedFormat(count, rhdata);
+  args.data[2].ToUnifiedFormat(count, wdata);
+  auto tvalues = UnifiedVectorFormat::GetData<double>(tdata);
+  auto rhvalues = UnifiedVectorFormat::GetData<double>(rhdata);
+  auto wvalues = UnifiedVectorFormat::GetData<double>(wdata);
+
+  bool constant = true;
+  bool flat = true;
+  for (auto &arg : args.data) {
+    constant = constant && arg.GetVectorType() == VectorType::CONSTANT_VECTOR;
+    flat = flat && arg.GetVectorType() == VectorType::FLAT_VECTOR;
+  }
+  if (constant) {
+    result.SetVectorType(VectorType::CONSTANT_VECTOR);
+    count = 1;
+  } else {
+    result.SetVectorType(VectorType::FLAT_VECTOR);
+  }
+  auto out = FlatVector::GetData<double>(result);
+  auto &mask = FlatVector::Validity(result);
+
+  if (flat && tdata.validity.AllValid() && rhdata.validity.AllValid() &&
+      wdata.validity.AllValid()) {
+    for (idx_t i = 0; i < count; i++) {
+      out[i] = FeelsLike(tvalues[i], rhvalues[i], wvalues[i]);
+    }
+    return;
+  }
+
+  for (idx_t i = 0; i < count; i++) {
+    auto tidx = tdata.sel->get_index(i);
+    auto rhidx = rhdata.sel->get_index(i);
+    auto widx = wdata.sel->get_index(i);
+    if (!tdata.validity.RowIsValid(tidx)) {
+      if (constant) {
+        ConstantVector::SetNull(result, true);
+      } else {
+        mask.SetInvalid(i);
+      }
+      continue;
+    }
+    double rh = rhdata.validity.RowIsValid(rhidx) ? rhvalues[rhidx] : NAN;
+    double w = wdata.validity.RowIsValid(widx) ? wvalues[widx] : NAN;
+    out[i] = FeelsLike(tvalues[tidx], rh, w);
+  }
+}
+
+// Beaufort scale (wind force 0-12) from m/s
+static const double BEAUFORT_LIMITS[] = {0.5,  1.6,  3.4,  5.5,  8.0,  10.8,
+                                         13.9, 17.2, 20.8, 24.5, 28.5, 32.7};
+
+static void BeaufortScaleFunction(DataChunk &args, ExpressionState &state,
+                                  Vector &result) {
+  UnaryExecutor::Execute<double, int32_t>(
+      args.data[0], result, args.size(), [](double wind_ms) {
+        int32_t force = 0;
+        for (auto limit : BEAUFORT_LIMITS) {
+          force += wind_ms >= limit;
+        }
+        return force;
+      });
+}
+
+// These used to be SQL macros. Macros of the same name left in a database
+// file by earlier versions shadow them; they are not dropped here, since a
+// macro of that name may just as well be the user's own (see the README).
+static void RegisterNativeWeatherFunctions(ExtensionLoader &loader) {
+  auto dbl = LogicalType::DOUBLE;
+  loader.RegisterFunction(ScalarFunction("wind_speed", {dbl, dbl}, dbl,
+                                         WeatherBinaryFunction<
+                                             WindSpeedOperator>));
+  loader.RegisterFunction(ScalarFunction(
+      "wind_direction", {dbl, dbl}, dbl,
+      WeatherBinaryFunction<WindDirectionOperator>));
+  loader.RegisterFunction(ScalarFunction(
+      "dew_point", {dbl, dbl}, dbl, WeatherBinaryFunction<DewPointOperator>));
+  loader.RegisterFunction(ScalarFunction(
+      "heat_index", {dbl, dbl}, dbl, WeatherBinaryFunction<HeatIndexOperator>));
+  loader.RegisterFunction(ScalarFunction(
+      "wind_chill", {dbl, dbl}, dbl, WeatherBinaryFunction<WindChillOperator>));
+  loader.RegisterFunction(
+      ScalarFunction("feels_like", {dbl, dbl, dbl}, dbl, FeelsLikeFunction));
+  loader.RegisterFunction(ScalarFunction("beaufort_scale", {dbl},
+                                         LogicalType::INTEGER,
+                                         BeaufortScaleFunction));
+}
+
 // ============ Weather Utility Macros ============
 
 void RegisterWeatherMacros(ExtensionLoader &loader) {
@@ -28,17 +274,7 @@ void RegisterWeatherMacros(ExtensionLoader &loader) {
 		CREATE OR REPLACE MACRO fahrenheit_to_celsius(f) AS (f - 32) * 5.0/9.0
 	)");
 
-  // Wind calculations
-  conn.Query(R"(
-		CREATE OR REPLACE MACRO wind_speed(u, v) AS sqrt(u*u + v*v)
-	)");
-  conn.Query(R"(
-		CREATE OR REPLACE MACRO wind_direction(u, v) AS
-			CASE
-				WHEN u = 0 AND v = 0 THEN NULL
-				ELSE (degrees(atan2(-u, -v)) + 360) % 360
-			END
-	)");
+  // Wind speed unit conversions
   conn.Query(R"(
 		CREATE OR REPLACE MACRO wind_speed_kmh(ms) AS ms * 3.6
 	)");
@@ -60,66 +296,6 @@ void RegisterWeatherMacros(ExtensionLoader &loader) {
 		CREATE OR REPLACE MACRO inhg_to_hpa(inhg) AS inhg / 0.02953
 	)");
 
-  // Dew point calculation (Magnus formula approximation)
-  conn.Query(R"(
-		CREATE OR REPLACE MACRO dew_point(temp_c, rh) AS
-			243.04 * (ln(rh/100.0) + (17.625 * temp_c)/(243.04 + temp_c)) /
-			(17.625 - ln(rh/100.0) - (17.625 * temp_c)/(243.04 + temp_c))
-	)");
-
-  // Heat index (simplified Rothfusz regression)
-  // Valid for temps >= 27°C and RH >= 40%
-  conn.Query(R"(
-		CREATE OR REPLACE MACRO heat_index(temp_c, rh) AS
-			CASE
-				WHEN temp_c < 27 THEN temp_c
-				ELSE -8.785 + 1.611*temp_c + 2.339*rh - 0.146*temp_c*rh
-					- 0.013*temp_c*temp_c - 0.016*rh*rh + 0.002*temp_c*temp_c*rh
-					+ 0.001*temp_c*rh*rh - 0.000002*temp_c*temp_c*rh*rh
-			END
-	)");
-
-  // Wind chill (Environment Canada formula)
-  // Valid for temps <= 10°C and wind >= 4.8 km/h
-  conn.Query(R"(
-		CREATE OR REPLACE MACRO wind_chill(temp_c, wind_kmh) AS
-			CASE
-				WHEN temp_c > 10 OR wind_kmh < 4.8 THEN temp_c
-				ELSE 13.12 + 0.6215*temp_c - 11.37*power(wind_kmh, 0.16)
-					+ 0.3965*temp_c*power(wind_kmh, 0.16)
-			END
-	)");
-
-  // Apparent temperature (feels like) - combines heat index and wind chill
-  conn.Query(R"(
-		CREATE OR REPLACE MACRO feels_like(temp_c, rh, wind_kmh) AS
-			CASE
-				WHEN temp_c >= 27 AND rh >= 40 THEN heat_index(temp_c, rh)
-				WHEN temp_c <= 10 AND wind_kmh >= 4.8 THEN wind_chill(temp_c, wind_kmh)
-				ELSE temp_c
-			END
-	)");
-
-  // Beaufort scale (wind force 0-12)
-  conn.Query(R"(
-		CREATE OR REPLACE MACRO beaufort_scale(wind_ms) AS
-			CASE
-				WHEN wind_ms < 0.5 THEN 0   -- Calm
-				WHEN wind_ms < 1.6 THEN 1   -- Light air
-				WHEN wind_ms < 3.4 THEN 2   -- Light breeze
-				WHEN wind_ms < 5.5 THEN 3   -- Gentle breeze
-				WHEN wind_ms < 8.0 THEN 4   -- Moderate breeze
-				WHEN wind_ms < 10.8 THEN 5  -- Fresh breeze
-				WHEN wind_ms < 13.9 THEN 6  -- Strong breeze
-				WHEN wind_ms < 17.2 THEN 7  -- High wind
-				WHEN wind_ms < 20.8 THEN 8  -- Gale
-				WHEN wind_ms < 24.5 THEN 9  -- Strong gale
-				WHEN wind_ms < 28.5 THEN 10 -- Storm
-				WHEN wind_ms < 32.7 THEN 11 -- Violent storm
-				ELSE 12                      -- Hurricane
-			END
-	)");
-
   // Beaufort description
   conn.Query(R"(
 		CREATE OR REPLACE MACRO beaufort_description(wind_ms) AS
@@ -222,8 +398,9 @@ void RegisterWeatherMacros(ExtensionLoader &loader) {
 }
 
 void RegisterWeatherFunction(ExtensionLoader &loader) {
-  // Register macros
+  // Unit conversions and categories as macros, formulas as native functions
   RegisterWeatherMacros(loader);
+  RegisterNativeWeatherFunctions(loader);
 }
 
 } // namespace duckdb
@@ -0,0 +1,1138 @@
+#include "weather_http.hpp"
+#include "duckdb/common/file_system.hpp"
+#include "duckdb/common/string_util.hpp"
+#include "duckdb/common/types/date.hpp"
+#include "duckdb/common/types/hash.hpp"
+#include "duckdb/common/types/time.hpp"
+#include "duckdb/common/types/timestamp.hpp"
+#include "duckdb/main/client_context.hpp"
+#include "duckdb/main/config.hpp"
+#include "duckdb/common/random_engine.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <unordered_map>
+
+namespace duckdb {
+
+static constexpr const char *CACHE_DIRECTORY_KEY = "weather_cache_directory";
+static constexpr const char *CACHE_MAX_SIZE_KEY = "weather_cache_max_size";
+static constexpr const char *CACHE_TTL_KEY = "weather_cache_ttl_seconds";
+static constexpr const char *DEFAULT_CACHE_MAX_SIZE = "4GB";
+static constexpr const char *HTTP_RETRIES_KEY = "weather_http_retries";
+static constexpr const char *HTTP_RETRY_WAIT_KEY = "weather_http_retry_wait_ms";
+static constexpr const char *HTTP_RETRY_MAX_WAIT_KEY =
+    "weather_http_retry_max_wait_ms";
+static constexpr const char *HTTP_MAX_HOST_REQUESTS_KEY =
+    "weather_http_max_host_requests";
+static constexpr const char *HTTP_HOST_RATE_KEY =
+    "weather_http_host_requests_per_second";
+static constexpr idx_t DEFAULT_HTTP_RETRIES = 5;
+static constexpr idx_t DEFAULT_HTTP_RETRY_WAIT_MS = 500;
+static constexpr idx_t DEFAULT_HTTP_RETRY_MAX_WAIT_MS = 60000;
+static constexpr idx_t DEFAULT_HTTP_MAX_HOST_REQUESTS = 8;
+
+void RegisterWeatherHttpSettings(DBConfig &config) {
+  config.AddExtensionOption(
+      CACHE_DIRECTORY_KEY,
+      "Directory for cached GRIB downloads and MET responses (empty disables "
+      "the cache)",
+      LogicalType::VARCHAR, Value(""));
+  config.AddExtensionOption(
+      CACHE_MAX_SIZE_KEY,
+      "Maximum size of the download cache, least recently used entries are "
+      "evicted beyond it (e.g. '4GB')",
+      LogicalType::VARCHAR, Value(DEFAULT_CACHE_MAX_SIZE));
+  config.AddExtensionOption(
+      CACHE_TTL_KEY,
+      "Seconds a cached GRIB download stays valid (0 = forever, model runs "
+      "are immutable once published)",
+      LogicalType::UBIGINT, Value::UBIGINT(0));
+  config.AddExtensionOption(
+      HTTP_RETRIES_KEY,
+      "Retries of a weather HTTP request after connection errors, "
+      "interrupted transfers and 408/425/429/5xx answers",
+      LogicalType::UBIGINT, Value::UBIGINT(DEFAULT_HTTP_RETRIES));
+  config.AddExtensionOption(
+      HTTP_RETRY_WAIT_KEY,
+      "Backoff before the first retry in milliseconds, doubled per retry and "
+      "jittered",
+      LogicalType::UBIGINT, Value::UBIGINT(DEFAULT_HTTP_RETRY_WAIT_MS));
+  config.AddExtensionOption(
+      HTTP_RETRY_MAX_WAIT_KEY,
+      "Longest backoff between retries in milliseconds, also caps Retry-After",
+      LogicalType::UBIGINT, Value::UBIGINT(DEFAULT_HTTP_RETRY_MAX_WAIT_MS));
+  config.AddExtensionOption(
+      HTTP_MAX_HOST_REQUESTS_KEY,
+      "Weather HTTP requests in flight to one host across all scans (0 = "
+      "unlimited)",
+      LogicalType::UBIGINT, Value::UBIGINT(DEFAULT_HTTP_MAX_HOST_REQUESTS));
+  config.AddExtensionOption(
+      HTTP_HOST_RATE_KEY,
+      "Weather HTTP requests started per second to one host across all scans "
+      "(0 = unlimited)",
+      LogicalType::DOUBLE, Value::DOUBLE(0));
+}
+
+static idx_t GetUnsignedSetting(ClientContext &context, const char *key,
+                                idx_t default_value) {
+  Value value;
+  if (context.TryGetCurrentSetting(key, value) && !value.IsNull()) {
+    return value.GetValue<idx_t>();
+  }
+  return default_value;
+}
+
+WeatherHttpSettings::WeatherHttpSettings(ClientContext &context)
+    : retries(
+          GetUnsignedSetting(context, HTTP_RETRIES_KEY, DEFAULT_HTTP_RETRIES)),
+      retry_wait_ms(GetUnsignedSetting(context, HTTP_RETRY_WAIT_KEY,
+                                       DEFAULT_HTTP_RETRY_WAIT_MS)),
+      retry_max_wait_ms(GetUnsignedSetting(context, HTTP_RETRY_MAX_WAIT_KEY,
+                                           DEFAULT_HTTP_RETRY_MAX_WAIT_MS)),
+      max_host_requests(GetUnsignedSetting(context, HTTP_MAX_HOST_REQUESTS_KEY,
+                                           DEFAULT_HTTP_MAX_HOST_REQUESTS)),
+      host_requests_per_second(0) {
+  Value value;
+  if (context.TryGetCurrentSetting(HTTP_HOST_RATE_KEY, value) &&
+      !value.IsNull()) {
+    host_requests_per_second = value.GetValue<double>();
+  }
+  if (host_requests_per_second < 0 || std::isnan(host_requests_per_second)) {
+    throw InvalidInputException("%s must not be negative",
+                                HTTP_HOST_RATE_KEY);
+  }
+}
+
+// ============================================================
+// Response Cache
+// ============================================================
+
+// Serializes metadata updates and eviction between scan threads
+static std::mutex CACHE_LOCK;
+// Bytes of bodies per cache directory, listed by the first Put of the
+// process and then kept up to date, so the directory is only listed again
+// once it outgrows its limit. Guarded by CACHE_LOCK.
+static std::unordered_map<string, idx_t> CACHE_SIZES;
+// A hit bumps the recency of an entry at most this often
+static constexpr int64_t CACHE_RECENCY_SECONDS = 60;
+
+static int64_t CurrentEpochSeconds() {
+  return Timestamp::GetEpochSeconds(Timestamp::GetCurrentTimestamp());
+}
+
+static void ReadWholeFile(FileHandle &handle, string &data) {
+  auto size = handle.GetFileSize();
+  data.resize(size);
+  handle.Read(const_cast<char *>(data.data()), size, 0);
+}
+
+static bool ReadWholeFile(FileSystem &fs, const string &path, string &data) {
+  auto handle = fs.OpenFile(path, FileFlags::FILE_FLAGS_READ |
+                                      FileFlags::FILE_FLAGS_NULL_IF_NOT_EXISTS);
+  if (!handle) {
+    return false;
+  }
+  ReadWholeFile(*handle, data);
+  return true;
+}
+
+static idx_t CachedFileSize(FileSystem &fs, const string &path) {
+  auto handle = fs.OpenFile(path, FileFlags::FILE_FLAGS_READ |
+                                      FileFlags::FILE_FLAGS_NULL_IF_NOT_EXISTS);
+  return handle ? handle->GetFileSize() : 0;
+}
+
+// "name=value" lines; values are HTTP header values and never contain '\n'
+static string SerializeCacheMeta(const string &key,
+                                 const WeatherCacheEntry &entry) {
+  string meta;
+  meta += "key=" + key + "\n";
+  meta += "stored=" + to_string(entry.stored) + "\n";
+  meta += "expires=" + to_string(entry.expires) + "\n";
+  meta += "etag=" + entry.etag + "\n";
+  meta += "last_modified=" + entry.last_modified + "\n";
+  return meta;
+}
+
+static bool ParseCacheMeta(const string &meta, const string &key,
+                           WeatherCacheEntry &entry) {
+  string stored_key;
+  for (auto &line : StringUtil::Split(meta, '\n')) {
+    auto eq = line.find('=');
+    if (eq == string::npos) {
+      continue;
+    }
+    auto name = line.substr(0, eq);
+    auto value = line.substr(eq + 1);
+    if (name == "key") {
+      stored_key = value;
+    } else if (name == "stored") {
+      entry.stored = std::strtoll(value.c_str(), nullptr, 10);
+    } else if (name == "expires") {
+      entry.expires = std::strtoll(value.c_str(), nullptr, 10);
+    } else if (name == "etag") {
+      entry.etag = value;
+    } else if (name == "last_modified") {
+      entry.last_modified = value;
+    }
+  }
+  // Guards against hash collisions
+  return stored_key == key;
+}
+
+WeatherCache::WeatherCache(ClientContext &context)
+    : fs(FileSystem::GetFileSystem(context)), max_size(0), ttl_seconds(0) {
+  Value value;
+  if (context.TryGetCurrentSetting(CACHE_DIRECTORY_KEY, value) &&
+      !value.IsNull()) {
+    directory = value.ToString();
+  }
+  if (directory.empty()) {
+    return;
+  }
+
+  string max_size_str = DEFAULT_CACHE_MAX_SIZE;
+  if (context.TryGetCurrentSetting(CACHE_MAX_SIZE_KEY, value) &&
+      !value.IsNull()) {
+    max_size_str = value.ToString();
+  }
+  max_size = DBConfig::ParseMemoryLimit(max_size_str);
+  if (context.TryGetCurrentSetting(CACHE_TTL_KEY, value) && !value.IsNull()) {
+    ttl_seconds = value.GetValue<int64_t>();
+  }
+
+  if (!fs.DirectoryExists(directory)) {
+    fs.CreateDirectory(directory);
+  }
+}
+
+string WeatherCache::EntryPath(const string &key,
+                               const char *extension) const {
+  static const char *HEX_DIGITS = "0123456789abcdef";
+  auto hash = Hash(key.c_str(), key.size());
+  string name(16, '0');
+  for (idx_t i = 0; i < 16; i++) {
+    name[15 - i] = HEX_DIGITS[hash & 0xf];
+    hash >>= 4;
+  }
+  return fs.JoinPath(directory, name + extension);
+}
+
+// Write through a temporary file so readers never see a partial entry
+void WeatherCache::WriteFile(const string &path, const string &data) {
+  auto thread_id = std::hash<std::thread::id>()(std::this_thread::get_id());
+  auto tmp_path = path + "." + to_string(thread_id) + ".tmp";
+  {
+    auto handle =
+        fs.OpenFile(tmp_path, FileFlags::FILE_FLAGS_WRITE |
+                                  FileFlags::FILE_FLAGS_FILE_CREATE_NEW);
+    handle->Write(const_cast<char *>(data.data()), data.size(), 0);
+    handle->Sync();
+  }
+  fs.MoveFile(tmp_path, path);
+}
+
+bool WeatherCache::GetEntry(const string &key, WeatherCacheEntry &entry) {
+  if (!Enabled()) {
+    return false;
+  }
+  // The cache is best effort, any I/O problem is a miss
+  try {
+    auto meta_path = EntryPath(key, ".meta");
+    {
+      std::lock_guard<std::mutex> guard(CACHE_LOCK);
+      auto handle =
+          fs.OpenFile(meta_path, FileFlags::FILE_FLAGS_READ |
+                                     FileFlags::FILE_FLAGS_NULL_IF_NOT_EXISTS);
+      if (!handle) {
+        return false;
+      }
+      string meta;
+      ReadWholeFile(*handle, meta);
+      if (!ParseCacheMeta(meta, key, entry)) {
+        return false;
+      }
+      // The modification time of the metadata is the recency used for LRU
+      // eviction. Writing the same bytes in place bumps it without a sync or
+      // a rename, and only once the last bump is a while ago.
+      auto accessed =
+          Timestamp::GetEpochSeconds(fs.GetLastModifiedTime(*handle));
+      handle.reset();
+      if (CurrentEpochSeconds() - accessed >= CACHE_RECENCY_SECONDS) {
+        auto touch = fs.OpenFile(meta_path, FileFlags::FILE_FLAGS_WRITE);
+        touch->Write(const_cast<char *>(meta.data()), meta.size(), 0);
+      }
+    }
+    return ReadWholeFile(fs, EntryPath(key, ".bin"), entry.body);
+  } catch (std::exception &) {
+    return false;
+  }
+}
+
+bool WeatherCache::Get(const string &key, string &body) {
+  WeatherCacheEntry entry;
+  if (!GetEntry(key, entry)) {
+    return false;
+  }
+  if (ttl_seconds > 0 && CurrentEpochSeconds() - entry.stored >= ttl_seconds) {
+    return false;
+  }
+  body = std::move(entry.body);
+  return true;
+}
+
+void WeatherCache::PutEntry(const string &key, const WeatherCacheEntry &entry) {
+  Write(key, entry, entry.body);
+}
+
+void WeatherCache::Put(const string &key, const string &body) {
+  WeatherCacheEntry meta;
+  meta.stored = CurrentEpochSeconds();
+  Write(key, meta, body);
+}
+
+// The body is written from the caller's buffer; meta.body is not read
+void WeatherCache::Write(const string &key, const WeatherCacheEntry &meta,
+                         const string &body) {
+  if (!Enabled() || body.size() > max_size) {
+    return;
+  }
+  try {
+    auto body_path = EntryPath(key, ".bin");
+    auto replaced_size = CachedFileSize(fs, body_path);
+    WriteFile(body_path, body);
+    std::lock_guard<std::mutex> guard(CACHE_LOCK);
+    WriteFile(EntryPath(key, ".meta"), SerializeCacheMeta(key, meta));
+    auto known = CACHE_SIZES.find(directory);
+    if (known == CACHE_SIZES.end()) {
+      Evict();
+      return;
+    }
+    auto &size = known->second;
+    size += body.size();
+    size -= MinValue(size, replaced_size);
+    if (size > max_size) {
+      Evict();
+    }
+  } catch (std::exception &) {
+    // A full or read-only cache directory must not fail the query
+  }
+}
+
+// Remove least recently used entries until the cache fits in max_size, and
+// record the size left. Called with CACHE_LOCK held.
+void WeatherCache::Evict() {
+  struct CachedFile {
+    string stem;
+    timestamp_t accessed;
+    idx_t size;
+  };
+  vector<CachedFile> files;
+  idx_t total_size = 0;
+  fs.ListFiles(directory, [&](const string &name, bool is_directory) {
+    if (is_directory || !StringUtil::EndsWith(name, ".bin")) {
+      return;
+    }
+    CachedFile file;
+    file.stem = fs.JoinPath(directory, name.substr(0, name.size() - 4));
+    auto body = fs.OpenFile(file.stem + ".bin", FileFlags::FILE_FLAGS_READ);
+    file.size = body->GetFileSize();
+    auto meta = fs.OpenFile(file.stem + ".meta",
+                            FileFlags::FILE_FLAGS_READ |
+                                FileFlags::FILE_FLAGS_NULL_IF_NOT_EXISTS);
+    // Bodies without metadata are leftovers and go first
+    file.accessed = meta ? fs.GetLastModifiedTime(*meta) : timestamp_t(0);
+    total_size += file.size;
+    files.push_back(std::move(file));
+  });
+  CACHE_SIZES[directory] = total_size;
+  if (total_size <= max_size) {
+    return;
+  }
+
+  std::sort(files.begin(), files.end(),
+            [](const CachedFile &a, const CachedFile &b) {
+              return a.accessed < b.accessed;
+            });
+  for (auto &file : files) {
+    if (total_size <= max_size) {
+      break;
+    }
+    fs.TryRemoveFile(file.stem + ".meta");
+    fs.TryRemoveFile(file.stem + ".bin");
+    total_size -= file.size;
+  }
+  CACHE_SIZES[directory] = total_size;
+}
+
+// ============================================================
+// Retrying Client
+// ============================================================
+
+// IMF-fixdate as used in HTTP headers, e.g. "Tue, 20 Jan 2026 12:00:00 GMT".
+// Returns epoch seconds, or 0 when the text cannot be parsed.
+static int64_t ParseHttpDate(const string &text) {
+  static const char *MONTHS[] = {"Jan", "Feb", "Mar", "Apr", "May", "Jun",
+                                 "Jul", "Aug", "Sep", "Oct", "Nov", "Dec"};
+  auto parts = StringUtil::Split(text, ' ');
+  if (parts.size() != 6 || parts[5] != "GMT") {
+    return 0;
+  }
+  auto month = std::find(MONTHS, MONTHS + 12, parts[2]) - MONTHS + 1;
+  auto clock = StringUtil::Split(parts[4], ':');
+  if (month > 12 || clock.size() != 3) {
+    return 0;
+  }
+  int32_t year = std::atoi(parts[3].c_str());
+  int32_t day = std::atoi(parts[1].c_str());
+  if (!Date::IsValid(year, static_cast<int32_t>(month), day)) {
+    return 0;
+  }
+  auto date = Date::FromDate(year, static_cast<int32_t>(month), day);
+  auto time = Time::FromTime(std::atoi(clock[0].c_str()),
+                             std::atoi(clock[1].c_str()),
+                             std::atoi(clock[2].c_str()), 0);
+  return Timestamp::GetEpochSeconds(Timestamp::FromDatetime(date, time));
+}
+
+static bool IsDigits(const string &text) {
+  return !text.empty() &&
+         std::all_of(text.begin(), text.end(), StringUtil::CharacterIsDigit);
+}
+
+// [begin, end) of a "bytes=begin-" or "bytes=begin-last" Range header
+static bool ParseByteRange(const string &range, idx_t &begin, idx_t &end) {
+  static const string PREFIX = "bytes=";
+  if (!StringUtil::StartsWith(range, PREFIX)) {
+    return false;
+  }
+  auto dash = range.find('-', PREFIX.size());
+  if (dash == string::npos) {
+    return false;
+  }
+  auto first = range.substr(PREFIX.size(), dash - PREFIX.size());
+  auto last = range.substr(dash + 1);
+  if (!IsDigits(first) || (!last.empty() && !IsDigits(last))) {
+    return false;
+  }
+  begin = std::strtoull(first.c_str(), nullptr, 10);
+  end = last.empty() ? 0 : std::strtoull(last.c_str(), nullptr, 10) + 1;
+  return true;
+}
+
+// end == 0 means to the end of the file
+static string FormatByteRange(idx_t begin, idx_t end) {
+  string range = "bytes=" + to_string(begin) + "-";
+  if (end > 0) {
+    range += to_string(end - 1);
+  }
+  return range;
+}
+
+// If-Range validator of an answer: a strong ETag, else Last-Modified. Empty
+// when there is neither, and the body cannot be resumed safely.
+static string RangeValidator(const HTTPResponse &response) {
+  if (response.headers.HasHeader("ETag")) {
+    auto etag = response.headers.GetHeaderValue("ETag");
+    if (!StringUtil::StartsWith(etag, "W/")) {
+      return etag;
+    }
+  }
+  if (response.headers.HasHeader("Last-Modified")) {
+    return response.headers.GetHeaderValue("Last-Modified");
+  }
+  return string();
+}
+
+// Answers worth another attempt: the server is overloaded or briefly broken
+static bool IsTransientStatus(HTTPStatusCode status) {
+  switch (static_cast<int32_t>(status)) {
+  case 408:
+  case 425:
+  case 429:
+  case 500:
+  case 502:
+  case 503:
+  case 504:
+    return true;
+  default:
+    return false;
+  }
+}
+
+// Delay asked for by a Retry-After header, in seconds or as an HTTP date
+static idx_t RetryAfterMs(const HTTPResponse *response) {
+  if (!response || !response->headers.HasHeader("Retry-After")) {
+    return 0;
+  }
+  auto value = response->headers.GetHeaderValue("Retry-After");
+  if (IsDigits(value)) {
+    return std::strtoull(value.c_str(), nullptr, 10) * 1000;
+  }
+  auto at = ParseHttpDate(value);
+  auto now = CurrentEpochSeconds();
+  return at > now ? static_cast<idx_t>(at - now) * 1000 : 0;
+}
+
+// Requests in flight to one host and the earliest start of the next one
+struct WeatherHostBudget {
+  std::mutex lock;
+  std::condition_variable slot_free;
+  idx_t active = 0;
+  std::chrono::steady_clock::time_point next_start;
+};
+
+// Budgets live for the process, so concurrent scans share them
+static WeatherHostBudget &GetHostBudget(const string &host) {
+  static std::mutex budgets_lock;
+  static std::unordered_map<string, unique_ptr<WeatherHostBudget>> budgets;
+  std::lock_guard<std::mutex> guard(budgets_lock);
+  auto &budget = budgets[host];
+  if (!budget) {
+    budget = make_uniq<WeatherHostBudget>();
+  }
+  return *budget;
+}
+
+// Holds one request slot of a host for its lifetime. Waits for a free slot,
+// then for the start time reserved under the rate limit.
+class WeatherHostSlot {
+public:
+  WeatherHostSlot(const string &host, const WeatherHttpSettings &settings)
+      : budget(GetHostBudget(host)) {
+    std::chrono::steady_clock::time_point start;
+    {
+      std::unique_lock<std::mutex> guard(budget.lock);
+      auto max_requests = settings.max_host_requests;
+      budget.slot_free.wait(guard, [&]() {
+        return max_requests == 0 || budget.active < max_requests;
+      });
+      budget.active++;
+      start = MaxValue(std::chrono::steady_clock::now(), budget.next_start);
+      if (settings.host_requests_per_second > 0) {
+        budget.next_start =
+            start +
+            std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                std::chrono::duration<double>(
+                    1.0 / settings.host_requests_per_second));
+      }
+    }
+    std::this_thread::sleep_until(start);
+  }
+
+  ~WeatherHostSlot() {
+    {
+      std::lock_guard<std::mutex> guard(budget.lock);
+      budget.active--;
+    }
+    budget.slot_free.notify_one();
+  }
+
+private:
+  WeatherHostBudget &budget;
+};
+
+// Sends the requests of one thread. The connection to the last host is kept
+// open for the next request, failed attempts are retried with jittered
+// exponential backoff and every attempt takes a slot of its host's budget.
+// HTTPUtil's own retries are switched off, they would multiply ours.
+class WeatherHttpClient {
+public:
+  // HTTP parameters are prepared by the caller on the query thread, so a
+  // client built from settings can run on a fetch pool worker
+  WeatherHttpClient(HTTPUtil &http_util_p,
+                    const WeatherHttpSettings &settings_p,
+                    WeatherScanMetrics *metrics_p)
+      : http_util(http_util_p), settings(settings_p), metrics(metrics_p) {}
+  WeatherHttpClient(ClientContext &context, WeatherScanMetrics *metrics_p)
+      : WeatherHttpClient(HTTPUtil::Get(*context.db),
+                          WeatherHttpSettings(context), metrics_p) {}
+
+  WeatherScanMetrics *Metrics() const { return metrics; }
+
+  // GET url. A body cut off mid-transfer is resumed with a Range request for
+  // the missing bytes, made conditional with If-Range on the ETag or
+  // Last-Modified of the first answer; a server answering that with the
+  // whole file starts the body over, as does a first answer without either
+  // validator. Returns the last answer once transient statuses use up
+  // the retries; throws IOException when no answer arrived at all, or once
+  // abort is set.
+  unique_ptr<HTTPResponse> Get(HTTPParams &params, const string &url,
+                               const HTTPHeaders &headers,
+                               const std::atomic<bool> *abort = nullptr);
+
+  // HEAD url, retried like Get
+  unique_ptr<HTTPResponse> Head(HTTPParams &params, const string &url);
+
+private:
+  unique_ptr<HTTPResponse> Send(BaseRequest &request);
+  // Wait before retry attempt + 1; false when aborted meanwhile
+  bool Backoff(idx_t attempt, const HTTPResponse *response,
+               const std::atomic<bool> *abort);
+
+  HTTPUtil &http_util;
+  WeatherHttpSettings settings;
+  WeatherScanMetrics *metrics;
+  unique_ptr<HTTPClient> connection;
+  string connection_host;
+  RandomEngine random;
+};
+
+unique_ptr<HTTPResponse> WeatherHttpClient::Send(BaseRequest &request) {
+  if (request.proto_host_port != connection_host) {
+    connection.reset();
+    connection_host = request.proto_host_port;
+  }
+  WeatherHostSlot slot(connection_host, settings);
+  WeatherScanTimer timer(metrics ? &metrics->http_nanos : nullptr);
+  if (metrics) {
+    metrics->http_requests++;
+  }
+  unique_ptr<HTTPResponse> response;
+  try {
+    response = http_util.Request(request, connection);
+  } catch (...) {
+    connection.reset();
+    throw;
+  }
+  if (!response || response->HasRequestError()) {
+    // A connection that failed mid-request is not reused
+    connection.reset();
+  }
+  return response;
+}
+
+bool WeatherHttpClient::Backoff(idx_t attempt, const HTTPResponse *response,
+                                const std::atomic<bool> *abort) {
+  if (metrics) {
+    metrics->http_retries++;
+  }
+  auto max_wait = static_cast<double>(settings.retry_max_wait_ms);
+  auto ceiling =
+      MinValue(max_wait, static_cast<double>(settings.retry_wait_ms) *
+                             std::pow(2.0, static_cast<double>(attempt)));
+  auto wait_ms = ceiling * (0.5 + 0.5 * random.NextRandom());
+  wait_ms = MaxValue(
+      wait_ms, MinValue(static_cast<double>(RetryAfterMs(response)), max_wait));
+
+  auto until = std::chrono::steady_clock::now() +
+               std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                   std::chrono::duration<double, std::milli>(wait_ms));
+  // Sleep in slices so that a cancelled download stops waiting
+  static const auto SLICE = std::chrono::milliseconds(50);
+  while (!(abort && abort->load())) {
+    auto now = std::chrono::steady_clock::now();
+    if (now >= until) {
+      return true;
+    }
+    std::this_thread::sleep_for(MinValue<std::chrono::steady_clock::duration>(
+        until - now, SLICE));
+  }
+  return false;
+}
+
+unique_ptr<HTTPResponse>
+WeatherHttpClient::Get(HTTPParams &params, const string &url,
+                       const HTTPHeaders &headers,
+                       const std::atomic<bool> *abort) {
+  params.retries = 0;
+  // Bytes [range_begin, range_end) were asked for; resuming needs to know
+  idx_t range_begin = 0;
+  idx_t range_end = 0;
+  bool resumable =
+      !headers.HasHeader("Range") ||
+      ParseByteRange(headers.GetHeaderValue("Range"), range_begin, range_end);
+
+  // Received so far: bytes [body_begin, body_end) of the file, where
+  // body_end == 0 means to the end. A 200 answer makes it the whole file.
+  // validator identifies the version they belong to.
+  string body;
+  idx_t body_begin = range_begin;
+  idx_t body_end = range_end;
+  string validator;
+  string error;
+  for (idx_t attempt = 0;; attempt++) {
+    bool resuming = !body.empty();
+    if (resuming && body_end > 0 && body_begin + body.size() >= body_end) {
+      // Cut off after the last byte: nothing is missing
+      auto response =
+          make_uniq<HTTPResponse>(HTTPStatusCode::PartialContent_206);
+      response->body = std::move(body);
+      return response;
+    }
+    HTTPHeaders request_headers = headers;
+    if (resuming) {
+      // A changed resource is answered with 200 and sent whole
+      request_headers["Range"] =
+          FormatByteRange(body_begin + body.size(), body_end);
+      request_headers["If-Range"] = validator;
+    }
+
+    bool keep_body = false;
+    string error_body;
+    GetRequestInfo get_request(
+        url, request_headers, params,
+        [&](const HTTPResponse &response) {
+          keep_body = response.status == HTTPStatusCode::OK_200 ||
+                      response.status == HTTPStatusCode::PartialContent_206;
+          if (response.status == HTTPStatusCode::OK_200) {
+            // Range not honoured or the resource changed: the whole file
+            // follows
+            body.clear();
+            body_begin = 0;
+            body_end = 0;
+          }
+          if (keep_body && body.empty()) {
+            validator = RangeValidator(response);
+          }
+          return true;
+        },
+        [&](const_data_ptr_t data, idx_t length) {
+          // Stop receiving a large file as soon as the scan is cancelled
+          if (abort && abort->load()) {
+            return false;
+          }
+          if (metrics) {
+            metrics->bytes_downloaded += length;
+          }
+          (keep_body ? body : error_body)
+              .append(const_char_ptr_cast(data), length);
+          return true;
+        });
+
+    unique_ptr<HTTPResponse> response;
+    try {
+      response = Send(get_request);
+    } catch (const std::exception &e) {
+      error = e.what();
+    }
+    if (abort && abort->load()) {
+      throw IOException("Download cancelled: " + url);
+    }
+    bool interrupted = !response || response->HasRequestError();
+    if (!interrupted && !IsTransientStatus(response->status)) {
+      if (keep_body) {
+        response->status = body_begin == 0 && body_end == 0
+                               ? HTTPStatusCode::OK_200
+                               : HTTPStatusCode::PartialContent_206;
+        response->body = std::move(body);
+      } else {
+        response->body = std::move(error_body);
+      }
+      return response;
+    }
+    if (response && interrupted) {
+      error = response->GetRequestError();
+    }
+    if (attempt >= settings.retries) {
+      if (!interrupted) {
+        response->body = std::move(error_body);
+        return response;
+      }
+      throw IOException("HTTP GET failed after %d attempts for URL %s: %s",
+                        attempt + 1, url, error);
+    }
+    // Without a validator the bytes received could belong to another
+    // version of the resource, so the download starts over
+    if (!resumable || validator.empty()) {
+      body.clear();
+    }
+    if (!Backoff(attempt, interrupted ? nullptr : response.get(), abort)) {
+      throw IOException("Download cancelled: " + url);
+    }
+  }
+}
+
+unique_ptr<HTTPResponse> WeatherHttpClient::Head(HTTPParams &params,
+                                                 const string &url) {
+  params.retries = 0;
+  HTTPHeaders headers;
+  string error;
+  for (idx_t attempt = 0;; attempt++) {
+    HeadRequestInfo head_request(url, headers, params);
+    unique_ptr<HTTPResponse> response;
+    try {
+      response = Send(head_request);
+    } catch (const std::exception &e) {
+      error = e.what();
+    }
+    bool failed = !response || response->HasRequestError();
+    if (!failed && (!IsTransientStatus(response->status) ||
+                    attempt >= settings.retries)) {
+      return response;
+    }
+    if (response && failed) {
+      error = response->GetRequestError();
+    }
+    if (attempt >= settings.retries) {
+      throw IOException("HTTP HEAD failed after %d attempts for URL %s: %s",
+                        attempt + 1, url, error);
+    }
+    Backoff(attempt, failed ? nullptr : response.get(), nullptr);
+  }
+}
+
+// ============================================================
+// Single Requests
+// ============================================================
+
+static void CountCacheHit(WeatherScanMetrics *metrics) {
+  if (metrics) {
+    metrics->cache_hits++;
+  }
+}
+
+static void ThrowHttpError(int32_t status, const string &url) {
+  throw IOException("HTTP request failed with status " + to_string(status) +
+                    " for URL: " + url);
+}
+
+// GET of an immutable resource through the cache. On failure returns false
+// and the HTTP status.
+static bool CachedGet(WeatherHttpClient &client, HTTPParams &params,
+                      WeatherCache &cache, const string &url,
+                      const HTTPHeaders &headers, string &body,
+                      int32_t &status,
+                      const std::atomic<bool> *abort = nullptr) {
+  if (cache.Get(url, body)) {
+    CountCacheHit(client.Metrics());
+    return true;
+  }
+  auto response = client.Get(params, url, headers, abort);
+  status = static_cast<int32_t>(response->status);
+  if (!response->Success()) {
+    return false;
+  }
+  body = std::move(response->body);
+  cache.Put(url, body);
+  return true;
+}
+
+static bool CachedGet(ClientContext &context, const string &url, string &body,
+                      int32_t &status, WeatherScanMetrics *metrics) {
+  auto params = HTTPUtil::Get(*context.db).InitializeParameters(context, url);
+  WeatherHttpClient client(context, metrics);
+  WeatherCache cache(context);
+  return CachedGet(client, *params, cache, url, HTTPHeaders(), body, status);
+}
+
+string WeatherHttpGet(ClientContext &context, const string &url,
+                      WeatherScanMetrics *metrics) {
+  string body;
+  int32_t status = 0;
+  if (!CachedGet(context, url, body, status, metrics)) {
+    ThrowHttpError(status, url);
+  }
+  return body;
+}
+
+bool WeatherHttpTryGet(ClientContext &context, const string &url,
+                       string &body, WeatherScanMetrics *metrics) {
+  int32_t status = 0;
+  return CachedGet(context, url, body, status, metrics);
+}
+
+void WeatherHttpGetRanges(ClientContext &context, const string &url,
+                          const vector<std::pair<idx_t, idx_t>> &ranges,
+                          string &body, WeatherScanMetrics *metrics) {
+  WeatherCache cache(context);
+  // Created on the first range not in the cache, then reused
+  unique_ptr<HTTPParams> params;
+  unique_ptr<WeatherHttpClient> client;
+  // Set once the server ignored a Range header and sent the whole file
+  string full;
+  bool have_full = false;
+
+  for (auto &byte_range : ranges) {
+    auto begin = byte_range.first;
+    auto end = byte_range.second;
+    auto range = FormatByteRange(begin, end);
+    auto cache_key = url + "#" + range;
+    string part;
+    if (cache.Get(cache_key, part)) {
+      CountCacheHit(metrics);
+      body += part;
+      continue;
+    }
+
+    if (!have_full) {
+      if (!client) {
+        params = HTTPUtil::Get(*context.db).InitializeParameters(context, url);
+        client = make_uniq<WeatherHttpClient>(context, metrics);
+      }
+      HTTPHeaders headers;
+      headers.Insert("Range", range);
+      auto response = client->Get(*params, url, headers);
+      if (response->status == HTTPStatusCode::PartialContent_206) {
+        part = std::move(response->body);
+      } else if (response->status == HTTPStatusCode::OK_200) {
+        // Range not supported: the whole file was sent, and serves the
+        // remaining ranges too
+        full = std::move(response->body);
+        have_full = true;
+      } else {
+        throw IOException("HTTP range request failed with status " +
+                          to_string(static_cast<int32_t>(response->status)) +
+                          " for URL: " + url);
+      }
+    }
+    if (have_full && begin < full.size()) {
+      part = full.substr(begin, end > 0 ? end - begin : string::npos);
+    }
+    cache.Put(cache_key, part);
+    body += part;
+  }
+}
+
+static void ReadValidators(const HTTPResponse &response,
+                           WeatherCacheEntry &entry) {
+  if (response.headers.HasHeader("Expires")) {
+    entry.expires = ParseHttpDate(response.headers.GetHeaderValue("Expires"));
+  }
+  if (response.headers.HasHeader("ETag")) {
+    entry.etag = response.headers.GetHeaderValue("ETag");
+  }
+  if (response.headers.HasHeader("Last-Modified")) {
+    entry.last_modified = response.headers.GetHeaderValue("Last-Modified");
+  }
+}
+
+static string RevalidatedGet(WeatherHttpClient &client, HTTPParams &params,
+                             WeatherCache &cache, const string &url,
+                             const HTTPHeaders &headers,
+                             const std::atomic<bool> *abort = nullptr) {
+  WeatherCacheEntry cached;
+  bool has_cached = cache.GetEntry(url, cached);
+  auto now = CurrentEpochSeconds();
+  if (has_cached && cached.expires > now) {
+    CountCacheHit(client.Metrics());
+    return std::move(cached.body);
+  }
+
+  HTTPHeaders request_headers = headers;
+  if (has_cached) {
+    if (!cached.etag.empty()) {
+      request_headers.Insert("If-None-Match", cached.etag);
+    }
+    if (!cached.last_modified.empty()) {
+      request_headers.Insert("If-Modified-Since", cached.last_modified);
+    }
+  }
+  auto response = client.Get(params, url, request_headers, abort);
+
+  if (has_cached && response->status == HTTPStatusCode::NotModified_304) {
+    CountCacheHit(client.Metrics());
+    cached.stored = now;
+    cached.expires = 0;
+    ReadValidators(*response, cached);
+    cache.PutEntry(url, cached);
+    return std::move(cached.body);
+  }
+  if (!response->Success()) {
+    ThrowHttpError(static_cast<int32_t>(response->status), url);
+  }
+
+  WeatherCacheEntry entry;
+  entry.body = std::move(response->body);
+  entry.stored = now;
+  ReadValidators(*response, entry);
+  cache.PutEntry(url, entry);
+  return std::move(entry.body);
+}
+
+string WeatherHttpGetRevalidated(ClientContext &context, const string &url,
+                                 const HTTPHeaders &headers,
+                                 WeatherScanMetrics *metrics) {
+  auto params = HTTPUtil::Get(*context.db).InitializeParameters(context, url);
+  WeatherHttpClient client(context, metrics);
+  WeatherCache cache(context);
+  return RevalidatedGet(client, *params, cache, url, headers);
+}
+
+// ============================================================
+// Availability Probes
+// ============================================================
+
+vector<bool> WeatherHttpProbe(ClientContext &context,
+                              const vector<string> &urls,
+                              idx_t max_concurrency,
+                              WeatherScanMetrics *metrics) {
+  auto &http_util = HTTPUtil::Get(*context.db);
+  WeatherHttpSettings settings(context);
+  vector<unique_ptr<HTTPParams>> params;
+  for (auto &url : urls) {
+    params.push_back(http_util.InitializeParameters(context, url));
+  }
+
+  // vector<bool> packs bits, so workers write bytes and the result is copied
+  vector<uint8_t> found(urls.size(), 0);
+  std::atomic<idx_t> next_url{0};
+  auto worker = [&]() {
+    WeatherHttpClient client(http_util, settings, metrics);
+    for (idx_t i = next_url++; i < urls.size(); i = next_url++) {
+      try {
+        found[i] = client.Head(*params[i], urls[i])->Success();
+      } catch (const std::exception &) {
+        found[i] = false;
+      }
+    }
+  };
+  vector<std::thread> workers;
+  idx_t worker_count =
+      MinValue<idx_t>(MaxValue<idx_t>(max_concurrency, 1), urls.size());
+  for (idx_t i = 0; i < worker_count; i++) {
+    workers.emplace_back(worker);
+  }
+  for (auto &thread : workers) {
+    thread.join();
+  }
+  return vector<bool>(found.begin(), found.end());
+}
+
+// ============================================================
+// Fetch Pool
+// ============================================================
+
+WeatherFetchPool::WeatherFetchPool(ClientContext &context,
+                                   vector<string> urls_p,
+                                   idx_t max_concurrency_p,
+                                   HTTPHeaders headers_p,
+                                   WeatherCachePolicy policy_p,
+                                   shared_ptr<WeatherScanMetrics> metrics_p)
+    : http_util(HTTPUtil::Get(*context.db)), cache(context),
+      urls(std::move(urls_p)), headers(std::move(headers_p)),
+      policy(policy_p), http_settings(context), metrics(std::move(metrics_p)),
+      max_concurrency(MaxValue<idx_t>(max_concurrency_p, 1)) {
+  for (auto &url : urls) {
+    params.push_back(http_util.InitializeParameters(context, url));
+  }
+  idx_t worker_count = MinValue<idx_t>(max_concurrency, urls.size());
+  for (idx_t i = 0; i < worker_count; i++) {
+    workers.emplace_back([this]() { Worker(); });
+  }
+}
+
+WeatherFetchPool::~WeatherFetchPool() {
+  Cancel();
+  for (auto &worker : workers) {
+    worker.join();
+  }
+}
+
+void WeatherFetchPool::Cancel() {
+  {
+    std::lock_guard<std::mutex> guard(lock);
+    cancelled = true;
+    if (metrics) {
+      for (auto &result : results) {
+        metrics->ReleaseBuffered(result.body.size());
+      }
+    }
+    results.clear();
+  }
+  aborted = true;
+  slot_free.notify_all();
+  result_ready.notify_all();
+}
+
+bool WeatherFetchPool::Next(WeatherFetchResult &result) {
+  std::unique_lock<std::mutex> guard(lock);
+  result_ready.wait(guard, [this]() {
+    return cancelled || !results.empty() || handed_out == urls.size();
+  });
+  if (cancelled || results.empty()) {
+    return false;
+  }
+  result = std::move(results.front());
+  results.pop_front();
+  handed_out++;
+  guard.unlock();
+  slot_free.notify_one();
+  return true;
+}
+
+bool WeatherFetchPool::NextInOrder(WeatherFetchResult &result) {
+  std::unique_lock<std::mutex> guard(lock);
+  if (cancelled || next_claimed >= urls.size()) {
+    return false;
+  }
+  // Workers start URLs in list order, so every download finished before
+  // this one has been claimed and the budget cannot fill up without it
+  idx_t url_idx = next_claimed++;
+  auto found = results.end();
+  result_ready.wait(guard, [&]() {
+    found = std::find_if(results.begin(), results.end(),
+                         [&](const WeatherFetchResult &candidate) {
+                           return candidate.url_idx == url_idx;
+                         });
+    return cancelled || found != results.end();
+  });
+  if (cancelled) {
+    return false;
+  }
+  result = std::move(*found);
+  results.erase(found);
+  handed_out++;
+  guard.unlock();
+  slot_free.notify_one();
+  return true;
+}
+
+void WeatherFetchPool::Worker() {
+  WeatherHttpClient client(http_util, http_settings, metrics.get());
+  while (true) {
+    idx_t url_idx;
+    {
+      std::unique_lock<std::mutex> guard(lock);
+      // Downloaded but unconsumed bodies count against the budget too
+      slot_free.wait(guard, [this]() {
+        return cancelled || in_flight + results.size() < max_concurrency;
+      });
+      if (cancelled || next_url >= urls.size()) {
+        return;
+      }
+      url_idx = next_url++;
+      in_flight++;
+    }
+
+    WeatherFetchResult result;
+    result.url_idx = url_idx;
+    auto &url = urls[url_idx];
+    try {
+      if (policy == WeatherCachePolicy::REVALIDATE) {
+        result.body = RevalidatedGet(client, *params[url_idx], cache, url,
+                                     headers, &aborted);
+      } else {
+        int32_t status = 0;
+        if (!CachedGet(client, *params[url_idx], cache, url, headers,
+                       result.body, status, &aborted)) {
+          result.error = StringUtil::Format("HTTP status %d for URL: %s",
+                                            status, url);
+        }
+      }
+    } catch (const std::exception &e) {
+      result.error = e.what();
+    }
+    Finish(std::move(result));
+  }
+}
+
+void WeatherFetchPool::Finish(WeatherFetchResult result) {
+  {
+    std::lock_guard<std::mutex> guard(lock);
+    in_flight--;
+    if (!cancelled) {
+      if (metrics) {
+        metrics->AddBuffered(result.body.size());
+      }
+      results.push_back(std::move(result));
+    }
+  }
+  completed++;
+  // Consumers in NextInOrder each wait for a URL of their own
+  result_ready.notify_all();
+}
+
+} // namespace duckdb
@@ -0,0 +1,60 @@
+#include "weather_limit.hpp"
+#include "duckdb/planner/operator/logical_get.hpp"
+#include "duckdb/planner/operator/logical_limit.hpp"
+
+namespace duckdb {
+
+static const char *const LIMIT_PUSHDOWN_FUNCTIONS[] = {
+    "noaa_gfs_forecast_api", "read_grib", "met_forecast"};
+
+static bool SupportsLimitPushdown(const LogicalGet &get) {
+  for (auto name : LIMIT_PUSHDOWN_FUNCTIONS) {
+    if (get.function.name == name) {
+      return true;
+    }
+  }
+  return false;
+}
+
+// LIMIT plus OFFSET when both are constants; false for percentages and
+// expressions
+static bool TryGetRowLimit(const LogicalLimit &limit, idx_t &rows) {
+  if (limit.limit_val.Type() != LimitNodeType::CONSTANT_VALUE) {
+    return false;
+  }
+  rows = limit.limit_val.GetConstantValue();
+  switch (limit.offset_val.Type()) {
+  case LimitNodeType::UNSET:
+    return true;
+  case LimitNodeType::CONSTANT_VALUE:
+    rows += limit.offset_val.GetConstantValue();
+    return true;
+  default:
+    return false;
+  }
+}
+
+void OptimizeWeatherLimitPushdown(unique_ptr<LogicalOperator> &op) {
+  idx_t rows;
+  if (op->type == LogicalOperatorType::LOGICAL_LIMIT &&
+      TryGetRowLimit(op->Cast<LogicalLimit>(), rows) && rows > 0) {
+    // Projections map rows one to one; anything else (filters, joins,
+    // aggregates) may need more scan rows than the limit
+    reference<LogicalOperator> child = *op->children[0];
+    while (child.get().type == LogicalOperatorType::LOGICAL_PROJECTION) {
+      child = *child.get().children[0];
+    }
+    if (child.get().type == LogicalOperatorType::LOGICAL_GET) {
+      auto &get = child.get().Cast<LogicalGet>();
+      if (SupportsLimitPushdown(get) && get.table_filters.filters.empty()) {
+        get.bind_data->Cast<WeatherLimitBindData>().max_rows = rows;
+      }
+    }
+  }
+
+  for (auto &child : op->children) {
+    OptimizeWeatherLimitPushdown(child);
+  }
+}
+
+} // namespace duckdb
@@ -0,0 +1,172 @@
+#include "weather_metrics.hpp"
+#include "duckdb/common/string_util.hpp"
+#include "duckdb/main/client_context.hpp"
+#include "duckdb/main/client_context_state.hpp"
+#include <mutex>
+
+namespace duckdb {
+
+// ============================================================
+// Scan Metrics
+// ============================================================
+
+void WeatherScanMetrics::AddBuffered(idx_t bytes) {
+  idx_t buffered = buffered_bytes += bytes;
+  idx_t peak = peak_buffered_bytes.load();
+  while (buffered > peak &&
+         !peak_buffered_bytes.compare_exchange_weak(peak, buffered)) {
+  }
+}
+
+void WeatherScanMetrics::ReleaseBuffered(idx_t bytes) {
+  buffered_bytes -= bytes;
+}
+
+static string FormatSeconds(idx_t nanos) {
+  return StringUtil::Format("%.3fs", static_cast<double>(nanos) / 1e9);
+}
+
+InsertionOrderPreservingMap<string> WeatherScanMetrics::ToProfilerInfo() const {
+  InsertionOrderPreservingMap<string> info;
+  idx_t requests = http_requests.load();
+  if (requests > 0 || cache_hits.load() > 0) {
+    info["HTTP Requests"] = to_string(requests);
+    info["HTTP Retries"] = to_string(http_retries.load());
+    info["HTTP Time"] = FormatSeconds(http_nanos.load());
+    info["Bytes Downloaded"] =
+        StringUtil::BytesToHumanReadableString(bytes_downloaded.load());
+    info["Cache Hits"] = to_string(cache_hits.load());
+    info["Peak Buffered"] =
+        StringUtil::BytesToHumanReadableString(peak_buffered_bytes.load());
+  }
+  if (messages_decoded.load() > 0 || messages_skipped.load() > 0) {
+    info["Messages Decoded"] = to_string(messages_decoded.load());
+    info["Messages Skipped"] = to_string(messages_skipped.load());
+  }
+  idx_t points = points_decoded.load();
+  if (points > 0) {
+    info["Decode Time"] = FormatSeconds(decode_nanos.load());
+    info["Decode ns/Point"] = StringUtil::Format(
+        "%.1f", static_cast<double>(decode_nanos.load()) / points);
+  }
+  return info;
+}
+
+// ============================================================
+// Per-connection History
+// ============================================================
+
+static constexpr const char *SCAN_STATS_STATE_KEY = "weather_scan_stats";
+
+// Metrics of the scans of the most recent query that ran one
+class WeatherScanStatsState : public ClientContextState {
+public:
+  void QueryBegin(ClientContext &context) override {
+    std::lock_guard<std::mutex> guard(lock);
+    new_query = true;
+  }
+
+  void Add(shared_ptr<WeatherScanMetrics> metrics) {
+    std::lock_guard<std::mutex> guard(lock);
+    if (new_query) {
+      scans.clear();
+      new_query = false;
+    }
+    scans.push_back(std::move(metrics));
+  }
+
+  vector<shared_ptr<WeatherScanMetrics>> Scans() {
+    std::lock_guard<std::mutex> guard(lock);
+    return scans;
+  }
+
+private:
+  std::mutex lock;
+  bool new_query = false;
+  vector<shared_ptr<WeatherScanMetrics>> scans;
+};
+
+shared_ptr<WeatherScanMetrics>
+RegisterWeatherScan(ClientContext &context, const string &function_name) {
+  auto metrics = make_shared_ptr<WeatherScanMetrics>(function_name);
+  context.registered_state
+      ->GetOrCreate<WeatherScanStatsState>(SCAN_STATS_STATE_KEY)
+      ->Add(metrics);
+  return metrics;
+}
+
+// ============================================================
+// weather_scan_stats()
+// ============================================================
+
+struct WeatherScanStatsGlobalState : public GlobalTableFunctionState {
+  vector<shared_ptr<WeatherScanMetrics>> scans;
+  idx_t offset = 0;
+};
+
+static unique_ptr<FunctionData>
+WeatherScanStatsBind(ClientContext &context, TableFunctionBindInput &input,
+                     vector<LogicalType> &return_types, vector<string> &names) {
+  names = {"function_name",     "http_requests",    "http_retries",
+           "http_seconds",      "bytes_downloaded", "cache_hits",
+           "messages_decoded",  "messages_skipped", "points_decoded",
+           "decode_seconds",    "decode_ns_per_point",
+           "peak_buffered_bytes"};
+  return_types = {LogicalType::VARCHAR, LogicalType::UBIGINT,
+                  LogicalType::UBIGINT, LogicalType::DOUBLE,
+                  LogicalType::UBIGINT, LogicalType::UBIGINT,
+                  LogicalType::UBIGINT, LogicalType::UBIGINT,
+                  LogicalType::UBIGINT, LogicalType::DOUBLE,
+                  LogicalType::DOUBLE,  LogicalType::UBIGINT};
+  return make_uniq<TableFunctionData>();
+}
+
+static unique_ptr<GlobalTableFunctionState>
+WeatherScanStatsInitGlobal(ClientContext &context,
+                           TableFunctionInitInput &input) {
+  auto state = make_uniq<WeatherScanStatsGlobalState>();
+  state->scans = context.registered_state
+                     ->GetOrCreate<WeatherScanStatsState>(SCAN_STATS_STATE_KEY)
+                     ->Scans();
+  return std::move(state);
+}
+
+static void WeatherScanStatsScan(ClientContext &context,
+                                 TableFunctionInput &data, DataChunk &output) {
+  auto &state = data.global_state->Cast<WeatherScanStatsGlobalState>();
+  idx_t count = 0;
+  while (count < STANDARD_VECTOR_SIZE && state.offset < state.scans.size()) {
+    auto &metrics = *state.scans[state.offset++];
+    idx_t points = metrics.points_decoded.load();
+    double decode_seconds = static_cast<double>(metrics.decode_nanos) / 1e9;
+    output.SetValue(0, count, Value(metrics.function_name));
+    output.SetValue(1, count, Value::UBIGINT(metrics.http_requests));
+    output.SetValue(2, count, Value::UBIGINT(metrics.http_retries));
+    output.SetValue(
+        3, count,
+        Value::DOUBLE(static_cast<double>(metrics.http_nanos) / 1e9));
+    output.SetValue(4, count, Value::UBIGINT(metrics.bytes_downloaded));
+    output.SetValue(5, count, Value::UBIGINT(metrics.cache_hits));
+    output.SetValue(6, count, Value::UBIGINT(metrics.messages_decoded));
+    output.SetValue(7, count, Value::UBIGINT(metrics.messages_skipped));
+    output.SetValue(8, count, Value::UBIGINT(points));
+    output.SetValue(9, count, Value::DOUBLE(decode_seconds));
+    output.SetValue(10, count,
+                    points == 0
+                        ? Value(LogicalType::DOUBLE)
+                        : Value::DOUBLE(
+                              static_cast<double>(metrics.decode_nanos) /
+                              static_cast<double>(points)));
+    output.SetValue(11, count, Value::UBIGINT(metrics.peak_buffered_bytes));
+    count++;
+  }
+  output.SetCardinality(count);
+}
+
+void RegisterWeatherScanStatsFunction(ExtensionLoader &loader) {
+  TableFunction func("weather_scan_stats", {}, WeatherScanStatsScan,
+                     WeatherScanStatsBind, WeatherScanStatsInitGlobal);
+  loader.RegisterFunction(func);
+}
+
+} // namespace duckdb